@@ -0,0 +1,148 @@
+//
+//  BindingInstrumentationTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import DJISDK
+import UXSDKCore
+import UXSDKCoreBenchmarks
+
+class InstrumentedBindingModel: NSObject {
+
+    @objc dynamic var level: NSNumber?
+    var updateCount = 0
+
+    @objc func update() {
+        updateCount += 1
+    }
+}
+
+class BindingInstrumentationTests: XCTestCase {
+
+    let levelKey = DJIBatteryKey(index: 0, andParam: DJIBatteryParamChargeRemainingInPercent)!
+    let instrumentation = DUXBetaBindingInstrumentation.sharedInstance()
+
+    var handler: DUXBetaInMemoryKeyHandler!
+    var previousHandler: DUXBetaKeyInterfaces?
+
+    override func setUp() {
+        super.setUp()
+        let adapter = DUXBetaKeyInterfaceAdapter.sharedInstance()
+        previousHandler = adapter.getHandler()
+        handler = DUXBetaInMemoryKeyHandler()
+        handler.updateValue(NSNumber(value: 0), for: levelKey)
+        adapter.setHandler(handler)
+        instrumentation.reset()
+    }
+
+    override func tearDown() {
+        instrumentation.isEnabled = false
+        instrumentation.reset()
+        DUXBetaKeyInterfaceAdapter.sharedInstance().setHandler(previousHandler)
+        super.tearDown()
+    }
+
+    /**
+     *  Every hop of one bound property is recorded under the property name and the model class, from the key
+     *  update to the RKVO selector.
+     */
+    func testEveryHopJoinsOnThePropertyName() {
+        instrumentation.isEnabled = true
+        let model = InstrumentedBindingModel()
+        model.duxbeta_bindSDKKey(levelKey, propertyName: "level")
+        model.duxbeta_bindRKVO(withTarget: model, selector: #selector(InstrumentedBindingModel.update), property: "level")
+        for i in 1...10 {
+            handler.updateValue(NSNumber(value: i), for: levelKey)
+        }
+
+        let className = NSStringFromClass(InstrumentedBindingModel.self)
+        let metrics = instrumentation.snapshot().filter { $0.modelClass == className }
+        let hops = Set(metrics.map { $0.hop.rawValue })
+        let expectedHops: [DUXBetaBindingHop] = [.adapterDispatch, .keyToProperty, .keyToObserver, .keyToCallback, .callback, .fanOut]
+        XCTAssertEqual(hops, Set(expectedHops.map { $0.rawValue }))
+        for metric in metrics {
+            XCTAssertEqual(metric.key, "level")
+        }
+
+        let keyToProperty = metrics.first { $0.hop == .keyToProperty }
+        XCTAssertEqual(keyToProperty?.count, 11)
+        let keyToCallback = metrics.first { $0.hop == .keyToCallback }
+        XCTAssertEqual(keyToCallback?.count, 10)
+        let fanOut = metrics.first { $0.hop == .fanOut }
+        XCTAssertEqual(fanOut?.maximum, 1)
+
+        XCTAssertNotNil(instrumentation.jsonSnapshot())
+        model.duxbeta_unBindRKVO()
+        model.duxbeta_unBindSDK()
+    }
+
+    func testNothingIsRecordedWhileDisabled() {
+        let model = InstrumentedBindingModel()
+        model.duxbeta_bindSDKKey(levelKey, propertyName: "level")
+        model.duxbeta_bindRKVO(withTarget: model, selector: #selector(InstrumentedBindingModel.update), property: "level")
+        for i in 1...10 {
+            handler.updateValue(NSNumber(value: i), for: levelKey)
+        }
+
+        XCTAssertEqual(model.updateCount, 11)
+        XCTAssertTrue(instrumentation.snapshot().isEmpty)
+        model.duxbeta_unBindRKVO()
+        model.duxbeta_unBindSDK()
+    }
+
+    /**
+     *  Recording into an existing metric must not allocate, the heap holds the same number of blocks after a
+     *  million records.
+     */
+    func testRecordingKeepsNoAllocations() {
+        let key = "level"
+        let modelClass: AnyClass = InstrumentedBindingModel.self
+        instrumentation.recordHop(.callback, key: key, modelClass: modelClass, value: 1)
+
+        let blocksBefore = heapBlocksInUse()
+        for i in 0..<1_000_000 {
+            instrumentation.recordHop(.callback, key: key, modelClass: modelClass, value: UInt64(i & 0xffff))
+        }
+        let blocksAfter = heapBlocksInUse()
+
+        XCTAssertEqual(instrumentation.snapshot().first?.count, 1_000_001)
+        XCTAssertLessThan(blocksAfter > blocksBefore ? blocksAfter - blocksBefore : 0, 100)
+    }
+
+    func testRecordPerformance() {
+        let key = "level"
+        let modelClass: AnyClass = InstrumentedBindingModel.self
+        measure {
+            for i in 0..<100_000 {
+                instrumentation.recordHop(.callback, key: key, modelClass: modelClass, value: UInt64(i))
+            }
+        }
+    }
+
+    func heapBlocksInUse() -> Int {
+        var statistics = malloc_statistics_t()
+        malloc_zone_statistics(nil, &statistics)
+        return Int(statistics.blocks_in_use)
+    }
+}
@@ -0,0 +1,131 @@
+//
+//  CoalescedBindingTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import DJISDK
+import UXSDKCore
+import UXSDKCoreBenchmarks
+
+class CoalescedBindingTests: XCTestCase {
+
+    var handler: DUXBetaInMemoryKeyHandler!
+    var previousHandler: DUXBetaKeyInterfaces?
+    var model: DUXBetaBatteryWidgetModel!
+    var recomputeCount = 0
+    var observation: NSKeyValueObservation?
+
+    /**
+     *  The nine SDK keys the battery widget model binds to its state recompute.
+     */
+    let batteryKeys: [DJIKey] = [
+        DJIBatteryKey(index: 0, andParam: DJIBatteryParamChargeRemainingInPercent)!,
+        DJIBatteryKey(index: 1, andParam: DJIBatteryParamChargeRemainingInPercent)!,
+        DJIFlightControllerKey(param: DJIFlightControllerParamBatteryPercentageNeededToGoHome)!,
+        DJIFlightControllerKey(index: 0, andParam: DJIFlightControllerParamBatteryThresholdBehavior)!,
+        DJIBatteryKey(index: 0, andParam: DJIBatteryParamCellVoltages)!,
+        DJIBatteryKey(index: 1, andParam: DJIBatteryParamCellVoltages)!,
+        DJIBatteryKey(index: 0, andParam: DJIBatteryParamLatestWarningRecord)!,
+        DJIBatteryKey(index: 1, andParam: DJIBatteryParamLatestWarningRecord)!,
+        DJIBatteryKey(aggregationParam: DJIBatteryParamAggregationState)!,
+    ]
+
+    override func setUp() {
+        super.setUp()
+        let adapter = DUXBetaKeyInterfaceAdapter.sharedInstance()
+        previousHandler = adapter.getHandler()
+        handler = DUXBetaInMemoryKeyHandler()
+        handler.updateValue(NSNumber(value: true), for: DJIFlightControllerKey(param: DJIParamConnection)!)
+        adapter.setHandler(handler)
+
+        model = DUXBetaBatteryWidgetModel()
+        model.setup()
+        model.duxbeta_flushCoalescedRKVO()
+        recomputeCount = 0
+        // Every recompute sets a new battery state.
+        observation = model.observe(\.batteryState) { [unowned self] (_, _) in
+            self.recomputeCount += 1
+        }
+    }
+
+    override func tearDown() {
+        observation?.invalidate()
+        model.cleanup()
+        DUXBetaKeyInterfaceAdapter.sharedInstance().setHandler(previousHandler)
+        super.tearDown()
+    }
+
+    func testNineKeysRecomputeOnceOnFlush() {
+        pushBatteryKeys(iteration: 1)
+        XCTAssertEqual(recomputeCount, 0)
+
+        model.duxbeta_flushCoalescedRKVO()
+        XCTAssertEqual(recomputeCount, 1)
+        XCTAssertEqual(model.batteryState.batteryPercentage, 1, accuracy: 0.001)
+
+        model.duxbeta_flushCoalescedRKVO()
+        XCTAssertEqual(recomputeCount, 1)
+    }
+
+    func testNineKeysRecomputeOnceOnNextRunLoopTurn() {
+        pushBatteryKeys(iteration: 2)
+        XCTAssertEqual(recomputeCount, 0)
+
+        let recomputed = expectation(description: "recomputed on the main queue")
+        DispatchQueue.main.async {
+            recomputed.fulfill()
+        }
+        wait(for: [recomputed], timeout: 1)
+        XCTAssertEqual(recomputeCount, 1)
+    }
+
+    func testBurstsRecomputeOncePerFlush() {
+        for iteration in 1...10 {
+            pushBatteryKeys(iteration: iteration)
+            model.duxbeta_flushCoalescedRKVO()
+        }
+        XCTAssertEqual(recomputeCount, 10)
+    }
+
+    /**
+     *  Pushes all nine keys back to back. Warning records and the aggregation state can't be created outside the
+     *  SDK, they are pushed as nil.
+     */
+    func pushBatteryKeys(iteration: Int) {
+        for (index, key) in batteryKeys.enumerated() {
+            let value: Any?
+            switch index {
+            case 0...2:
+                value = NSNumber(value: iteration % 100)
+            case 3:
+                value = NSNumber(value: iteration % 3)
+            case 4, 5:
+                value = [NSNumber(value: 3800 + iteration), NSNumber(value: 3810 + iteration), NSNumber(value: 3790 + iteration)]
+            default:
+                value = nil
+            }
+            handler.updateValue(value, for: key)
+        }
+    }
+}
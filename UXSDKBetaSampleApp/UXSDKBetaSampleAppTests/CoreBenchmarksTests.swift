@@ -0,0 +1,94 @@
+//
+//  CoreBenchmarksTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import UXSDKCore
+import UXSDKCoreBenchmarks
+
+/**
+ *  Runs the UXSDKCoreBenchmarks scenarios so they stay working, with few iterations to keep the suite fast.
+ *  Timings are printed, not asserted.
+ */
+class CoreBenchmarksTests: XCTestCase {
+
+    var previousHandler: DUXBetaKeyInterfaces?
+
+    override func setUp() {
+        super.setUp()
+        previousHandler = DUXBetaKeyInterfaceAdapter.sharedInstance().getHandler()
+    }
+
+    override func tearDown() {
+        DUXBetaKeyInterfaceAdapter.sharedInstance().setHandler(previousHandler)
+        super.tearDown()
+    }
+
+    func testEveryBindingScenarioRuns() {
+        let benchmark = DUXBetaBindingBenchmark(iterations: 100)
+        let names = DUXBetaBindingBenchmark.scenarioNames()
+        XCTAssertEqual(names.count, 5)
+
+        let results = benchmark.runAllScenarios()
+        XCTAssertEqual(results.compactMap { $0["name"] as? String }, names)
+        for result in results {
+            XCTAssertEqual((result["iterations"] as? NSNumber)?.intValue, 100)
+            XCTAssertGreaterThan((result["totalNanoseconds"] as? NSNumber)?.uint64Value ?? 0, 0)
+            print(result)
+        }
+    }
+
+    func testBindingScenarioRestoresTheHandler() {
+        let handler = DUXBetaInMemoryKeyHandler()
+        DUXBetaKeyInterfaceAdapter.sharedInstance().setHandler(handler)
+
+        _ = DUXBetaBindingBenchmark(iterations: 10).runScenario(DUXBetaBindingBenchmarkSingleKeyUpdate)
+
+        XCTAssertTrue(DUXBetaKeyInterfaceAdapter.sharedInstance().getHandler() === handler)
+    }
+
+    func testBindingJSONListsEveryScenario() {
+        guard let data = DUXBetaBindingBenchmark(iterations: 10).runAllScenariosJSON(),
+            let results = (try? JSONSerialization.jsonObject(with: data)) as? [[String: Any]] else {
+            return XCTFail("the binding benchmark returned no JSON")
+        }
+        XCTAssertEqual(results.compactMap { $0["name"] as? String }, DUXBetaBindingBenchmark.scenarioNames())
+    }
+
+    func testSnapshotScenariosRunOffTheMainThread() {
+        let finished = expectation(description: "snapshot scenarios")
+        var json: Data?
+        DispatchQueue.global().async {
+            json = DUXBetaSnapshotBenchmark(duration: 0.5).runDefaultScenariosJSON()
+            finished.fulfill()
+        }
+        wait(for: [finished], timeout: 30)
+
+        guard let data = json, let results = (try? JSONSerialization.jsonObject(with: data)) as? [[String: Any]] else {
+            return XCTFail("the snapshot benchmark returned no results")
+        }
+        XCTAssertEqual(results.compactMap { ($0["consumers"] as? NSNumber)?.intValue }, [0, 1, 5])
+        print(results)
+    }
+}
@@ -0,0 +1,124 @@
+//
+//  CustomKeyPathTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import UXSDKCore
+
+class CustomKeyPathLeaf: NSObject {
+
+    @objc dynamic var value: NSNumber? = NSNumber(value: 3)
+}
+
+class CustomKeyPathBranch: NSObject {
+
+    @objc dynamic var leaf: CustomKeyPathLeaf? = CustomKeyPathLeaf()
+    @objc dynamic var value: NSNumber? = NSNumber(value: 2)
+}
+
+class CustomKeyPathRoot: NSObject {
+
+    @objc dynamic var branch: CustomKeyPathBranch? = CustomKeyPathBranch()
+    @objc dynamic var value: NSNumber? = NSNumber(value: 1)
+}
+
+class CustomKeyPathTests: XCTestCase {
+
+    let resolutionCount = 100_000
+    let root = CustomKeyPathRoot()
+
+    func testResolvesEverySegmentCount() {
+        XCTAssertEqual(root.duxbeta_customValue(forKeyPath: "value") as? NSNumber, NSNumber(value: 1))
+        XCTAssertEqual(root.duxbeta_customValue(forKeyPath: "branch.value") as? NSNumber, NSNumber(value: 2))
+        XCTAssertEqual(root.duxbeta_customValue(forKeyPath: "branch.leaf.value") as? NSNumber, NSNumber(value: 3))
+    }
+
+    func testStopsAtFirstNilComponent() {
+        let root = CustomKeyPathRoot()
+        root.branch?.leaf = nil
+        XCTAssertNil(root.duxbeta_customValue(forKeyPath: "branch.leaf.value"))
+    }
+
+    func testKeyPathsPastTheInternLimitStillResolve() {
+        let object = NSMutableDictionary()
+        for i in 0..<5_000 {
+            object["key\(i)"] = NSNumber(value: i)
+        }
+        for i in 0..<5_000 {
+            XCTAssertEqual(object.duxbeta_customValue(forKeyPath: "key\(i)") as? NSNumber, NSNumber(value: i))
+        }
+    }
+
+    func testConcurrentResolution() {
+        let threads = 8
+        let lock = NSLock()
+        var mismatches = 0
+        DispatchQueue.concurrentPerform(iterations: threads) { _ in
+            var threadMismatches = 0
+            for _ in 0..<(resolutionCount / threads) {
+                if (root.duxbeta_customValue(forKeyPath: "branch.leaf.value") as? NSNumber)?.intValue != 3 {
+                    threadMismatches += 1
+                }
+            }
+            lock.lock()
+            mismatches += threadMismatches
+            lock.unlock()
+        }
+        XCTAssertEqual(mismatches, 0)
+    }
+
+    func testResolutionPerformanceOneSegment() {
+        measureResolution(of: "value")
+    }
+
+    func testResolutionPerformanceTwoSegments() {
+        measureResolution(of: "branch.value")
+    }
+
+    func testResolutionPerformanceThreeSegments() {
+        measureResolution(of: "branch.leaf.value")
+    }
+
+    func testConcurrentResolutionPerformanceThreeSegments() {
+        measure {
+            DispatchQueue.concurrentPerform(iterations: 8) { _ in
+                for _ in 0..<(resolutionCount / 8) {
+                    _ = root.duxbeta_customValue(forKeyPath: "branch.leaf.value")
+                }
+            }
+        }
+    }
+
+    /**
+     *  Times 100,000 resolutions of the key path on one thread.
+     */
+    func measureResolution(of keyPath: String) {
+        XCTAssertNotNil(root.duxbeta_customValue(forKeyPath: keyPath))
+        measure {
+            for _ in 0..<resolutionCount {
+                _ = root.duxbeta_customValue(forKeyPath: keyPath)
+            }
+        }
+    }
+}
@@ -0,0 +1,293 @@
+//
+//  CustomObserverRuntimeTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import UXSDKCore
+
+/**
+ *  A model whose level is only changed through duxbeta_setCustomValue, from any thread.
+ */
+class CustomObserverStressModel: NSObject {
+
+    private let lock = NSLock()
+    private var storage: NSNumber?
+
+    @objc var level: NSNumber? {
+        lock.lock()
+        defer { lock.unlock() }
+        return storage
+    }
+
+    @objc func setLevel(_ level: NSNumber?, completion: DUXBetaCustomValueSetCompletionBlock?) {
+        willChangeValue(forKey: "level")
+        lock.lock()
+        storage = level
+        lock.unlock()
+        didChangeValue(forKey: "level")
+        completion?(nil)
+    }
+}
+
+/**
+ *  Records what one observer was told last.
+ */
+class CustomObserverStressObserver: NSObject {
+
+    private let lock = NSLock()
+    private var lastValue: NSNumber?
+    private var count = 0
+
+    var last: NSNumber? {
+        lock.lock()
+        defer { lock.unlock() }
+        return lastValue
+    }
+
+    var callbackCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return count
+    }
+
+    func record(_ value: Any?) {
+        lock.lock()
+        lastValue = value as? NSNumber
+        count += 1
+        lock.unlock()
+    }
+}
+
+/**
+ *  A plain KVO compliant model used to time the registry.
+ */
+class CustomObserverBenchmarkModel: NSObject {
+
+    @objc dynamic var value: NSNumber?
+    @objc dynamic var other: NSNumber?
+}
+
+class CustomObserverRuntimeTests: XCTestCase {
+
+    let writerCount = 8
+    let writesPerWriter = 5_000
+    let observerCount = 20
+
+    func testConcurrentSettersEndOnFinalValue() {
+        let model = CustomObserverStressModel()
+        let observers = (0..<observerCount).map { _ in CustomObserverStressObserver() }
+        for observer in observers {
+            model.duxbeta_addCustomObserver(observer, forKeyPath: "level") { [weak observer] (_, newValue) in
+                observer?.record(newValue)
+            }
+        }
+
+        DispatchQueue.concurrentPerform(iterations: writerCount) { writer in
+            for i in 0..<writesPerWriter {
+                model.duxbeta_setCustomValue(NSNumber(value: writer * writesPerWriter + i), forKeyPath: "level", completion: nil)
+            }
+        }
+
+        let finalValue = model.level
+        XCTAssertNotNil(finalValue)
+        for observer in observers {
+            XCTAssertEqual(observer.last, finalValue)
+            XCTAssertGreaterThan(observer.callbackCount, 0)
+        }
+        print("CustomObserverRuntime: \(writerCount * writesPerWriter) writes, \(model.duxbeta_coalescedCustomNotificationCount()) coalesced, \(observers[0].callbackCount) delivered per observer")
+
+        for observer in observers {
+            model.duxbeta_removeCustomObserver(observer)
+        }
+    }
+
+    func testKeyPathIsDeliveredOnOneThreadAtATime() {
+        let model = CustomObserverStressModel()
+        let observer = CustomObserverStressObserver()
+        let lock = NSLock()
+        var inside = 0
+        var overlapped = false
+        model.duxbeta_addCustomObserver(observer, forKeyPath: "level") { (_, newValue) in
+            lock.lock()
+            inside += 1
+            overlapped = overlapped || inside > 1
+            lock.unlock()
+            observer.record(newValue)
+            lock.lock()
+            inside -= 1
+            lock.unlock()
+        }
+
+        DispatchQueue.concurrentPerform(iterations: writerCount) { writer in
+            for i in 0..<writesPerWriter {
+                model.duxbeta_setCustomValue(NSNumber(value: writer * writesPerWriter + i), forKeyPath: "level", completion: nil)
+            }
+        }
+
+        XCTAssertFalse(overlapped)
+        XCTAssertEqual(observer.last, model.level)
+        model.duxbeta_removeCustomObserver(observer)
+    }
+
+    func testSequentialSettersAreNotCoalesced() {
+        let model = CustomObserverStressModel()
+        let observer = CustomObserverStressObserver()
+        model.duxbeta_addCustomObserver(observer, forKeyPath: "level") { (_, newValue) in
+            observer.record(newValue)
+        }
+
+        for i in 1...100 {
+            model.duxbeta_setCustomValue(NSNumber(value: i), forKeyPath: "level", completion: nil)
+        }
+
+        XCTAssertEqual(observer.callbackCount, 100)
+        XCTAssertEqual(observer.last, NSNumber(value: 100))
+        XCTAssertEqual(model.duxbeta_coalescedCustomNotificationCount(), 0)
+        model.duxbeta_removeCustomObserver(observer)
+    }
+
+    // MARK: - Registry
+
+    func testReleasedObserverIsPrunedEagerly() {
+        let model = CustomObserverBenchmarkModel()
+        var callbackCount = 0
+        autoreleasepool {
+            let observer = NSObject()
+            model.duxbeta_addCustomObserver(observer, forKeyPath: "value") { (_, _) in
+                callbackCount += 1
+            }
+            model.value = 1
+        }
+        model.value = 2
+
+        XCTAssertEqual(callbackCount, 1)
+    }
+
+    func testUnregisterOnlyRemovesThatObserver() {
+        let model = CustomObserverBenchmarkModel()
+        let kept = CustomObserverStressObserver()
+        let removed = CustomObserverStressObserver()
+        model.duxbeta_addCustomObserver(kept, forKeyPath: "value") { (_, newValue) in
+            kept.record(newValue)
+        }
+        model.duxbeta_addCustomObserver(removed, forKeyPath: "value") { (_, newValue) in
+            removed.record(newValue)
+        }
+        model.value = 1
+        model.duxbeta_removeCustomObserver(removed)
+        model.value = 2
+
+        XCTAssertEqual(kept.callbackCount, 2)
+        XCTAssertEqual(kept.last, NSNumber(value: 2))
+        XCTAssertEqual(removed.callbackCount, 1)
+        XCTAssertEqual(removed.last, NSNumber(value: 1))
+        model.duxbeta_removeCustomObserver(kept)
+    }
+
+    func testNotifyPerformance10ObserversPerKey() {
+        measureNotify(observersPerKey: 10)
+    }
+
+    func testNotifyPerformance100ObserversPerKey() {
+        measureNotify(observersPerKey: 100)
+    }
+
+    func testNotifyPerformance1000ObserversPerKey() {
+        measureNotify(observersPerKey: 1_000)
+    }
+
+    func testUnregisterPerformance10ObserversPerKey() {
+        measureUnregister(observersPerKey: 10)
+    }
+
+    func testUnregisterPerformance100ObserversPerKey() {
+        measureUnregister(observersPerKey: 100)
+    }
+
+    func testUnregisterPerformance1000ObserversPerKey() {
+        measureUnregister(observersPerKey: 1_000)
+    }
+
+    /**
+     *  Times 100 changes of one key, each delivered to every observer of the key.
+     */
+    func measureNotify(observersPerKey: Int) {
+        let model = CustomObserverBenchmarkModel()
+        let observers = (0..<observersPerKey).map { _ in NSObject() }
+        var callbackCount = 0
+        for observer in observers {
+            model.duxbeta_addCustomObserver(observer, forKeyPath: "value") { (_, _) in
+                callbackCount += 1
+            }
+        }
+
+        var next = 0
+        measure {
+            for _ in 0..<100 {
+                next += 1
+                model.value = NSNumber(value: next)
+            }
+        }
+
+        XCTAssertEqual(callbackCount, next * observersPerKey)
+        for observer in observers {
+            model.duxbeta_removeCustomObserver(observer)
+        }
+    }
+
+    /**
+     *  Times unregistering every observer of a key, with 10 other observers registered on another key.
+     */
+    func measureUnregister(observersPerKey: Int) {
+        let model = CustomObserverBenchmarkModel()
+        let bystanders = (0..<10).map { _ in NSObject() }
+        for bystander in bystanders {
+            model.duxbeta_addCustomObserver(bystander, forKeyPath: "other") { (_, _) in }
+        }
+
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            let observers = (0..<observersPerKey).map { _ in NSObject() }
+            for observer in observers {
+                model.duxbeta_addCustomObserver(observer, forKeyPath: "value") { (_, _) in }
+            }
+            startMeasuring()
+            for observer in observers {
+                model.duxbeta_removeCustomObserver(observer, forKeyPath: "value")
+            }
+            stopMeasuring()
+        }
+
+        var delivered = false
+        let probe = NSObject()
+        model.duxbeta_addCustomObserver(probe, forKeyPath: "value") { (_, _) in
+            delivered = true
+        }
+        model.value = 1
+        XCTAssertTrue(delivered)
+        model.duxbeta_removeCustomObserver(probe)
+        for bystander in bystanders {
+            model.duxbeta_removeCustomObserver(bystander)
+        }
+    }
+}
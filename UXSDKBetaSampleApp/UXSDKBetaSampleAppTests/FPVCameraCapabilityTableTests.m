@@ -0,0 +1,176 @@
+//
+//  FPVCameraCapabilityTableTests.m
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import <DJISDK/DJISDK.h>
+#import <DJIWidget/DJIWidget.h>
+#import <DJIWidget/DJIMavic2ZoomCameraImageCalibrateFilterDataSource.h>
+#import <DJIWidget/DJIMavic2ProCameraImageCalibrateFilterDataSource.h>
+#import <UXSDKCore/UXSDKCore.h>
+
+/**
+ * The isEqualToString: chain the capability table replaced, kept as the reference the table is checked against.
+ */
+static H264EncoderType LegacyEncodeType(NSString *cameraName, BOOL handheldWithDigitalZoom, BOOL wifiLink) {
+    if ([cameraName isEqualToString:DJICameraDisplayNameX3]) {
+        return handheldWithDigitalZoom ? H264EncoderType_A9_OSMO_NO_368 : H264EncoderType_DM368_inspire;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNameZ3]) {
+        return H264EncoderType_A9_OSMO_NO_368;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNameX5] ||
+        [cameraName isEqualToString:DJICameraDisplayNameX5R]) {
+        return H264EncoderType_DM368_inspire;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNamePhantom3ProfessionalCamera]) {
+        return H264EncoderType_DM365_phamtom3x;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNamePhantom3AdvancedCamera]) {
+        return H264EncoderType_A9_phantom3s;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNamePhantom3StandardCamera]) {
+        return H264EncoderType_A9_phantom3c;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNamePhantom4Camera]) {
+        return H264EncoderType_1860_phantom4x;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNameMavicProCamera]) {
+        return wifiLink ? H264EncoderType_1860_phantom4x : H264EncoderType_unknown;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNameSparkCamera]) {
+        return H264EncoderType_1860_phantom4x;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNameZ30]) {
+        return H264EncoderType_GD600;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNamePhantom4ProCamera] ||
+        [cameraName isEqualToString:DJICameraDisplayNamePhantom4AdvancedCamera] ||
+        [cameraName isEqualToString:DJICameraDisplayNameX5S] ||
+        [cameraName isEqualToString:DJICameraDisplayNameX4S] ||
+        [cameraName isEqualToString:DJICameraDisplayNameX7] ||
+        [cameraName isEqualToString:DJICameraDisplayNamePayload]) {
+        return H264EncoderType_H1_Inspire2;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNameMavicAirCamera]) {
+        return H264EncoderType_MavicAir;
+    }
+    if ([cameraName isEqualToString:DJICameraDisplayNameMavicMiniCamera]) {
+        return H264EncoderType_MavicMini;
+    }
+    return H264EncoderType_unknown;
+}
+
+static BOOL LegacyFitsPhotoAspectRatio(NSString *cameraName) {
+    return [cameraName isEqualToString:DJICameraDisplayNameX3] ||
+           [cameraName isEqualToString:DJICameraDisplayNameX5] ||
+           [cameraName isEqualToString:DJICameraDisplayNameX5R] ||
+           [cameraName isEqualToString:DJICameraDisplayNamePhantom3ProfessionalCamera] ||
+           [cameraName isEqualToString:DJICameraDisplayNameMavicProCamera];
+}
+
+static Class LegacyCalibrationDataSourceClass(NSString *cameraName) {
+    NSDictionary *dataSourceInfo = @{
+        DJICameraDisplayNameMavic2ZoomCamera : [DJIMavic2ZoomCameraImageCalibrateFilterDataSource class],
+        DJICameraDisplayNameMavic2ProCamera : [DJIMavic2ProCameraImageCalibrateFilterDataSource class],
+    };
+    return cameraName ? dataSourceInfo[cameraName] : nil;
+}
+
+@interface FPVCameraCapabilityTableTests : XCTestCase
+
+@end
+
+@implementation FPVCameraCapabilityTableTests
+
+- (NSArray<NSString *> *)cameraNames {
+    return @[DJICameraDisplayNameX3, DJICameraDisplayNameZ3, DJICameraDisplayNameX5, DJICameraDisplayNameX5R,
+             DJICameraDisplayNamePhantom3ProfessionalCamera, DJICameraDisplayNamePhantom3AdvancedCamera,
+             DJICameraDisplayNamePhantom3StandardCamera, DJICameraDisplayNamePhantom4Camera,
+             DJICameraDisplayNameMavicProCamera, DJICameraDisplayNameSparkCamera, DJICameraDisplayNameZ30,
+             DJICameraDisplayNamePhantom4ProCamera, DJICameraDisplayNamePhantom4AdvancedCamera,
+             DJICameraDisplayNameX5S, DJICameraDisplayNameX4S, DJICameraDisplayNameX7, DJICameraDisplayNamePayload,
+             DJICameraDisplayNameMavicAirCamera, DJICameraDisplayNameMavicMiniCamera,
+             DJICameraDisplayNameMavic2ZoomCamera, DJICameraDisplayNameMavic2ProCamera,
+             DJICameraDisplayNameXT, @"Unknown Camera", @""];
+}
+
+- (void)testDefaultTableMatchesTheLegacyChain {
+    DUXBetaFPVCameraCapabilityTable *table = [DUXBetaFPVCameraCapabilityTable defaultTable];
+    for (NSString *cameraName in [self cameraNames]) {
+        for (NSUInteger mode = 0; mode < 4; mode++) {
+            BOOL handheld = (mode & DUXBetaFPVCameraStreamModeHandheld) != 0;
+            BOOL wifiLink = (mode & DUXBetaFPVCameraStreamModeWiFiLink) != 0;
+            XCTAssertEqual([table encodeTypeForCameraName:cameraName mode:mode], LegacyEncodeType(cameraName, handheld, wifiLink),
+                           @"%@ in mode %lu", cameraName, (unsigned long)mode);
+        }
+        DUXBetaFPVCameraCapability *capability = [table capabilityForCameraName:cameraName];
+        XCTAssertEqual(capability.fitsPhotoAspectRatio, LegacyFitsPhotoAspectRatio(cameraName), @"%@", cameraName);
+        XCTAssertEqual(capability.calibrationDataSourceClass, LegacyCalibrationDataSourceClass(cameraName), @"%@", cameraName);
+    }
+    XCTAssertEqual([table encodeTypeForCameraName:nil mode:DUXBetaFPVCameraStreamModeDefault], H264EncoderType_unknown);
+    XCTAssertNil([table capabilityForCameraName:nil]);
+}
+
+- (void)testRegisteredCapabilitiesOverrideTheDefaults {
+    DUXBetaFPVCameraCapabilityTable *table = [[DUXBetaFPVCameraCapabilityTable alloc] init];
+    [table registerCapabilitiesFromDictionary:@{
+        DJICameraDisplayNameX3 : @{DUXBetaFPVCameraCapabilityEncodeTypeKey : @(H264EncoderType_DM368_inspire)},
+        @"Custom Camera" : @{DUXBetaFPVCameraCapabilityEncodeTypeKey : @(H264EncoderType_H1_Inspire2),
+                             DUXBetaFPVCameraCapabilityWiFiLinkEncodeTypeKey : @(H264EncoderType_1860_phantom4x)},
+    }];
+    XCTAssertEqual([table encodeTypeForCameraName:DJICameraDisplayNameX3 mode:DUXBetaFPVCameraStreamModeHandheld], H264EncoderType_DM368_inspire);
+    XCTAssertEqual([table encodeTypeForCameraName:@"Custom Camera" mode:DUXBetaFPVCameraStreamModeDefault], H264EncoderType_H1_Inspire2);
+    XCTAssertEqual([table encodeTypeForCameraName:@"Custom Camera" mode:DUXBetaFPVCameraStreamModeWiFiLink], H264EncoderType_1860_phantom4x);
+
+    DUXBetaFPVCameraCapability *override = [[DUXBetaFPVCameraCapability alloc] initWithDictionary:@{DUXBetaFPVCameraCapabilityEncodeTypeKey : @(H264EncoderType_GD600)}];
+    [table registerCapability:override forCameraName:@"Custom Camera"];
+    XCTAssertEqual([table encodeTypeForCameraName:@"Custom Camera" mode:DUXBetaFPVCameraStreamModeWiFiLink], H264EncoderType_GD600);
+    XCTAssertEqual([table encodeTypeForCameraName:DJICameraDisplayNameX3 mode:DUXBetaFPVCameraStreamModeDefault], H264EncoderType_DM368_inspire);
+}
+
+- (void)testOneMillionResolutionsPerformance {
+    DUXBetaFPVCameraCapabilityTable *table = [DUXBetaFPVCameraCapabilityTable defaultTable];
+    NSArray<NSString *> *cameraNames = [self cameraNames];
+    [self measureBlock:^{
+        NSUInteger sum = 0;
+        for (NSUInteger i = 0; i < 1000000; i++) {
+            sum += [table encodeTypeForCameraName:cameraNames[i % cameraNames.count] mode:i & 3];
+        }
+        XCTAssertGreaterThan(sum, 0);
+    }];
+}
+
+- (void)testOneMillionLegacyResolutionsPerformance {
+    NSArray<NSString *> *cameraNames = [self cameraNames];
+    [self measureBlock:^{
+        NSUInteger sum = 0;
+        for (NSUInteger i = 0; i < 1000000; i++) {
+            sum += LegacyEncodeType(cameraNames[i % cameraNames.count], (i & 1) != 0, (i & 2) != 0);
+        }
+        XCTAssertGreaterThan(sum, 0);
+    }];
+}
+
+@end
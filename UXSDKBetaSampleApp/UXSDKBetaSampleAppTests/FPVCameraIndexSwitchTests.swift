@@ -0,0 +1,186 @@
+//
+//  FPVCameraIndexSwitchTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import DJISDK
+import UXSDKCore
+import UXSDKCoreBenchmarks
+
+/**
+ *  Counts the listening calls and the reads per key, as "class|index|param", and the reads made on the main thread.
+ */
+class CountingKeyHandler: DUXBetaInMemoryKeyHandler {
+
+    private let lock = NSLock()
+    private var started = [String]()
+    private var stopped = [String]()
+    private var reads = [String]()
+    private var mainThreadReads = 0
+    private var stopAllCount = 0
+
+    static func identifier(_ key: DJIKey) -> String {
+        return "\(NSStringFromClass(type(of: key)))|\(key.index)|\(key.param)"
+    }
+
+    func resetCounts() {
+        lock.lock()
+        started.removeAll()
+        stopped.removeAll()
+        reads.removeAll()
+        mainThreadReads = 0
+        stopAllCount = 0
+        lock.unlock()
+    }
+
+    func counts() -> (started: [String], stopped: [String], reads: [String], mainThreadReads: Int, stopAll: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+        return (started, stopped, reads, mainThreadReads, stopAllCount)
+    }
+
+    override func startListeningForChanges(on key: DJIKey, withListener listener: Any, andUpdate updateBlock: @escaping DJIKeyedListenerUpdateBlock) {
+        lock.lock()
+        started.append(CountingKeyHandler.identifier(key))
+        lock.unlock()
+        super.startListeningForChanges(on: key, withListener: listener, andUpdate: updateBlock)
+    }
+
+    override func stopListening(on key: DJIKey, ofListener listener: Any) {
+        lock.lock()
+        stopped.append(CountingKeyHandler.identifier(key))
+        lock.unlock()
+        super.stopListening(on: key, ofListener: listener)
+    }
+
+    override func stopAllListening(ofListeners listener: Any) {
+        lock.lock()
+        stopAllCount += 1
+        lock.unlock()
+        super.stopAllListening(ofListeners: listener)
+    }
+
+    override func getValueFor(_ key: DJIKey) -> DJIKeyedValue? {
+        lock.lock()
+        reads.append(CountingKeyHandler.identifier(key))
+        mainThreadReads += Thread.isMainThread ? 1 : 0
+        lock.unlock()
+        return super.getValueFor(key)
+    }
+}
+
+class FPVCameraIndexSwitchTests: XCTestCase {
+
+    let cameraParams = [DJICameraParamDisplayName, DJICameraParamPhotoAspectRatio, DJICameraParamVideoResolutionAndFrameRate]
+    let cameraNames = [DJICameraDisplayNameX4S, DJICameraDisplayNameXT]
+
+    var handler: CountingKeyHandler!
+    var previousHandler: DUXBetaKeyInterfaces?
+    var model: DUXBetaFPVWidgetModel!
+
+    override func setUp() {
+        super.setUp()
+        let adapter = DUXBetaKeyInterfaceAdapter.sharedInstance()
+        previousHandler = adapter.getHandler()
+        handler = CountingKeyHandler()
+        handler.updateValue(NSNumber(value: true), for: DJIFlightControllerKey(param: DJIParamConnection)!)
+        handler.updateValue(DJIAircraftModelNameMatrice210V2, for: DJIProductKey(param: DJIProductParamModelName)!)
+        for (index, name) in cameraNames.enumerated() {
+            handler.updateValue(name, for: DJICameraKey(index: index, andParam: DJICameraParamDisplayName)!)
+        }
+        adapter.setHandler(handler)
+
+        model = DUXBetaFPVWidgetModel()
+        model.setup()
+    }
+
+    override func tearDown() {
+        model.cleanup()
+        DUXBetaKeyInterfaceAdapter.sharedInstance().setHandler(previousHandler)
+        super.tearDown()
+    }
+
+    func cameraKeys(index: Int) -> [String] {
+        return cameraParams.map { CountingKeyHandler.identifier(DJICameraKey(index: index, andParam: $0)!) }
+    }
+
+    func waitForCameraName(_ name: String) {
+        let predicate = NSPredicate { model, _ in (model as? DUXBetaFPVWidgetModel)?.cameraName == name }
+        wait(for: [expectation(for: predicate, evaluatedWith: model, handler: nil)], timeout: 5)
+    }
+
+    /**
+     *  A switch stops listening to the camera keys of the old index and starts on those of the new one, nothing
+     *  else. The new values are read off the calling thread.
+     */
+    func testSwitchRebindsOnlyTheCameraKeys() {
+        waitForCameraName(cameraNames[0])
+
+        for (from, to) in [(0, 1), (1, 0), (0, 1)] {
+            handler.resetCounts()
+            model.preferredCameraIndex = to
+            waitForCameraName(cameraNames[to])
+
+            let counts = handler.counts()
+            XCTAssertEqual(counts.started.sorted(), cameraKeys(index: to).sorted(), "switch from \(from) to \(to)")
+            XCTAssertEqual(counts.stopped.sorted(), cameraKeys(index: from).sorted(), "switch from \(from) to \(to)")
+            XCTAssertEqual(counts.stopAll, 0)
+            XCTAssertEqual(counts.mainThreadReads, 0)
+            XCTAssertTrue(Set(counts.reads).isSubset(of: cameraKeys(index: to)))
+        }
+    }
+
+    func testSettingTheSameIndexRebindsNothing() {
+        handler.resetCounts()
+        model.preferredCameraIndex = 0
+
+        let counts = handler.counts()
+        XCTAssertTrue(counts.started.isEmpty)
+        XCTAssertTrue(counts.stopped.isEmpty)
+    }
+
+    /**
+     *  The listener count is back where it started after any number of switches.
+     */
+    func testSwitchesKeepTheListenerCount() {
+        let listeners = handler.listenerCount
+        for i in 1...100 {
+            model.preferredCameraIndex = i % 2
+        }
+        model.preferredCameraIndex = 0
+        XCTAssertEqual(handler.listenerCount, listeners)
+        waitForCameraName(cameraNames[0])
+    }
+
+    func testRapidTogglingLatency() {
+        var index = 0
+        measure {
+            for _ in 0..<1_000 {
+                index = 1 - index
+                model.preferredCameraIndex = index
+            }
+        }
+        waitForCameraName(cameraNames[index])
+    }
+}
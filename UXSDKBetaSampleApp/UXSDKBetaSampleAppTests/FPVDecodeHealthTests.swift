@@ -0,0 +1,169 @@
+//
+//  FPVDecodeHealthTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import UXSDKCore
+
+/**
+ *  Drives the aggregator with synthetic times, in nanoseconds from an arbitrary start, instead of a decoder.
+ */
+class FPVDecodeHealthTests: XCTestCase {
+
+    let start: UInt64 = 1_000_000_000
+    let frameInterval: UInt64 = 33_333_333
+
+    let lock = NSLock()
+    var healthChanges = [DUXBetaFPVDecodeHealthSummary]()
+    var healthChanged: XCTestExpectation?
+    var aggregator: DUXBetaFPVDecodeHealthAggregator!
+
+    override func setUp() {
+        super.setUp()
+        aggregator = DUXBetaFPVDecodeHealthAggregator(publishInterval: 1) { [unowned self] summary in
+            guard summary.healthChanged else { return }
+            self.lock.lock()
+            self.healthChanges.append(summary)
+            self.healthChanged?.fulfill()
+            self.lock.unlock()
+        }
+    }
+
+    /**
+     *  Waits for the given number of health changes published on the aggregator's queue.
+     */
+    func waitForHealthChanges(_ count: Int) -> [DUXBetaFPVDecodeHealth] {
+        lock.lock()
+        let missing = count - healthChanges.count
+        if missing > 0 {
+            healthChanged = expectation(description: "health changes")
+            healthChanged?.expectedFulfillmentCount = missing
+        }
+        lock.unlock()
+        if let healthChanged = healthChanged {
+            wait(for: [healthChanged], timeout: 5)
+        }
+        lock.lock()
+        healthChanged = nil
+        defer { lock.unlock() }
+        return healthChanges.map { $0.health }
+    }
+
+    func testSteadyFramesAreHealthyWithoutJitter() {
+        for frame in 0..<30 {
+            aggregator.recordDecodedFrame(withTimestamp: UInt32(frame * 3_000), atTime: start + UInt64(frame) * frameInterval)
+        }
+        let summary = aggregator.publishSummary(atTime: start + 30 * frameInterval)
+
+        XCTAssertEqual(summary.health, .healthy)
+        XCTAssertFalse(summary.healthChanged)
+        XCTAssertEqual(summary.framesDecoded, 30)
+        XCTAssertEqual(summary.framesFailed, 0)
+        XCTAssertEqual(summary.lastTimestamp, 29 * 3_000)
+        XCTAssertEqual(summary.jitterHistogram.map { $0.intValue }, [28, 0, 0, 0, 0, 0, 0, 0])
+        XCTAssertEqual(waitForHealthChanges(1), [.healthy])
+    }
+
+    /**
+     *  Intervals alternating between 33 and 37 ms jitter by 4 ms, bucket 3 holds [4, 8) ms. One 300 ms hiccup adds
+     *  two jitters of about 300 ms, which land in the last bucket.
+     */
+    func testJitterIsBucketedByPowersOfTwo() {
+        var time = start
+        for frame in 0..<21 {
+            aggregator.recordDecodedFrame(withTimestamp: UInt32(frame), atTime: time)
+            time += (frame % 2 == 0 ? 33 : 37) * NSEC_PER_MSEC
+        }
+        time += 300 * NSEC_PER_MSEC
+        aggregator.recordDecodedFrame(withTimestamp: 21, atTime: time)
+        time += 33 * NSEC_PER_MSEC
+        aggregator.recordDecodedFrame(withTimestamp: 22, atTime: time)
+        let summary = aggregator.publishSummary(atTime: time)
+
+        XCTAssertEqual(summary.framesDecoded, 23)
+        XCTAssertEqual(summary.jitterHistogram.map { $0.intValue }, [0, 0, 0, 19, 0, 0, 0, 2])
+    }
+
+    /**
+     *  Three failures in a row make the decoder unhealthy, the next decoded frame healthy again, and each change
+     *  is published right away.
+     */
+    func testConsecutiveFailuresFlipTheHealth() {
+        aggregator.recordDecodedFrame(withTimestamp: 1, atTime: start)
+        aggregator.recordFailure(atTime: start + frameInterval)
+        aggregator.recordFailure(atTime: start + 2 * frameInterval)
+        aggregator.recordDecodedFrame(withTimestamp: 2, atTime: start + 3 * frameInterval)
+        for i in 4..<7 {
+            aggregator.recordFailure(atTime: start + UInt64(i) * frameInterval)
+        }
+        aggregator.recordDecodedFrame(withTimestamp: 3, atTime: start + 7 * frameInterval)
+
+        XCTAssertEqual(waitForHealthChanges(3), [.healthy, .unhealthy, .healthy])
+        let summary = aggregator.publishSummary(atTime: start + 8 * frameInterval)
+        XCTAssertEqual(summary.framesDecoded, 3)
+        XCTAssertEqual(summary.framesFailed, 5)
+        XCTAssertEqual(summary.health, .healthy)
+    }
+
+    func testNoFramesForTheStaleIntervalIsUnhealthy() {
+        aggregator.staleInterval = 1
+        aggregator.recordDecodedFrame(withTimestamp: 1, atTime: start)
+
+        let fresh = aggregator.publishSummary(atTime: start + NSEC_PER_SEC / 2)
+        XCTAssertEqual(fresh.health, .healthy)
+        XCTAssertFalse(fresh.healthChanged)
+
+        let stale = aggregator.publishSummary(atTime: start + 3 * NSEC_PER_SEC / 2)
+        XCTAssertEqual(stale.health, .unhealthy)
+        XCTAssertTrue(stale.healthChanged)
+        XCTAssertEqual(stale.framesDecoded, 0)
+    }
+
+    /**
+     *  Every summary covers its own period, and stop starts the next stream over from an unknown health.
+     */
+    func testPeriodsAndRestartsStartFromZero() {
+        for frame in 0..<10 {
+            aggregator.recordDecodedFrame(withTimestamp: UInt32(frame), atTime: start + UInt64(frame) * frameInterval)
+        }
+        XCTAssertEqual(aggregator.publishSummary(atTime: start + 10 * frameInterval).framesDecoded, 10)
+        XCTAssertEqual(aggregator.publishSummary(atTime: start + 11 * frameInterval).framesDecoded, 0)
+
+        aggregator.stop()
+        let restarted = aggregator.publishSummary(atTime: start + 100 * frameInterval)
+        XCTAssertEqual(restarted.health, .unknown)
+        XCTAssertEqual(restarted.lastTimestamp, 0)
+    }
+
+    func testRecordingPerformance() {
+        aggregator.recordDecodedFrame(withTimestamp: 0, atTime: start)
+        var time = start
+        measure {
+            for frame in 0..<100_000 {
+                time += frameInterval + UInt64(frame % 7) * NSEC_PER_MSEC
+                aggregator.recordDecodedFrame(withTimestamp: UInt32(truncatingIfNeeded: frame), atTime: time)
+            }
+        }
+    }
+}
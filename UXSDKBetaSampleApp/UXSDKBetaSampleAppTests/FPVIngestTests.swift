@@ -0,0 +1,175 @@
+//
+//  FPVIngestTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import UXSDKCore
+
+class FPVIngestTests: XCTestCase {
+
+    static let framesPerSecond = 30.0
+    static let keyframeInterval = 30
+
+    /**
+     *  One Annex-B chunk per frame. Keyframes carry an SPS, a PPS and an IDR slice, the others a single P slice.
+     *  The frame number follows the first NAL header as ASCII digits and the filler never contains a zero byte,
+     *  so the only start codes are the real ones and a chunk can be checked byte for byte.
+     */
+    static func chunk(frame: Int) -> [UInt8] {
+        let isKeyframe = frame % keyframeInterval == 0
+        var bytes: [UInt8] = [0, 0, 0, 1, isKeyframe ? 0x67 : 0x41]
+        bytes += Array(String(format: "%08d", frame).utf8)
+        if isKeyframe {
+            bytes += [0, 0, 0, 1, 0x68, 0xce, 0x3c, 0x80, 0, 0, 0, 1, 0x65]
+        }
+        let fillerLength = isKeyframe ? 20_000 : 6_000
+        for i in 0..<fillerLength {
+            bytes.append(UInt8(1 + (frame + i) % 255))
+        }
+        return bytes
+    }
+
+    static func frameNumber(of bytes: UnsafePointer<UInt8>, length: Int) -> Int? {
+        guard length >= 13 else { return nil }
+        let digits = String(bytes: UnsafeBufferPointer(start: bytes + 5, count: 8), encoding: .ascii)
+        return digits.flatMap { Int($0) }
+    }
+
+    struct Run {
+        var delivered = [Int]()
+        var corrupted = 0
+        var deliveredBytes: UInt64 = 0
+        var writtenBytes: UInt64 = 0
+    }
+
+    /**
+     *  Feeds the frames at twice the real-time rate from a background thread, the consumer stalling for the given
+     *  time on every frame the stall predicate picks.
+     */
+    func ingest(frames: Int, capacity: Int, policy: DUXBetaFPVIngestOverflowPolicy, stall: TimeInterval, stallWhen: @escaping (Int) -> Bool) -> (Run, DUXBetaFPVIngestRingBuffer) {
+        let lock = NSLock()
+        var run = Run()
+        let buffer = DUXBetaFPVIngestRingBuffer(capacity: capacity) { bytes, length in
+            let frame = FPVIngestTests.frameNumber(of: bytes, length: length)
+            let intact = frame.map { FPVIngestTests.chunk(frame: $0).elementsEqual(UnsafeBufferPointer(start: bytes, count: length)) } ?? false
+            lock.lock()
+            if let frame = frame, intact {
+                run.delivered.append(frame)
+            } else {
+                run.corrupted += 1
+            }
+            run.deliveredBytes += UInt64(length)
+            lock.unlock()
+            if let frame = frame, stallWhen(frame) {
+                Thread.sleep(forTimeInterval: stall)
+            }
+        }
+        buffer.overflowPolicy = policy
+
+        let produced = expectation(description: "produced")
+        Thread.detachNewThread {
+            let interval = 1 / (FPVIngestTests.framesPerSecond * 2)
+            let start = Date()
+            for frame in 0..<frames {
+                let chunk = FPVIngestTests.chunk(frame: frame)
+                _ = buffer.writeBytes(chunk, length: chunk.count)
+                lock.lock()
+                run.writtenBytes += UInt64(chunk.count)
+                lock.unlock()
+                let next = start.addingTimeInterval(Double(frame + 1) * interval)
+                Thread.sleep(forTimeInterval: max(next.timeIntervalSinceNow, 0))
+            }
+            while buffer.usedBytes > 0 {
+                usleep(1_000)
+            }
+            produced.fulfill()
+        }
+        wait(for: [produced], timeout: Double(frames) / FPVIngestTests.framesPerSecond + 10)
+
+        lock.lock()
+        defer { lock.unlock() }
+        return (run, buffer)
+    }
+
+    /**
+     *  The decoder stalls for longer than the buffer can absorb. Chunks get dropped, but what is delivered is
+     *  intact, in order, and resumes on a keyframe after every gap.
+     */
+    func testDroppedChunksResumeOnAKeyframe() {
+        let (run, buffer) = ingest(frames: 180, capacity: 32 * 1024, policy: .dropToNextKeyframe, stall: 0.2) { $0 % 45 == 20 }
+
+        XCTAssertEqual(run.corrupted, 0)
+        XCTAssertGreaterThan(buffer.bytesDropped, 0)
+        XCTAssertEqual(run.delivered.first, 0)
+        for (previous, next) in zip(run.delivered, run.delivered.dropFirst()) {
+            XCTAssertGreaterThan(next, previous)
+            if next != previous + 1 {
+                XCTAssertEqual(next % FPVIngestTests.keyframeInterval, 0, "frame \(next) follows a gap after \(previous)")
+            }
+        }
+        XCTAssertEqual(buffer.bytesIn, run.writtenBytes)
+        XCTAssertEqual(run.deliveredBytes + buffer.bytesDropped, buffer.bytesIn)
+        XCTAssertLessThanOrEqual(buffer.highWaterMark, UInt64(buffer.capacity))
+        print("fpv ingest at 2x: \(run.delivered.count) of 180 frames delivered, \(buffer.bytesDropped) bytes dropped")
+    }
+
+    /**
+     *  Short decoder stalls are absorbed by blocking the producer, nothing is dropped.
+     */
+    func testBlockingPolicyDeliversEveryChunk() {
+        let (run, buffer) = ingest(frames: 120, capacity: 64 * 1024, policy: .block, stall: 0.02) { $0 % 15 == 5 }
+
+        XCTAssertEqual(run.corrupted, 0)
+        XCTAssertEqual(run.delivered, Array(0..<120))
+        XCTAssertEqual(buffer.bytesDropped, 0)
+        XCTAssertEqual(run.deliveredBytes, buffer.bytesIn)
+    }
+
+    /**
+     *  A stream switch drops what follows up to the next keyframe, whatever was buffered already still arrives.
+     */
+    func testDiscardUntilKeyframeSkipsToTheNextKeyframe() {
+        let lock = NSLock()
+        var delivered = [Int]()
+        let buffer = DUXBetaFPVIngestRingBuffer(capacity: 1024 * 1024) { bytes, length in
+            lock.lock()
+            delivered.append(FPVIngestTests.frameNumber(of: bytes, length: length) ?? -1)
+            lock.unlock()
+        }
+        for frame in 0..<75 {
+            if frame == 10 {
+                buffer.discardUntilKeyframe()
+            }
+            let chunk = FPVIngestTests.chunk(frame: frame)
+            _ = buffer.writeBytes(chunk, length: chunk.count)
+        }
+        while buffer.usedBytes > 0 {
+            usleep(1_000)
+        }
+
+        lock.lock()
+        XCTAssertEqual(delivered, Array(0..<10) + Array(30..<75))
+        lock.unlock()
+    }
+}
@@ -0,0 +1,178 @@
+//
+//  FlyZoneSpatialIndexTests.m
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import <MapKit/MapKit.h>
+#import <UXSDKMap/UXSDKMap.h>
+#import <UXSDKMapBenchmarks/UXSDKMapBenchmarks.h>
+
+@interface FlyZoneSpatialIndexTests : XCTestCase
+
+@property (nonatomic, strong) NSMutableData *rectData;
+
+@end
+
+@implementation FlyZoneSpatialIndexTests
+
+/**
+ * Randomized zone bounds spread over about two degrees, every seventh a single point, as the benchmark builds them.
+ */
+- (DUXBetaFlyZoneSpatialIndex<NSNumber *> *)indexWithZones:(NSUInteger)zones {
+    self.rectData = [NSMutableData dataWithLength:MAX(zones, (NSUInteger)1) * sizeof(MKMapRect)];
+    MKMapRect *rects = self.rectData.mutableBytes;
+    NSMutableArray<NSNumber *> *objects = [NSMutableArray arrayWithCapacity:zones];
+    for (NSUInteger i = 0; i < zones; i++) {
+        CLLocationCoordinate2D center = CLLocationCoordinate2DMake(21.5 + 2 * drand48(), 113.0 + 2 * drand48());
+        MKMapPoint point = MKMapPointForCoordinate(center);
+        double radius = i % 7 == 0 ? 0 : (50.0 + drand48() * 5000.0) * MKMapPointsPerMeterAtLatitude(center.latitude);
+        rects[i] = MKMapRectMake(point.x - radius, point.y - radius, 2 * radius, 2 * radius);
+        [objects addObject:@(i)];
+    }
+    return [self indexWithRects:rects objects:objects];
+}
+
+- (DUXBetaFlyZoneSpatialIndex<NSNumber *> *)indexWithRects:(MKMapRect *)rects objects:(NSArray<NSNumber *> *)objects {
+    return [[DUXBetaFlyZoneSpatialIndex alloc] initWithObjects:objects mapRect:^MKMapRect(NSNumber *object) {
+        return rects[object.unsignedIntegerValue];
+    }];
+}
+
+- (MKMapRect)randomViewport {
+    CLLocationCoordinate2D center = CLLocationCoordinate2DMake(21.5 + 2 * drand48(), 113.0 + 2 * drand48());
+    MKMapPoint point = MKMapPointForCoordinate(center);
+    double pointsPerMeter = MKMapPointsPerMeterAtLatitude(center.latitude);
+    double width = (1000.0 + drand48() * 49000.0) * pointsPerMeter;
+    double height = (1000.0 + drand48() * 49000.0) * pointsPerMeter;
+    return MKMapRectMake(point.x - width / 2, point.y - height / 2, width, height);
+}
+
+// Every zone whose bounds touch the rect or one of its copies a world width to either side.
+- (NSIndexSet *)bruteForceZones:(NSUInteger)zones intersecting:(MKMapRect)mapRect {
+    MKMapRect *rects = self.rectData.mutableBytes;
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSet];
+    for (NSUInteger i = 0; i < zones; i++) {
+        for (int shift = -2; shift <= 2; shift++) {
+            MKMapRect query = mapRect;
+            query.origin.x += shift * MKMapSizeWorld.width;
+            if (DUXBetaFlyZoneSpatialIndexRectsIntersect(rects[i], query)) {
+                [expected addIndex:i];
+                break;
+            }
+        }
+    }
+    return expected;
+}
+
+- (void)checkIndex:(DUXBetaFlyZoneSpatialIndex<NSNumber *> *)index zones:(NSUInteger)zones query:(MKMapRect)mapRect {
+    NSMutableIndexSet *found = [NSMutableIndexSet indexSet];
+    __block NSUInteger reported = 0;
+    [index enumerateObjectsIntersectingMapRect:mapRect usingBlock:^(NSNumber *object) {
+        [found addIndex:object.unsignedIntegerValue];
+        reported++;
+    }];
+    XCTAssertEqual(reported, found.count, @"A zone was reported more than once");
+    XCTAssertEqualObjects(found, [self bruteForceZones:zones intersecting:mapRect], @"%lu zones, query %@",
+                          (unsigned long)zones, MKStringFromMapRect(mapRect));
+
+    NSMutableIndexSet *listed = [NSMutableIndexSet indexSet];
+    for (NSNumber *object in [index objectsIntersectingMapRect:mapRect]) {
+        [listed addIndex:object.unsignedIntegerValue];
+    }
+    XCTAssertEqualObjects(listed, found);
+}
+
+- (void)testRandomizedDatasetsMatchBruteForce {
+    long seed = 1;
+    // Sizes around a node's capacity exercise partly filled leaves.
+    for (NSNumber *zones in @[@0, @1, @15, @16, @17, @100, @1000, @10000]) {
+        srand48(seed++);
+        NSUInteger count = zones.unsignedIntegerValue;
+        DUXBetaFlyZoneSpatialIndex<NSNumber *> *index = [self indexWithZones:count];
+        XCTAssertEqual(index.count, count);
+        for (NSUInteger query = 0; query < 200; query++) {
+            [self checkIndex:index zones:count query:[self randomViewport]];
+        }
+    }
+}
+
+- (void)testFiftyThousandZonesMatchBruteForce {
+    srand48(2020);
+    DUXBetaFlyZoneSpatialIndex<NSNumber *> *index = [self indexWithZones:50000];
+    for (NSUInteger query = 0; query < 200; query++) {
+        [self checkIndex:index zones:50000 query:[self randomViewport]];
+    }
+}
+
+- (void)testZoneBoundsAndQueryEdgesThatOnlyTouch {
+    srand48(7);
+    NSUInteger zones = 1000;
+    DUXBetaFlyZoneSpatialIndex<NSNumber *> *index = [self indexWithZones:zones];
+    MKMapRect *rects = self.rectData.mutableBytes;
+    for (NSUInteger i = 0; i < zones; i += 13) {
+        MKMapRect rect = rects[i];
+        // A query just right of the zone, sharing its right edge, and the zone's exact bounds.
+        [self checkIndex:index zones:zones query:MKMapRectMake(MKMapRectGetMaxX(rect), rect.origin.y, 1000, 1000)];
+        [self checkIndex:index zones:zones query:rect];
+        [self checkIndex:index zones:zones query:MKMapRectMake(rect.origin.x, rect.origin.y, 0, 0)];
+    }
+}
+
+- (void)testQueriesWrapAroundTheAntimeridian {
+    srand48(11);
+    NSUInteger zones = 2000;
+    self.rectData = [NSMutableData dataWithLength:zones * sizeof(MKMapRect)];
+    MKMapRect *rects = self.rectData.mutableBytes;
+    NSMutableArray<NSNumber *> *objects = [NSMutableArray arrayWithCapacity:zones];
+    double worldWidth = MKMapSizeWorld.width;
+    for (NSUInteger i = 0; i < zones; i++) {
+        // Zones on both sides of the date line, some overhanging it.
+        CLLocationCoordinate2D center = CLLocationCoordinate2DMake(-20 + 4 * drand48(), i % 2 == 0 ? 179 + drand48() : -180 + drand48());
+        MKMapPoint point = MKMapPointForCoordinate(center);
+        double radius = (50.0 + drand48() * 20000.0) * MKMapPointsPerMeterAtLatitude(center.latitude);
+        rects[i] = MKMapRectMake(point.x - radius, point.y - radius, 2 * radius, 2 * radius);
+        [objects addObject:@(i)];
+    }
+    DUXBetaFlyZoneSpatialIndex<NSNumber *> *index = [self indexWithRects:rects objects:objects];
+
+    for (NSUInteger query = 0; query < 200; query++) {
+        CLLocationCoordinate2D center = CLLocationCoordinate2DMake(-20 + 4 * drand48(), 179.5 + drand48());
+        MKMapPoint point = MKMapPointForCoordinate(center);
+        double pointsPerMeter = MKMapPointsPerMeterAtLatitude(center.latitude);
+        double width = (1000.0 + drand48() * 199000.0) * pointsPerMeter;
+        double height = (1000.0 + drand48() * 199000.0) * pointsPerMeter;
+        MKMapRect mapRect = MKMapRectMake(point.x - width / 2, point.y - height / 2, width, height);
+        // The same viewport as the map may report it, past the right edge or shifted left of zero.
+        [self checkIndex:index zones:zones query:mapRect];
+        [self checkIndex:index zones:zones query:MKMapRectOffset(mapRect, -worldWidth, 0)];
+    }
+}
+
+- (void)testSpatialIndexBenchmark {
+    [self measureBlock:^{
+        NSLog(@"%@", [DUXBetaFlyZoneSpatialIndexBenchmark runFiftyThousandZones]);
+    }];
+}
+
+@end
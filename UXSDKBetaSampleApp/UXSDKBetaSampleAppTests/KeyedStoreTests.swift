@@ -0,0 +1,247 @@
+//
+//  KeyedStoreTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import QuartzCore
+@testable import UXSDKCore
+
+class KeyedStoreTests: XCTestCase {
+
+    let key = ConcreteKey(index: 0, parameter: .PeakingThreshold)
+
+    func integer(_ value: ModelValue?) -> Int {
+        return (value?.value as? NSNumber)?.intValue ?? 0
+    }
+
+    /**
+     *  Increments from several threads through update(key:transform:). Every transform sees a distinct prior
+     *  value and the values seen form one unbroken sequence, so the updates took effect one at a time.
+     */
+    func testUpdatesAreLinearizable() {
+        let store = FlatStore()
+        let threads = 8
+        let incrementsPerThread = 10_000
+        let lock = NSLock()
+        var seen = [[Int]](repeating: [], count: threads)
+        DispatchQueue.concurrentPerform(iterations: threads) { thread in
+            var values = [Int]()
+            values.reserveCapacity(incrementsPerThread)
+            for _ in 0..<incrementsPerThread {
+                store.update(key: key, transform: { prior in
+                    values.append(self.integer(prior))
+                    return ModelValue(integer: self.integer(prior) + 1)
+                })
+            }
+            lock.lock()
+            seen[thread] = values
+            lock.unlock()
+        }
+
+        XCTAssertEqual(integer(store.availableModelValueFor(key: key)), threads * incrementsPerThread)
+        XCTAssertEqual(seen.flatMap { $0 }.sorted(), Array(0..<(threads * incrementsPerThread)))
+        for values in seen {
+            XCTAssertEqual(values, values.sorted())
+        }
+    }
+
+    func testCompareAndSetLoopsAreLinearizable() {
+        let store = FlatStore()
+        let threads = 8
+        let incrementsPerThread = 10_000
+        let lock = NSLock()
+        var failures = 0
+        DispatchQueue.concurrentPerform(iterations: threads) { _ in
+            var failed = 0
+            for _ in 0..<incrementsPerThread {
+                while true {
+                    let expected = store.availableModelValueFor(key: key)
+                    if store.compareAndSet(key: key, expected: expected, new: ModelValue(integer: self.integer(expected) + 1)) {
+                        break
+                    }
+                    failed += 1
+                }
+            }
+            lock.lock()
+            failures += failed
+            lock.unlock()
+        }
+
+        XCTAssertEqual(integer(store.availableModelValueFor(key: key)), threads * incrementsPerThread)
+        print("compare and set retries: \(failures)")
+    }
+
+    /**
+     *  didChange runs under the shard lock, so each change it reports starts from the value the previous one
+     *  ended with, and setting an equal value reports nothing.
+     */
+    func testChangesAreReportedInUpdateOrder() {
+        let store = FlatStore()
+        let lock = NSLock()
+        var changes = [(prior: ModelValue?, updated: ModelValue?)]()
+        DispatchQueue.concurrentPerform(iterations: 8) { thread in
+            for i in 0..<1_000 {
+                let value = ModelValue(integer: (thread * 1_000 + i) % 3)
+                store.update(key: key, transform: { prior in
+                    prior?.testEqual(value) == true ? prior : value
+                }, didChange: { prior, updated in
+                    lock.lock()
+                    changes.append((prior: prior, updated: updated))
+                    lock.unlock()
+                })
+            }
+        }
+
+        XCTAssertNil(changes.first?.prior)
+        for i in 1..<changes.count {
+            XCTAssertTrue(changes[i].prior === changes[i - 1].updated)
+            XCTAssertFalse(changes[i].updated!.testEqual(changes[i].prior))
+        }
+        XCTAssertTrue(changes.last?.updated === store.availableModelValueFor(key: key))
+    }
+
+    /**
+     *  100,000 writes spread over the writers, each writer on its own keys, with a reader per writer.
+     */
+    func measureWrites(writers: Int) {
+        let store = FlatStore()
+        let writesPerWriter = 100_000 / writers
+        let values = (0..<16).map { ModelValue(integer: $0) }
+        measure {
+            DispatchQueue.concurrentPerform(iterations: writers * 2) { thread in
+                let writer = thread / 2
+                for i in 0..<writesPerWriter {
+                    let key = ConcreteKey(index: writer * 16 + i % 16, parameter: .PeakingThreshold)
+                    if thread % 2 == 0 {
+                        store.update(modelValue: values[i % values.count], for: key)
+                    } else {
+                        _ = store.availableModelValueFor(key: key)
+                    }
+                }
+            }
+        }
+    }
+
+    func testWriteThroughputOneWriter() {
+        measureWrites(writers: 1)
+    }
+
+    func testWriteThroughputFourWriters() {
+        measureWrites(writers: 4)
+    }
+
+    func testWriteThroughputEightWriters() {
+        measureWrites(writers: 8)
+    }
+
+    /**
+     *  Ten changes of a key with 100 observers, made within one main run loop turn, enqueue one block on the main
+     *  queue and reach every observer once, with the latest value.
+     */
+    func testChangesWithinOneRunLoopTurnShareOneMainQueueBlock() {
+        let store = ObservableInMemoryKeyedStore()
+        let key = UnitTypeKey(index: 0, parameter: .Metric)
+        let observers = (0..<100).map { _ in NSObject() }
+        let delivered = expectation(description: "delivered")
+        delivered.expectedFulfillmentCount = observers.count
+        var received = [Int]()
+        for observer in observers {
+            store.add(observer: observer, for: key, broadcastAvailableValue: false) { updated, _, _ in
+                received.append(self.integer(updated))
+                delivered.fulfill()
+            }
+        }
+
+        let flushesBefore = store.broadcaster.scheduledFlushCount
+        let start = CACurrentMediaTime()
+        for i in 1...10 {
+            store.set(modelValue: ModelValue(integer: i), for: key)
+        }
+        wait(for: [delivered], timeout: 5)
+        let latency = CACurrentMediaTime() - start
+
+        XCTAssertEqual(store.broadcaster.scheduledFlushCount - flushesBefore, 1)
+        XCTAssertEqual(received, [Int](repeating: 10, count: observers.count))
+        print("100 observers: \(store.broadcaster.scheduledFlushCount - flushesBefore) main queue blocks, \(latency * 1000) ms to the last observer")
+        store.removeAllObservers()
+    }
+
+    /**
+     *  Time from a change to its delivery to the last of 100 observers.
+     */
+    func testDeliveryLatencyWithOneHundredObservers() {
+        let store = ObservableInMemoryKeyedStore()
+        let key = UnitTypeKey(index: 0, parameter: .Metric)
+        let observers = (0..<100).map { _ in NSObject() }
+        var delivered: XCTestExpectation?
+        for observer in observers {
+            store.add(observer: observer, for: key, broadcastAvailableValue: false) { _, _, _ in
+                delivered?.fulfill()
+            }
+        }
+
+        var value = 0
+        let flushesBefore = store.broadcaster.scheduledFlushCount
+        measure {
+            delivered = expectation(description: "delivered")
+            delivered?.expectedFulfillmentCount = observers.count
+            value += 1
+            store.set(modelValue: ModelValue(integer: value), for: key)
+            wait(for: [delivered!], timeout: 5)
+        }
+        XCTAssertEqual(store.broadcaster.scheduledFlushCount - flushesBefore, value)
+        store.removeAllObservers()
+    }
+
+    /**
+     *  Keys differing in parameter or index are distinct, also when the packed identifiers collide because an
+     *  index does not fit in 32 bits.
+     */
+    func testKeysCollidingInTheirIdentifierStayDistinct() {
+        let parameters: [Parameter] = [.PeakingThreshold, .DecoderStatus, .AFCEnabled, .SendWarningMessage, .Attitude, .Metric, .Imperial, .Unknown]
+        var keys = [ConcreteKey]()
+        for parameter in parameters {
+            for index in 0...64 {
+                keys.append(ConcreteKey(index: index, parameter: parameter))
+            }
+        }
+        let colliding = [ConcreteKey(index: 1 << 32, parameter: .PeakingThreshold), ConcreteKey(index: (1 << 32) + 5, parameter: .DecoderStatus)]
+        XCTAssertEqual(colliding[0].identifier, keys[0].identifier)
+        XCTAssertNotEqual(colliding[0], keys[0])
+        XCTAssertEqual(colliding[1].identifier, keys[65 + 5].identifier)
+        XCTAssertNotEqual(colliding[1], keys[65 + 5])
+        keys += colliding
+
+        let store = FlatStore()
+        for (i, key) in keys.enumerated() {
+            XCTAssertEqual(key, ConcreteKey(index: key.index, parameter: key.param))
+            store.update(modelValue: ModelValue(integer: i), for: key)
+        }
+        XCTAssertEqual(Set(keys).count, keys.count)
+        for (i, key) in keys.enumerated() {
+            XCTAssertEqual(integer(store.availableModelValueFor(key: key)), i)
+        }
+    }
+}
+
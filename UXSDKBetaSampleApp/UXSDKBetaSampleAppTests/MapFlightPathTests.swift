@@ -0,0 +1,190 @@
+//
+//  MapFlightPathTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import CoreLocation
+import UXSDKMap
+
+class MapFlightPathTests: XCTestCase {
+    
+    let origin = CLLocationCoordinate2D(latitude: 22.5431, longitude: 113.9589)
+    let earthRadius = 6371008.8
+    
+    func coordinate(east: Double, north: Double) -> CLLocationCoordinate2D {
+        let latitude = origin.latitude + north / earthRadius * 180 / .pi
+        let longitude = origin.longitude + east / (earthRadius * cos(origin.latitude * .pi / 180)) * 180 / .pi
+        return CLLocationCoordinate2D(latitude: latitude, longitude: longitude)
+    }
+    
+    func meters(_ coordinate: CLLocationCoordinate2D) -> (x: Double, y: Double) {
+        let x = (coordinate.longitude - origin.longitude) * .pi / 180 * earthRadius * cos(origin.latitude * .pi / 180)
+        let y = (coordinate.latitude - origin.latitude) * .pi / 180 * earthRadius
+        return (x, y)
+    }
+    
+    func distance(from point: CLLocationCoordinate2D, toSegment start: CLLocationCoordinate2D, _ end: CLLocationCoordinate2D) -> Double {
+        let p = meters(point), a = meters(start), b = meters(end)
+        let dx = b.x - a.x, dy = b.y - a.y
+        let lengthSquared = dx * dx + dy * dy
+        var t = lengthSquared > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared : 0
+        t = min(max(t, 0), 1)
+        return hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy))
+    }
+    
+    // Deterministic cross track wobble of up to 0.8 m, so the passes are not perfectly straight.
+    func wobble(_ i: Int) -> Double {
+        return 0.5 * sin(Double(i) * 0.7) + 0.3 * sin(Double(i) * 2.3)
+    }
+    
+    // Back and forth passes 30 m apart, sampled every 1.5 m.
+    func lawnmower(passes: Int, length: Double) -> [CLLocationCoordinate2D] {
+        var coordinates = [CLLocationCoordinate2D]()
+        let step = 1.5
+        for pass in 0..<passes {
+            let north = Double(pass) * 30
+            let steps = Int(length / step)
+            for i in 0...steps {
+                let along = Double(i) * step
+                coordinates.append(coordinate(east: pass % 2 == 0 ? along : length - along, north: north + wobble(coordinates.count)))
+            }
+            if pass < passes - 1 {
+                let east = pass % 2 == 0 ? length : 0
+                for i in 1..<20 {
+                    coordinates.append(coordinate(east: east + wobble(coordinates.count), north: north + Double(i) * step))
+                }
+            }
+        }
+        return coordinates
+    }
+    
+    // Laps of a 50 m circle that keep crossing the earlier ones, sampled every 1.5 m with a slow drift.
+    func orbit(laps: Int) -> [CLLocationCoordinate2D] {
+        let radius = 50.0
+        let stepsPerLap = Int(2 * .pi * radius / 1.5)
+        var coordinates = [CLLocationCoordinate2D]()
+        for i in 0..<(laps * stepsPerLap) {
+            let angle = Double(i) / Double(stepsPerLap) * 2 * .pi
+            let drift = Double(i) * 0.01
+            coordinates.append(coordinate(east: radius * cos(angle) + drift, north: radius * sin(angle)))
+        }
+        return coordinates
+    }
+    
+    func sameCoordinate(_ a: CLLocationCoordinate2D, _ b: CLLocationCoordinate2D) -> Bool {
+        return a.latitude == b.latitude && a.longitude == b.longitude
+    }
+    
+    // Retained points are a subsequence of the appended ones, so every appended point is measured against the
+    // retained segment that replaced it. Returns the largest such distance.
+    func largestError(of path: DUXBetaMapFlightPath, from coordinates: [CLLocationCoordinate2D]) -> Double {
+        var retained = [Int]()
+        var next = 0
+        for index in 0..<coordinates.count where next < Int(path.count) {
+            if sameCoordinate(coordinates[index], path.coordinate(at: UInt(next))) {
+                retained.append(index)
+                next += 1
+            }
+        }
+        XCTAssertEqual(retained.count, Int(path.count), "Retained points are not a subsequence of the appended ones")
+        XCTAssertEqual(retained.first, 0)
+        XCTAssertEqual(retained.last, coordinates.count - 1)
+        
+        var largest = 0.0
+        for (k, start) in retained.enumerated() where k + 1 < retained.count {
+            let end = retained[k + 1]
+            for index in start...end {
+                largest = max(largest, distance(from: coordinates[index], toSegment: coordinates[start], coordinates[end]))
+            }
+        }
+        return largest
+    }
+    
+    func checkErrorBound(_ coordinates: [CLLocationCoordinate2D], memoryLimit: UInt, file: StaticString = #file, line: UInt = #line) -> DUXBetaMapFlightPath {
+        let path = DUXBetaMapFlightPath(chunkSize: 256)
+        path.memoryLimit = memoryLimit
+        for coordinate in coordinates {
+            path.appendCoordinate(coordinate)
+        }
+        
+        XCTAssertEqual(Int(path.appendedCount), coordinates.count, file: file, line: line)
+        // The local projection differs slightly from the per-chunk one the path simplifies in.
+        let largest = largestError(of: path, from: coordinates)
+        XCTAssertLessThanOrEqual(largest, path.maximumError * 1.01 + 0.01, file: file, line: line)
+        XCTAssertLessThanOrEqual(path.maximumError, 2 * path.maximumTolerance + path.tolerance, file: file, line: line)
+        print("\(coordinates.count) appended, \(path.count) retained, largest error \(largest) m, bound \(path.maximumError) m")
+        return path
+    }
+    
+    func testLawnmowerStaysWithinToleranceWithoutMemoryPressure() {
+        let path = checkErrorBound(lawnmower(passes: 20, length: 500), memoryLimit: 0)
+        XCTAssertLessThanOrEqual(path.maximumError, path.tolerance)
+    }
+    
+    func testOrbitStaysWithinToleranceWithoutMemoryPressure() {
+        let path = checkErrorBound(orbit(laps: 20), memoryLimit: 0)
+        XCTAssertLessThanOrEqual(path.maximumError, path.tolerance)
+    }
+    
+    func unlimitedFootprint(_ coordinates: [CLLocationCoordinate2D]) -> UInt {
+        let path = DUXBetaMapFlightPath(chunkSize: 256)
+        path.memoryLimit = 0
+        for coordinate in coordinates {
+            path.appendCoordinate(coordinate)
+        }
+        return path.memoryFootprint
+    }
+    
+    func testLawnmowerStaysWithinBoundUnderMemoryPressure() {
+        let coordinates = lawnmower(passes: 20, length: 500)
+        let path = checkErrorBound(coordinates, memoryLimit: unlimitedFootprint(coordinates) / 2)
+        XCTAssertGreaterThan(path.maximumError, path.tolerance, "The memory limit should force a coarser pass")
+    }
+    
+    func testOrbitStaysWithinBoundUnderMemoryPressure() {
+        let coordinates = orbit(laps: 20)
+        let path = checkErrorBound(coordinates, memoryLimit: unlimitedFootprint(coordinates) / 2)
+        XCTAssertGreaterThan(path.maximumError, path.tolerance, "The memory limit should force a coarser pass")
+    }
+    
+    func testToleranceStopsAtMaximumWhenTheLimitCannotBeMet() {
+        let coordinates = orbit(laps: 40)
+        let path = checkErrorBound(coordinates, memoryLimit: 1024)
+        // Chunks keep their shape at the cap instead of collapsing to their end points.
+        XCTAssertGreaterThan(path.memoryFootprint, path.memoryLimit)
+        XCTAssertGreaterThan(Int(path.count), coordinates.count / 256 + 1)
+    }
+    
+    func testLowerMaximumToleranceTightensTheBound() {
+        let coordinates = lawnmower(passes: 20, length: 500)
+        let path = DUXBetaMapFlightPath(chunkSize: 256)
+        path.memoryLimit = 1024
+        path.maximumTolerance = 4
+        for coordinate in coordinates {
+            path.appendCoordinate(coordinate)
+        }
+        XCTAssertLessThanOrEqual(path.maximumError, 2 * 4 + path.tolerance)
+        XCTAssertLessThanOrEqual(largestError(of: path, from: coordinates), path.maximumError * 1.01 + 0.01)
+    }
+}
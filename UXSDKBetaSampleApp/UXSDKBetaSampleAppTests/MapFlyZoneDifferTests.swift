@@ -0,0 +1,178 @@
+//
+//  MapFlyZoneDifferTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import DJISDK
+import UXSDKMap
+import UXSDKMapBenchmarks
+
+class MapFlyZoneDifferTests: XCTestCase {
+    
+    typealias Overlay = DUXBetaMapFlyZoneCircleOverlay
+    
+    func overlays(radii: [String: Double]) -> [String: Overlay] {
+        var overlays = [String: Overlay]()
+        for (key, radius) in radii {
+            let overlay = Overlay(center: CLLocationCoordinate2D(latitude: 22.5, longitude: 113.9), radius: radius)
+            overlay.flyZoneType = .circle
+            overlay.noFlyZoneID = NSNumber(value: Int(key) ?? 0)
+            overlays[key] = overlay
+        }
+        return overlays
+    }
+    
+    func randomRadius() -> Double {
+        return 200.0 + floor(drand48() * 2000.0)
+    }
+    
+    func identities(_ objects: [Overlay]) -> Set<ObjectIdentifier> {
+        return Set(objects.map { ObjectIdentifier($0) })
+    }
+    
+    // Rebuilds every overlay on each refresh while a tenth of the zones leave, a tenth change and a tenth are new,
+    // and checks each diff against the keys that were actually touched.
+    func checkRefreshes(zones: Int, refreshes: Int, file: StaticString = #file, line: UInt = #line) {
+        srand48(2020)
+        var radii = [String: Double]()
+        var nextZone = 0
+        while nextZone < zones {
+            radii["\(nextZone)"] = randomRadius()
+            nextZone += 1
+        }
+        
+        let differ = DUXBetaMapFlyZoneDiffer<Overlay>()
+        let initial = differ.applyObjects(overlays(radii: radii))
+        XCTAssertEqual(Set(initial.addedObjects.keys), Set(radii.keys), file: file, line: line)
+        XCTAssertTrue(initial.removedObjects.isEmpty && initial.changedObjects.isEmpty, file: file, line: line)
+        
+        let churn = max(1, zones / 10)
+        for _ in 0..<refreshes {
+            var keys = Array(radii.keys)
+            var removed = Set<String>(), changed = Set<String>(), added = Set<String>()
+            for _ in 0..<churn where !keys.isEmpty {
+                let key = keys.remove(at: Int(drand48() * Double(keys.count)) % keys.count)
+                removed.insert(key)
+                radii.removeValue(forKey: key)
+            }
+            for _ in 0..<churn where !keys.isEmpty {
+                let key = keys.remove(at: Int(drand48() * Double(keys.count)) % keys.count)
+                changed.insert(key)
+                radii[key] = (radii[key] ?? 0) + 100.0
+            }
+            for _ in 0..<churn {
+                let key = "\(nextZone)"
+                nextZone += 1
+                added.insert(key)
+                radii[key] = randomRadius()
+            }
+            
+            let previous = differ.currentObjects
+            let rebuilt = overlays(radii: radii)
+            let diff = differ.applyObjects(rebuilt)
+            
+            XCTAssertEqual(Set(diff.addedObjects.keys), added, file: file, line: line)
+            XCTAssertEqual(Set(diff.removedObjects.keys), removed, file: file, line: line)
+            XCTAssertEqual(Set(diff.changedObjects.keys), changed, file: file, line: line)
+            XCTAssertEqual(Set(diff.replacedObjects.keys), changed, file: file, line: line)
+            XCTAssertFalse(diff.isEmpty, file: file, line: line)
+            
+            // What the map removes is what it held, what it adds is what was rebuilt.
+            let expectedDeleted = removed.union(changed).compactMap { previous[$0] }
+            let expectedInserted = added.union(changed).compactMap { rebuilt[$0] }
+            XCTAssertEqual(identities(diff.deletedObjects), identities(expectedDeleted), file: file, line: line)
+            XCTAssertEqual(identities(diff.insertedObjects), identities(expectedInserted), file: file, line: line)
+            
+            // Unchanged zones keep the object already on the map, the rest take the rebuilt one.
+            XCTAssertEqual(Set(differ.currentObjects.keys), Set(radii.keys), file: file, line: line)
+            for (key, radius) in radii {
+                guard let current = differ.currentObjects[key] else {
+                    XCTFail("Missing zone \(key)", file: file, line: line)
+                    continue
+                }
+                XCTAssertEqual(current.radius, radius, file: file, line: line)
+                let expected = changed.contains(key) || added.contains(key) ? rebuilt[key] : previous[key]
+                XCTAssertTrue(current === expected, "Zone \(key) holds the wrong object", file: file, line: line)
+            }
+        }
+    }
+    
+    func testTenZones() {
+        checkRefreshes(zones: 10, refreshes: 20)
+    }
+    
+    func testHundredZones() {
+        checkRefreshes(zones: 100, refreshes: 20)
+    }
+    
+    func testThousandZones() {
+        checkRefreshes(zones: 1000, refreshes: 20)
+    }
+    
+    func testTenThousandZones() {
+        checkRefreshes(zones: 10000, refreshes: 20)
+    }
+    
+    func testRebuiltIdenticalSetIsEmpty() {
+        srand48(2020)
+        var radii = [String: Double]()
+        for zone in 0..<500 {
+            radii["\(zone)"] = randomRadius()
+        }
+        let differ = DUXBetaMapFlyZoneDiffer<Overlay>()
+        differ.applyObjects(overlays(radii: radii))
+        let current = differ.currentObjects
+        
+        let diff = differ.applyObjects(overlays(radii: radii))
+        XCTAssertTrue(diff.isEmpty)
+        XCTAssertTrue(diff.insertedObjects.isEmpty && diff.deletedObjects.isEmpty)
+        for (key, object) in current {
+            XCTAssertTrue(differ.currentObjects[key] === object)
+        }
+    }
+    
+    func testDiffLeavesTheCurrentSetAlone() {
+        let differ = DUXBetaMapFlyZoneDiffer<Overlay>()
+        differ.applyObjects(overlays(radii: ["1": 500, "2": 600]))
+        let current = differ.currentObjects
+        
+        let diff = differ.diff(withObjects: overlays(radii: ["2": 700, "3": 800]))
+        XCTAssertEqual(Set(diff.addedObjects.keys), ["3"])
+        XCTAssertEqual(Set(diff.removedObjects.keys), ["1"])
+        XCTAssertEqual(Set(diff.changedObjects.keys), ["2"])
+        XCTAssertEqual(Set(differ.currentObjects.keys), Set(current.keys))
+        XCTAssertTrue(differ.currentObjects["2"] === current["2"])
+        
+        differ.removeAllObjects()
+        XCTAssertTrue(differ.currentObjects.isEmpty)
+    }
+    
+    func testDifferBenchmark() {
+        measure {
+            for result in DUXBetaMapFlyZoneDifferBenchmark.runScaling() {
+                print(result)
+            }
+        }
+    }
+}
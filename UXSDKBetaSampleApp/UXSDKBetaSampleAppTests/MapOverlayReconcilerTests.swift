@@ -0,0 +1,156 @@
+//
+//  MapOverlayReconcilerTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import MapKit
+import UXSDKMap
+import UXSDKMapBenchmarks
+
+class MapOverlayReconcilerTests: XCTestCase {
+    
+    var nextZone = 0
+    
+    func circle() -> MKCircle {
+        let center = CLLocationCoordinate2D(latitude: 22.0 + drand48(), longitude: 113.5 + drand48())
+        return MKCircle(center: center, radius: 200.0 + drand48() * 2000.0)
+    }
+    
+    func zones(_ count: Int) -> [String: MKOverlay] {
+        var zones = [String: MKOverlay]()
+        for _ in 0..<count {
+            zones["\(nextZone)"] = circle()
+            nextZone += 1
+        }
+        return zones
+    }
+    
+    func identities(_ overlays: [MKOverlay]) -> Set<ObjectIdentifier> {
+        return Set(overlays.map { ObjectIdentifier($0 as AnyObject) })
+    }
+    
+    func assertMap(_ mapView: MKMapView, reconciler: DUXBetaMapOverlayReconciler, shows desired: [String: MKOverlay],
+                   plus foreign: [MKOverlay] = [], file: StaticString = #file, line: UInt = #line) {
+        XCTAssertTrue(reconciler.mapViewMatchesDesiredOverlays(), file: file, line: line)
+        XCTAssertEqual(Set(reconciler.appliedOverlays.keys), Set(desired.keys), file: file, line: line)
+        XCTAssertEqual(mapView.overlays.count, desired.count + foreign.count, file: file, line: line)
+        XCTAssertEqual(identities(mapView.overlays), identities(Array(desired.values) + foreign), file: file, line: line)
+    }
+    
+    override func setUp() {
+        super.setUp()
+        srand48(2020)
+        nextZone = 0
+    }
+    
+    func testFinalMapSetEqualsDesiredSetUnderChurn() {
+        let mapView = MKMapView(frame: CGRect(x: 0, y: 0, width: 400, height: 400))
+        let reconciler = DUXBetaMapOverlayReconciler(mapView: mapView)
+        var desired = zones(1000)
+        reconciler.setDesiredOverlays(desired)
+        reconciler.applyPendingChanges()
+        assertMap(mapView, reconciler: reconciler, shows: desired)
+        
+        for refresh in 0..<100 {
+            // Replace, redraw under the same key and grow or shrink the set.
+            var keys = Array(desired.keys)
+            for _ in 0..<10 {
+                let index = Int(drand48() * Double(keys.count)) % keys.count
+                desired.removeValue(forKey: keys.remove(at: index))
+            }
+            desired.merge(zones(refresh % 2 == 0 ? 15 : 5)) { $1 }
+            desired[keys[0]] = circle()
+            
+            reconciler.setDesiredOverlays(desired)
+            reconciler.applyPendingChanges()
+            assertMap(mapView, reconciler: reconciler, shows: desired)
+        }
+        
+        reconciler.setDesiredOverlays([:])
+        reconciler.applyPendingChanges()
+        assertMap(mapView, reconciler: reconciler, shows: [:])
+    }
+    
+    func testOverlaysAddedOutsideTheReconcilerAreNotTouched() {
+        let mapView = MKMapView(frame: CGRect(x: 0, y: 0, width: 400, height: 400))
+        let reconciler = DUXBetaMapOverlayReconciler(mapView: mapView)
+        let coordinates = [CLLocationCoordinate2D(latitude: 22.5, longitude: 113.9),
+                           CLLocationCoordinate2D(latitude: 22.6, longitude: 114.0)]
+        let flightPath = MKPolyline(coordinates: coordinates, count: coordinates.count)
+        mapView.addOverlay(flightPath)
+        
+        var desired = zones(50)
+        reconciler.setDesiredOverlays(desired)
+        reconciler.applyPendingChanges()
+        assertMap(mapView, reconciler: reconciler, shows: desired, plus: [flightPath])
+        
+        desired = zones(20)
+        reconciler.setDesiredOverlays(desired)
+        reconciler.applyPendingChanges()
+        assertMap(mapView, reconciler: reconciler, shows: desired, plus: [flightPath])
+        
+        reconciler.setDesiredOverlays([:])
+        reconciler.applyPendingChanges()
+        assertMap(mapView, reconciler: reconciler, shows: [:], plus: [flightPath])
+    }
+    
+    func testOnlyTheLastSetHandedOverFromAnotherThreadIsApplied() {
+        let mapView = MKMapView(frame: CGRect(x: 0, y: 0, width: 400, height: 400))
+        let reconciler = DUXBetaMapOverlayReconciler(mapView: mapView)
+        let sets = (0..<10).map { _ in zones(100) }
+        
+        let handedOver = expectation(description: "Sets handed over")
+        DispatchQueue.global().async {
+            for set in sets {
+                reconciler.setDesiredOverlays(set)
+            }
+            handedOver.fulfill()
+        }
+        wait(for: [handedOver], timeout: 5)
+        
+        reconciler.applyPendingChanges()
+        assertMap(mapView, reconciler: reconciler, shows: sets[sets.count - 1])
+    }
+    
+    func testUnchangedSetDoesNotTouchTheMap() {
+        let mapView = MKMapView(frame: CGRect(x: 0, y: 0, width: 400, height: 400))
+        let reconciler = DUXBetaMapOverlayReconciler(mapView: mapView)
+        let desired = zones(200)
+        reconciler.setDesiredOverlays(desired)
+        reconciler.applyPendingChanges()
+        let touched = reconciler.overlaysTouched
+        
+        reconciler.setDesiredOverlays(desired)
+        reconciler.applyPendingChanges()
+        XCTAssertEqual(reconciler.overlaysTouched, touched)
+        assertMap(mapView, reconciler: reconciler, shows: desired)
+    }
+    
+    func testReconcilerBenchmark() {
+        measure {
+            let result = DUXBetaMapOverlayReconcilerBenchmark.runThousandZones()
+            print(result)
+        }
+    }
+}
@@ -0,0 +1,131 @@
+//
+//  MappingTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import UXSDKCore
+
+/**
+ *  A widget model sized like the real ones, mapped only by these tests.
+ */
+class MappingBenchmarkModel: NSObject {
+
+    @objc dynamic var isConnected: Bool = false
+    @objc dynamic var batteryPercentage: Int = 0
+    @objc dynamic var voltage: Double = 0
+    @objc dynamic var displayName: NSString?
+    @objc dynamic var level: NSNumber?
+}
+
+/**
+ *  Same shape as MappingBenchmarkModel, kept separate so its first mapping is always a cache miss.
+ */
+class MappingColdModel: NSObject {
+
+    @objc dynamic var isConnected: Bool = false
+    @objc dynamic var batteryPercentage: Int = 0
+    @objc dynamic var voltage: Double = 0
+    @objc dynamic var displayName: NSString?
+    @objc dynamic var level: NSNumber?
+}
+
+class MappingTests: XCTestCase {
+
+    let instanceCount = 500
+
+    func testMappingSetsEveryPropertyType() {
+        let model = MappingBenchmarkModel()
+        bind(model)
+
+        XCTAssertTrue(model.isConnected)
+        XCTAssertEqual(model.batteryPercentage, 87)
+        XCTAssertEqual(model.voltage, 15.2, accuracy: 0.001)
+        XCTAssertEqual(model.displayName, "Battery")
+        XCTAssertEqual(model.level, NSNumber(value: 3))
+    }
+
+    func testMappingIsObservedThroughKVO() {
+        let model = MappingBenchmarkModel()
+        var observed: [String] = []
+        let observation = model.observe(\.batteryPercentage, options: [.new]) { (_, change) in
+            observed.append("\(change.newValue ?? -1)")
+        }
+        model.duxbeta_setCustomMappingValue(NSNumber(value: 42), forKey: "batteryPercentage")
+        observation.invalidate()
+
+        XCTAssertEqual(observed, ["42"])
+    }
+
+    /**
+     *  Binds 500 instances of one class and reports the cost of the first, reflecting, binding against the cached
+     *  ones, in time and in heap blocks left behind.
+     */
+    func testBindingFiveHundredInstancesReflectsOnce() {
+        var coldTime: TimeInterval = 0
+        var warmTime: TimeInterval = 0
+        let blocksBefore = heapBlocksInUse()
+        autoreleasepool {
+            let models = (0..<instanceCount).map { _ in MappingColdModel() }
+            var start = Date()
+            bind(models[0])
+            coldTime = Date().timeIntervalSince(start)
+
+            start = Date()
+            for model in models.dropFirst() {
+                bind(model)
+            }
+            warmTime = Date().timeIntervalSince(start) / Double(instanceCount - 1)
+        }
+        let blocksAfter = heapBlocksInUse()
+        let leakedBlocks = blocksAfter > blocksBefore ? blocksAfter - blocksBefore : 0
+
+        print("Mapping: first instance \(coldTime * 1e6) us, cached instance \(warmTime * 1e6) us, \(leakedBlocks) heap blocks kept for \(instanceCount) instances")
+        // A per instance cache, or a leaked attribute list per lookup, keeps at least one block per instance.
+        XCTAssertLessThan(leakedBlocks, instanceCount / 2)
+    }
+
+    func testBindingPerformance() {
+        let models = (0..<instanceCount).map { _ in MappingBenchmarkModel() }
+        bind(models[0])
+        measure {
+            for model in models {
+                bind(model)
+            }
+        }
+    }
+
+    func bind(_ model: NSObject) {
+        model.duxbeta_setCustomMappingValue(NSNumber(value: true), forKey: "isConnected")
+        model.duxbeta_setCustomMappingValue(NSNumber(value: 87), forKey: "batteryPercentage")
+        model.duxbeta_setCustomMappingValue(NSNumber(value: 15.2), forKey: "voltage")
+        model.duxbeta_setCustomMappingValue("Battery", forKey: "displayName")
+        model.duxbeta_setCustomMappingValue(NSNumber(value: 3), forKey: "level")
+    }
+
+    func heapBlocksInUse() -> Int {
+        var statistics = malloc_statistics_t()
+        malloc_zone_statistics(nil, &statistics)
+        return Int(statistics.blocks_in_use)
+    }
+}
@@ -0,0 +1,143 @@
+//
+//  RKVOExtensionTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import UXSDKCore
+
+/**
+ *  A model bound to itself, the way widget models bind their properties to their state recompute.
+ */
+class RKVOBindingModel: NSObject {
+
+    @objc dynamic var value: NSNumber?
+    var updateCount = 0
+    var transforms: [DUXBetaRKVOTransform] = []
+
+    @objc func update() {
+        updateCount += 1
+    }
+
+    @objc func update(with transform: DUXBetaRKVOTransform) {
+        updateCount += 1
+        if transforms.count < 2 {
+            transforms.append(transform)
+        }
+    }
+}
+
+class RKVOExtensionTests: XCTestCase {
+
+    let changeCount = 100_000
+
+    /**
+     *  Values are reused so the changes themselves do not allocate, only the binding is measured.
+     */
+    lazy var values: [NSNumber] = (0..<64).map { NSNumber(value: Double($0) + 0.5) }
+
+    func testSelectorWithoutParameterIsCalledForEveryChange() {
+        let model = RKVOBindingModel()
+        model.duxbeta_bindRKVO(withTarget: model, selector: #selector(RKVOBindingModel.update), property: "value")
+        XCTAssertEqual(model.updateCount, 1)
+
+        for i in 0..<100 {
+            model.value = values[i % values.count]
+        }
+        XCTAssertEqual(model.updateCount, 101)
+        model.duxbeta_unBindRKVO()
+    }
+
+    func testKeptTransformsAreNotReused() {
+        let model = RKVOBindingModel()
+        model.value = values[0]
+        model.duxbeta_bindRKVO(withTarget: model, selector: #selector(RKVOBindingModel.update(with:)), property: "value")
+        model.value = values[1]
+
+        XCTAssertEqual(model.transforms.count, 2)
+        XCTAssertFalse(model.transforms[0] === model.transforms[1])
+        XCTAssertEqual(model.transforms[0].updatedValue as? NSNumber, values[0])
+        XCTAssertEqual(model.transforms[1].keyPath, "value")
+        XCTAssertEqual(model.transforms[1].oldValue as? NSNumber, values[0])
+        XCTAssertEqual(model.transforms[1].updatedValue as? NSNumber, values[1])
+        model.duxbeta_unBindRKVO()
+    }
+
+    /**
+     *  Fires 100,000 changes through a bound selector. Once warmed up the binding must not keep anything alive per
+     *  change, the heap holds the same number of blocks before and after.
+     */
+    func testSteadyStateKeepsNoAllocations() {
+        let model = RKVOBindingModel()
+        model.duxbeta_bindRKVO(withTarget: model, selector: #selector(RKVOBindingModel.update), property: "value")
+        fireChanges(on: model, count: 1_000)
+
+        let blocksBefore = heapBlocksInUse()
+        fireChanges(on: model, count: changeCount)
+        let blocksAfter = heapBlocksInUse()
+        let grownBlocks = blocksAfter > blocksBefore ? blocksAfter - blocksBefore : 0
+
+        print("RKVO binding: \(changeCount) changes, \(grownBlocks) heap blocks kept")
+        XCTAssertEqual(model.updateCount, 1 + 1_000 + changeCount)
+        XCTAssertLessThan(grownBlocks, 100)
+        model.duxbeta_unBindRKVO()
+    }
+
+    func testSteadyStateWithTransformKeepsNoAllocations() {
+        let model = RKVOBindingModel()
+        model.duxbeta_bindRKVO(withTarget: model, selector: #selector(RKVOBindingModel.update(with:)), property: "value")
+        fireChanges(on: model, count: 1_000)
+
+        let blocksBefore = heapBlocksInUse()
+        fireChanges(on: model, count: changeCount)
+        let blocksAfter = heapBlocksInUse()
+        let grownBlocks = blocksAfter > blocksBefore ? blocksAfter - blocksBefore : 0
+
+        print("RKVO binding with transform: \(changeCount) changes, \(grownBlocks) heap blocks kept")
+        XCTAssertLessThan(grownBlocks, 100)
+        model.duxbeta_unBindRKVO()
+    }
+
+    func testBoundSelectorPerformance() {
+        let model = RKVOBindingModel()
+        model.duxbeta_bindRKVO(withTarget: model, selector: #selector(RKVOBindingModel.update), property: "value")
+        measure {
+            fireChanges(on: model, count: changeCount)
+        }
+        model.duxbeta_unBindRKVO()
+    }
+
+    func fireChanges(on model: RKVOBindingModel, count: Int) {
+        autoreleasepool {
+            for i in 0..<count {
+                model.value = values[i % values.count]
+            }
+        }
+    }
+
+    func heapBlocksInUse() -> Int {
+        var statistics = malloc_statistics_t()
+        malloc_zone_statistics(nil, &statistics)
+        return Int(statistics.blocks_in_use)
+    }
+}
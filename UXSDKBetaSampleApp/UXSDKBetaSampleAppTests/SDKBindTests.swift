@@ -0,0 +1,136 @@
+//
+//  SDKBindTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import DJISDK
+import UXSDKCore
+import UXSDKCoreBenchmarks
+
+class SDKBindTestModel: NSObject {
+
+    @objc dynamic var level: NSNumber?
+}
+
+class SDKBindTests: XCTestCase {
+
+    let modelCount = 40
+    let readLatency: TimeInterval = 0.002
+    let levelKey = DJIBatteryKey(index: 0, andParam: DJIBatteryParamChargeRemainingInPercent)!
+
+    var handler: DUXBetaInMemoryKeyHandler!
+    var previousHandler: DUXBetaKeyInterfaces?
+    var previousMode: DUXBetaSDKBindMode = .synchronous
+
+    override func setUp() {
+        super.setUp()
+        let adapter = DUXBetaKeyInterfaceAdapter.sharedInstance()
+        previousHandler = adapter.getHandler()
+        previousMode = NSObject.duxbeta_defaultSDKBindMode()
+        handler = DUXBetaInMemoryKeyHandler()
+        handler.updateValue(NSNumber(value: true), for: DJIFlightControllerKey(param: DJIParamConnection)!)
+        adapter.setHandler(handler)
+    }
+
+    override func tearDown() {
+        NSObject.duxbeta_setDefaultSDKBindMode(previousMode)
+        DUXBetaKeyInterfaceAdapter.sharedInstance().setHandler(previousHandler)
+        super.tearDown()
+    }
+
+    /**
+     *  Sets up 40 battery widget models against a key handler taking 2 ms per read, in both bind modes.
+     */
+    func testStartupWithSlowReads() {
+        handler.readLatency = readLatency
+        let synchronous = setUpModels(mode: .synchronous)
+        let asynchronous = setUpModels(mode: .asynchronous)
+
+        print("SDKBind startup, \(modelCount) models: synchronous \(synchronous * 1e3) ms, asynchronous \(asynchronous * 1e3) ms")
+        XCTAssertLessThan(asynchronous, synchronous / 4)
+    }
+
+    func testAsynchronousStartupPerformance() {
+        handler.readLatency = readLatency
+        measure {
+            _ = setUpModels(mode: .asynchronous)
+        }
+    }
+
+    func testAsynchronousBindFillsInitialValue() {
+        handler.updateValue(NSNumber(value: 42), for: levelKey)
+        let model = SDKBindTestModel()
+        model.duxbeta_bindSDKKey(levelKey, propertyName: "level", mode: .asynchronous)
+
+        waitUntil { model.level != nil }
+        XCTAssertEqual(model.level, NSNumber(value: 42))
+        XCTAssertTrue(model.duxbeta_checkSDKBindPropertyIsValid("level"))
+        model.duxbeta_unBindSDK()
+    }
+
+    /**
+     *  Pushes a newer value while the initial read is in flight, at a different point of the read each round. The
+     *  pushed value must win every time.
+     */
+    func testPushDuringInitialReadIsNeverOverwritten() {
+        handler.readLatency = 0.001
+        for round in 0..<200 {
+            handler.updateValue(NSNumber(value: -1), for: levelKey)
+            let model = SDKBindTestModel()
+            model.duxbeta_bindSDKKey(levelKey, propertyName: "level", mode: .asynchronous)
+            usleep(useconds_t(round * 10))
+            handler.updateValue(NSNumber(value: round), for: levelKey)
+
+            // Long enough for the read to be delivered, if it was not dropped.
+            usleep(5_000)
+            XCTAssertEqual(model.level, NSNumber(value: round), "round \(round)")
+            model.duxbeta_unBindSDK()
+        }
+    }
+
+    func setUpModels(mode: DUXBetaSDKBindMode) -> TimeInterval {
+        NSObject.duxbeta_setDefaultSDKBindMode(mode)
+        let start = Date()
+        let models = (0..<modelCount).map { _ -> DUXBetaBatteryWidgetModel in
+            let model = DUXBetaBatteryWidgetModel()
+            model.setup()
+            return model
+        }
+        let elapsed = Date().timeIntervalSince(start)
+
+        waitUntil { models.allSatisfy { $0.isProductConnected } }
+        for model in models {
+            model.cleanup()
+        }
+        return elapsed
+    }
+
+    func waitUntil(_ condition: @escaping () -> Bool) {
+        let deadline = Date(timeIntervalSinceNow: 5)
+        while !condition() && Date() < deadline {
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.001))
+        }
+        XCTAssertTrue(condition())
+    }
+}
@@ -0,0 +1,138 @@
+//
+//  StateChangeBaseDataTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import UXSDKCore
+
+class StateChangeBaseDataTests: XCTestCase {
+
+    // Keys bridged from NSString pass back to Objective-C without a copy, like the constants the widgets use.
+    let keys = (0..<30).map { NSString(string: "widgetHook\($0)") as String }
+
+    func testAccessors() {
+        let integer = DUXBetaStateChangeBaseData(key: keys[0], integer: 42)
+        XCTAssertEqual(integer.key(), keys[0])
+        XCTAssertEqual(integer.number(), NSNumber(value: 42))
+        XCTAssertEqual(integer.longLongValue(), 42)
+        XCTAssertEqual(integer.doubleValue(), 42)
+
+        let real = DUXBetaStateChangeBaseData(key: keys[0], doubleValue: 0.5)
+        XCTAssertEqual(real.number(), NSNumber(value: 0.5))
+        XCTAssertEqual(real.doubleValue(), 0.5)
+
+        let string = DUXBetaStateChangeBaseData(key: keys[0], string: "text")
+        XCTAssertEqual(string.string(), "text")
+        XCTAssertEqual(string.longLongValue(), 0)
+
+        XCTAssertEqual(DUXBetaStateChangeBaseData(key: keys[0]).number(), NSNumber(value: true))
+    }
+
+    /**
+     *  A scalar event is a single allocation, the size of the object itself.
+     */
+    func testScalarEventsAreOneAllocation() {
+        let count = 10_000
+        var events = [DUXBetaStateChangeBaseData]()
+        events.reserveCapacity(count)
+        let before = heapStatistics()
+        for i in 0..<count {
+            events.append(DUXBetaStateChangeBaseData(key: keys[i % keys.count], integer: Int64(i)))
+        }
+        let after = heapStatistics()
+
+        XCTAssertLessThanOrEqual(Int(after.blocks_in_use) - Int(before.blocks_in_use), count + 10)
+        XCTAssertLessThanOrEqual((after.size_in_use - before.size_in_use) / count, malloc_size(Unmanaged.passUnretained(events[0]).toOpaque()) + 16)
+    }
+
+    /**
+     *  One second of hook events at 60 Hz from 30 widget types, sent through a broadcaster to a listener. The
+     *  listener holds the delivery queue until all of them were sent, so the heap then holds everything
+     *  construction and delivery allocated for that second.
+     */
+    func testOneSecondAtSixtyHertzAcrossThirtyTypes() {
+        let broadcaster = DUXBetaStateChangeBroadcaster()
+        let listener = NSObject()
+        let release = DispatchSemaphore(value: 0)
+        let delivered = expectation(description: "delivered")
+        let eventCount = 60 * keys.count
+        var deliveredCount = 0
+        broadcaster.registerListener(listener, analyticsClass: DUXBetaStateChangeBaseData.self) { _ in
+            if deliveredCount == 0 {
+                release.wait()
+            }
+            deliveredCount += 1
+            if deliveredCount == eventCount {
+                delivered.fulfill()
+            }
+        }
+
+        let before = heapStatistics()
+        for frame in 0..<60 {
+            for key in keys {
+                broadcaster.send(DUXBetaStateChangeBaseData(key: key, integer: Int64(frame)))
+            }
+        }
+        let after = heapStatistics()
+        release.signal()
+        wait(for: [delivered], timeout: 30)
+        broadcaster.unregisterListener(listener)
+
+        let bytesPerSecond = after.size_in_use > before.size_in_use ? after.size_in_use - before.size_in_use : 0
+        print("state change events: \(eventCount) per second, \(bytesPerSecond) bytes allocated per second")
+        XCTAssertLessThan(bytesPerSecond / eventCount, 512)
+    }
+
+    func testConstructionAndDeliveryPerformance() {
+        let broadcaster = DUXBetaStateChangeBroadcaster()
+        let listener = NSObject()
+        var delivered: XCTestExpectation?
+        var deliveredCount = 0
+        let eventCount = 60 * keys.count * 10
+        broadcaster.registerListener(listener, analyticsClass: DUXBetaStateChangeBaseData.self) { data in
+            deliveredCount += Int(data.longLongValue() >= 0)
+            if deliveredCount == eventCount {
+                deliveredCount = 0
+                delivered?.fulfill()
+            }
+        }
+
+        measure {
+            delivered = expectation(description: "delivered")
+            for frame in 0..<(60 * 10) {
+                for key in keys {
+                    broadcaster.send(DUXBetaStateChangeBaseData(key: key, integer: Int64(frame)))
+                }
+            }
+            wait(for: [delivered!], timeout: 30)
+        }
+        broadcaster.unregisterListener(listener)
+    }
+
+    func heapStatistics() -> malloc_statistics_t {
+        var statistics = malloc_statistics_t()
+        malloc_zone_statistics(nil, &statistics)
+        return statistics
+    }
+}
@@ -0,0 +1,148 @@
+//
+//  StateChangeBroadcasterTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import UXSDKCore
+
+class BroadcastData: DUXBetaStateChangeBaseData {}
+class OtherBroadcastData: DUXBetaStateChangeBaseData {}
+class FlushBroadcastData: DUXBetaStateChangeBaseData {}
+
+class StateChangeBroadcasterTests: XCTestCase {
+
+    let unloadedClassName = "UXSDKBetaSampleAppTests.NeverLoadedBroadcastData"
+
+    var broadcaster: DUXBetaStateChangeBroadcaster!
+    let flushListener = NSObject()
+    var flushed: XCTestExpectation?
+
+    override func setUp() {
+        super.setUp()
+        broadcaster = DUXBetaStateChangeBroadcaster()
+        broadcaster.registerListener(flushListener, analyticsClass: FlushBroadcastData.self) { [unowned self] _ in
+            self.flushed?.fulfill()
+        }
+    }
+
+    /**
+     *  Waits until everything sent so far was delivered, the delivery queue is serial.
+     */
+    func flush() {
+        flushed = expectation(description: "flush")
+        broadcaster.send(FlushBroadcastData(key: "flush"))
+        wait(for: [flushed!], timeout: 30)
+        flushed = nil
+    }
+
+    func testNamesRegisteredBeforeTheirClassDoNotHideOtherClasses() {
+        let lock = NSLock()
+        var received = 0
+        let listener = NSObject()
+        broadcaster.registerListener(listener, analyticsClassName: unloadedClassName) { _ in }
+        broadcaster.registerListener(listener, analyticsClass: BroadcastData.self) { _ in
+            lock.lock()
+            received += 1
+            lock.unlock()
+        }
+
+        for i in 0..<100 {
+            broadcaster.send(BroadcastData(key: "level", integer: Int64(i)))
+            broadcaster.send(OtherBroadcastData(key: "level", integer: Int64(i)))
+        }
+        // Parking another name makes every class be checked against the parked names again.
+        broadcaster.registerListener(listener, analyticsClassName: unloadedClassName + "2") { _ in }
+        broadcaster.send(BroadcastData(key: "level", integer: 100))
+        flush()
+
+        lock.lock()
+        XCTAssertEqual(received, 101)
+        lock.unlock()
+        broadcaster.unregisterListener(listener)
+    }
+
+    /**
+     *  Listeners come and go from several threads while others send. A listener registered for the whole run
+     *  gets every send exactly once.
+     */
+    func testConcurrentRegisterUnregisterAndSend() {
+        let lock = NSLock()
+        var received = 0
+        let stableListener = NSObject()
+        broadcaster.registerListener(stableListener, analyticsClass: BroadcastData.self) { _ in
+            lock.lock()
+            received += 1
+            lock.unlock()
+        }
+
+        let threads = 8
+        let sendsPerThread = 10_000
+        DispatchQueue.concurrentPerform(iterations: threads) { thread in
+            for i in 0..<sendsPerThread {
+                if thread % 2 == 0 {
+                    broadcaster.send(BroadcastData(key: "level", integer: Int64(i)))
+                } else {
+                    let listener = NSObject()
+                    broadcaster.registerListener(listener, analyticsClass: BroadcastData.self) { _ in }
+                    broadcaster.registerListener(listener, analyticsClassName: "\(unloadedClassName)\(i % 16)") { _ in }
+                    broadcaster.setMinimumInterval(0, for: OtherBroadcastData.self)
+                    if i % 2 == 0 {
+                        broadcaster.unregisterListener(listener)
+                    } else {
+                        broadcaster.unregisterListener(listener, for: BroadcastData.self)
+                        broadcaster.unregisterListener(listener, forClassName: "\(unloadedClassName)\(i % 16)")
+                    }
+                }
+            }
+        }
+        flush()
+
+        lock.lock()
+        XCTAssertEqual(received, threads / 2 * sendsPerThread)
+        lock.unlock()
+        broadcaster.unregisterListener(stableListener)
+    }
+
+    /**
+     *  100,000 sends delivered to 20 handlers, with a name parked so every send takes the lookup path.
+     */
+    func testSendPerformance() {
+        let listeners = (0..<20).map { _ in NSObject() }
+        for listener in listeners {
+            broadcaster.registerListener(listener, analyticsClass: BroadcastData.self) { _ in }
+        }
+        broadcaster.registerListener(listeners[0], analyticsClassName: unloadedClassName) { _ in }
+        let data = BroadcastData(key: "level", integer: 1)
+
+        measure {
+            for _ in 0..<100_000 {
+                broadcaster.send(data)
+            }
+            flush()
+        }
+        for listener in listeners {
+            broadcaster.unregisterListener(listener)
+        }
+    }
+}
@@ -0,0 +1,225 @@
+//
+//  TelemetryLogTests.swift
+//  UXSDKSampleAppTests
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+import XCTest
+import CoreLocation
+import DJISDK
+import UXSDKCore
+import UXSDKCoreBenchmarks
+
+class TelemetryLogTests: XCTestCase {
+
+    let keys = [DJIFlightControllerKey(param: DJIParamConnection)!,
+                DJIBatteryKey(index: 0, andParam: DJIBatteryParamChargeRemainingInPercent)!,
+                DJIBatteryKey(index: 1, andParam: DJIBatteryParamChargeRemainingInPercent)!,
+                DJIBatteryKey(index: 0, andParam: DJIBatteryParamCellVoltages)!,
+                DJIFlightControllerKey(param: DJIFlightControllerParamAircraftLocation)!]
+
+    /**
+     *  The value of the nth update of a key, the last two keys take the archived path.
+     */
+    func value(forKeyAt keyIndex: Int, sequence: Int) -> NSObject {
+        switch keyIndex {
+        case 3:
+            return [NSNumber(value: sequence), NSNumber(value: sequence + 1)] as NSArray
+        case 4:
+            return ["latitude": NSNumber(value: sequence % 90), "sequence": NSNumber(value: sequence)] as NSDictionary
+        default:
+            return NSNumber(value: sequence)
+        }
+    }
+
+    func log(eventCount: Int) -> Data {
+        let writer = DUXBetaTelemetryLogWriter()
+        for i in 0..<eventCount {
+            writer.appendValue(value(forKeyAt: i % keys.count, sequence: i / keys.count), for: keys[i % keys.count], timestamp: UInt64(i) * 1_000_000)
+        }
+        return writer.data()
+    }
+
+    func testValuesRoundTrip() throws {
+        let writer = DUXBetaTelemetryLogWriter()
+        let values: [NSObject?] = [NSNumber(value: 42), NSNumber(value: 0.5), "text" as NSString, Data([1, 2, 3]) as NSData,
+                                   ["a": NSNumber(value: 1)] as NSDictionary, [NSNumber(value: 1), "b" as NSString] as NSArray,
+                                   NSValue(range: NSRange(location: 1, length: 2)), Date(timeIntervalSince1970: 1) as NSDate, nil]
+        for value in values {
+            writer.appendValue(value, for: keys[1])
+        }
+
+        let reader = try DUXBetaTelemetryLogReader(data: writer.data())
+        var timestamp: UInt64 = 0
+        var key: DJIKey?
+        var value: AnyObject?
+        for expected in values {
+            try reader.readEvent(withTimestamp: &timestamp, key: &key, value: &value)
+            XCTAssertEqual(key, keys[1])
+            XCTAssertEqual(value as? NSObject, expected)
+        }
+        XCTAssertThrowsError(try reader.readEvent(withTimestamp: &timestamp, key: &key, value: &value))
+    }
+
+    func testLocationsRoundTrip() throws {
+        let writer = DUXBetaTelemetryLogWriter()
+        writer.appendValue(CLLocation(latitude: 22.5, longitude: 113.9), for: keys[4])
+
+        let reader = try DUXBetaTelemetryLogReader(data: writer.data())
+        var timestamp: UInt64 = 0
+        var key: DJIKey?
+        var value: AnyObject?
+        try reader.readEvent(withTimestamp: &timestamp, key: &key, value: &value)
+        let location = value as? CLLocation
+        XCTAssertEqual(location?.coordinate.latitude, 22.5)
+        XCTAssertEqual(location?.coordinate.longitude, 113.9)
+    }
+
+    func testValuesOutsideTheAllowListAreNotArchived() throws {
+        let writer = DUXBetaTelemetryLogWriter()
+        writer.appendValue(NSURL(string: "https://www.dji.com"), for: keys[1])
+
+        let reader = try DUXBetaTelemetryLogReader(data: writer.data())
+        var timestamp: UInt64 = 0
+        var key: DJIKey?
+        var value: AnyObject? = NSNull()
+        try reader.readEvent(withTimestamp: &timestamp, key: &key, value: &value)
+        XCTAssertNil(value)
+    }
+
+    /**
+     *  A log handcrafted to hold an archived NSURL is read as corrupted, the class is never instantiated.
+     */
+    func testArchivesOutsideTheAllowListAreRejected() throws {
+        let archive = try NSKeyedArchiver.archivedData(withRootObject: NSURL(string: "https://www.dji.com")!, requiringSecureCoding: true)
+        var bytes = Data("DUXT".utf8)
+        bytes.append(1)
+        bytes.append(1)
+        appendString(NSStringFromClass(DJIBatteryKey.self), to: &bytes)
+        appendString(DJIBatteryParamChargeRemainingInPercent, to: &bytes)
+        bytes.append(0)
+        appendString("", to: &bytes)
+        bytes.append(0)
+        bytes.append(2)
+        bytes.append(0)
+        bytes.append(0)
+        bytes.append(5)
+        appendVarint(UInt64(archive.count), to: &bytes)
+        bytes.append(archive)
+
+        let reader = try DUXBetaTelemetryLogReader(data: bytes)
+        var timestamp: UInt64 = 0
+        var key: DJIKey?
+        var value: AnyObject?
+        XCTAssertThrowsError(try reader.readEvent(withTimestamp: &timestamp, key: &key, value: &value)) { error in
+            XCTAssertEqual((error as NSError).domain, DUXBetaTelemetryLogErrorDomain)
+            XCTAssertEqual((error as NSError).code, DUXBetaTelemetryLogError.corrupted.rawValue)
+        }
+        XCTAssertNil(value)
+    }
+
+    /**
+     *  Every key sees every logged value exactly once and in the logged order when a million events are replayed
+     *  at unlimited speed.
+     */
+    func testOneMillionEventReplayKeepsTheOrderPerKey() throws {
+        let eventCount = 1_000_000
+        let handler = try DUXBetaTelemetryReplayKeyHandler(log: log(eventCount: eventCount))
+        handler.callbackQueue = DispatchQueue(label: "com.dji.uxsdk.telemetryLogTests")
+
+        // Listeners are only called on the serial callback queue, the counters need no lock.
+        let listener = NSObject()
+        var positions = [Int](repeating: 0, count: keys.count)
+        var outOfOrder = 0
+        for (keyIndex, key) in keys.enumerated() {
+            handler.startListeningForChanges(on: key, withListener: listener) { _, newValue in
+                if newValue?.value as? NSObject != self.value(forKeyAt: keyIndex, sequence: positions[keyIndex]) {
+                    outOfOrder += 1
+                }
+                positions[keyIndex] += 1
+            }
+        }
+
+        let finished = expectation(description: "replay")
+        var report: DUXBetaTelemetryReplayReport?
+        handler.replay(atSpeed: DUXBetaTelemetryReplaySpeedUnlimited) { result in
+            report = result
+            finished.fulfill()
+        }
+        wait(for: [finished], timeout: 300)
+        handler.stopAllListening(ofListeners: listener)
+
+        XCTAssertEqual(report?.eventCount, UInt(eventCount))
+        XCTAssertNil(report?.error)
+        XCTAssertEqual(outOfOrder, 0)
+        for (keyIndex, position) in positions.enumerated() {
+            XCTAssertEqual(position, (eventCount - keyIndex + keys.count - 1) / keys.count)
+        }
+    }
+
+    /**
+     *  The recorder logs every pushed update once, however many listeners the key has.
+     */
+    func testRecordingLogsEveryUpdateOnce() throws {
+        let source = DUXBetaInMemoryKeyHandler()
+        let recorder = DUXBetaTelemetryRecordingKeyHandler(handler: source)
+        let listeners = [NSObject(), NSObject(), NSObject()]
+        for listener in listeners {
+            for key in keys {
+                recorder.startListeningForChanges(on: key, withListener: listener) { _, _ in }
+            }
+        }
+        let eventCount = 10_000
+        for i in 0..<eventCount {
+            source.updateValue(value(forKeyAt: i % keys.count, sequence: i / keys.count), for: keys[i % keys.count])
+        }
+        for listener in listeners {
+            recorder.stopAllListening(ofListeners: listener)
+        }
+
+        let reader = try DUXBetaTelemetryLogReader(data: recorder.recordedLog())
+        var timestamp: UInt64 = 0
+        var key: DJIKey?
+        var value: AnyObject?
+        for i in 0..<eventCount {
+            try reader.readEvent(withTimestamp: &timestamp, key: &key, value: &value)
+            XCTAssertEqual(key, keys[i % keys.count])
+            XCTAssertEqual(value as? NSObject, self.value(forKeyAt: i % keys.count, sequence: i / keys.count))
+        }
+        XCTAssertThrowsError(try reader.readEvent(withTimestamp: &timestamp, key: &key, value: &value))
+    }
+
+    func appendVarint(_ value: UInt64, to bytes: inout Data) {
+        var value = value
+        repeat {
+            let byte = UInt8(value & 0x7f)
+            value >>= 7
+            bytes.append(value != 0 ? byte | 0x80 : byte)
+        } while value != 0
+    }
+
+    func appendString(_ string: String, to bytes: inout Data) {
+        let utf8 = Data(string.utf8)
+        appendVarint(UInt64(utf8.count), to: &bytes)
+        bytes.append(utf8)
+    }
+}
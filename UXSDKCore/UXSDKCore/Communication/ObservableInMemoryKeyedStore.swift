@@ -28,7 +28,7 @@
 import Foundation
 import Dispatch
 
-enum Parameter: Hashable {
+enum Parameter: Int, Hashable {
     case PeakingThreshold, DecoderStatus, AFCEnabled, SendWarningMessage, Attitude, Metric, Imperial, Unknown
     
     public init(videoParameter:VideoParameter) {
@@ -135,23 +135,24 @@ protocol Key: Hashable {
     var index: Int {get set}
 }
 
-class ConcreteKey: Key {
+// ConcreteKey is a value type, building or comparing one never allocates. The parameter and the index are packed
+// into one integer for hashing, equality compares both fields so keys whose packed values collide stay distinct.
+struct ConcreteKey: Key {
     init(index:Int, parameter:Parameter) {
         self.param = parameter
         self.index = index
     }
     
-    func hash(into hasher: inout Hasher) {
-        hasher.combine(self.param)
-        hasher.combine(self.index)
+    var identifier: Int {
+        return (self.param.rawValue << 32) | (self.index & 0xFFFFFFFF)
     }
     
-    var hashValue: Int {
-        return (self.param.hashValue ^ self.index.hashValue)
+    func hash(into hasher: inout Hasher) {
+        hasher.combine(self.identifier)
     }
     
     public static func == (lhs: ConcreteKey, rhs: ConcreteKey) -> Bool {
-        return lhs.index == rhs.index && lhs.param == rhs.param
+        return lhs.param == rhs.param && lhs.index == rhs.index
     }
     
     var param: Parameter
@@ -164,11 +165,7 @@ enum Type {
 
 // ExternalKey bridges to the Key / ConcreteKey types that cannot be used in obj-c
 @objc(DUXBetaKey) public class ExternalKey : NSObject {
-    var concreteKey:ConcreteKey {
-        get {
-            return ConcreteKey(index:self.index, parameter:self.internalParameter)
-        }
-    }
+    let concreteKey:ConcreteKey
     
     public let index:Int
     
@@ -177,11 +174,13 @@ enum Type {
     init(index:Int, param:Parameter) {
         self.index = index
         self.internalParameter = param
+        self.concreteKey = ConcreteKey(index:index, parameter:param)
     }
     
     init(concreteKey:ConcreteKey) {
         self.index = concreteKey.index
         self.internalParameter = concreteKey.param
+        self.concreteKey = concreteKey
     }
 }
 
@@ -313,30 +312,85 @@ public class ModelValue: NSObject {
 
 typealias ModelValueCompletionBlock = (ModelValue?) -> Void
 
+// FlatStore spreads its keys over shards, each behind its own reader/writer lock, so reads run concurrently and
+// writes only contend with other writes to the same shard. Writes are applied before they return.
 class FlatStore: NSObject {
-    var underlyingStore:[ConcreteKey:ModelValue] = [:]
-    var queue:DispatchQueue = DispatchQueue(label: "DUXBetaFlatStoreSerialQueue")
+    final class Shard {
+        var underlyingStore:[ConcreteKey:ModelValue] = [:]
+        let lock = UnsafeMutablePointer<pthread_rwlock_t>.allocate(capacity: 1)
+        
+        init() {
+            pthread_rwlock_init(self.lock, nil)
+        }
+        
+        deinit {
+            pthread_rwlock_destroy(self.lock)
+            self.lock.deallocate()
+        }
+    }
+    
+    static let shardCount = 16
+    let shards:[Shard] = (0..<FlatStore.shardCount).map { _ in Shard() }
+    var queue:DispatchQueue = DispatchQueue(label: "DUXBetaFlatStoreCompletionQueue", attributes: .concurrent)
+    
+    func shard(for key:ConcreteKey) -> Shard {
+        return self.shards[Int(UInt(bitPattern: key.hashValue) % UInt(FlatStore.shardCount))]
+    }
     
     func update(modelValue:ModelValue?, for key:ConcreteKey) {
-        self.queue.async {
-            self.underlyingStore[key] = modelValue
+        let shard = self.shard(for: key)
+        pthread_rwlock_wrlock(shard.lock)
+        shard.underlyingStore[key] = modelValue
+        pthread_rwlock_unlock(shard.lock)
+    }
+    
+    // Atomically replaces the value of the key with the one returned by transform. The value counts as changed
+    // when transform returns a different instance, in which case didChange is called before the shard is unlocked,
+    // so the order of didChange calls per key is the order of the updates.
+    @discardableResult
+    func update(key:ConcreteKey,
+                transform:(ModelValue?) -> ModelValue?,
+                didChange:((_ priorValue:ModelValue?, _ updatedValue:ModelValue?) -> Void)? = nil) -> Bool {
+        let shard = self.shard(for: key)
+        pthread_rwlock_wrlock(shard.lock)
+        defer { pthread_rwlock_unlock(shard.lock) }
+        
+        let priorValue = shard.underlyingStore[key]
+        let updatedValue = transform(priorValue)
+        if priorValue === updatedValue {
+            return false
         }
+        shard.underlyingStore[key] = updatedValue
+        didChange?(priorValue, updatedValue)
+        return true
     }
     
-    func availableModelValueFor(key: ConcreteKey) -> ModelValue? {
-        var modelValue: ModelValue?;
+    // Stores the new value only if the key still holds the expected instance.
+    @discardableResult
+    func compareAndSet(key:ConcreteKey, expected:ModelValue?, new:ModelValue?) -> Bool {
+        let shard = self.shard(for: key)
+        pthread_rwlock_wrlock(shard.lock)
+        defer { pthread_rwlock_unlock(shard.lock) }
         
-        self.queue.sync {
-            modelValue = self.underlyingStore[key]
+        if shard.underlyingStore[key] !== expected {
+            return false
         }
-        
+        shard.underlyingStore[key] = new
+        return true
+    }
+    
+    func availableModelValueFor(key: ConcreteKey) -> ModelValue? {
+        let shard = self.shard(for: key)
+        pthread_rwlock_rdlock(shard.lock)
+        let modelValue = shard.underlyingStore[key]
+        pthread_rwlock_unlock(shard.lock)
         return modelValue
     }
     
     // @escaping always for async execution, always
     func modelValueFor(key: ConcreteKey, completion: @escaping ModelValueCompletionBlock) {
         self.queue.async {
-            completion(self.underlyingStore[key])
+            completion(self.availableModelValueFor(key: key))
         }
     }
 }
@@ -345,7 +399,7 @@ protocol BroadcastObserver:Hashable {
     func broadcast(updatedValue:ModelValue?, priorValue:ModelValue?, for key:ConcreteKey)
 }
 
-class ClosureBroadcastObserver<U: ConcreteKey>: BroadcastObserver {
+class ClosureBroadcastObserver: BroadcastObserver {
     public static func == (lhs: ClosureBroadcastObserver, rhs: ClosureBroadcastObserver) -> Bool {
         return lhs.reference == rhs.reference
     }
@@ -373,14 +427,44 @@ class ClosureBroadcastObserver<U: ConcreteKey>: BroadcastObserver {
     }
 }
 
-class Broadcaster<ObserverType: BroadcastObserver, KeyType: ConcreteKey> {
-    var observers:[KeyType:Set<ObserverType>] = [:]
+// Lanes of a broadcast batch, keys in a higher lane are delivered first
+enum BroadcastPriority: Int, CaseIterable {
+    case high = 0, normal, low
+}
+
+struct PendingBroadcast {
+    var updatedValue:ModelValue?
+    let priorValue:ModelValue?
+}
+
+class Broadcaster<ObserverType: BroadcastObserver> {
+    var observers:[ConcreteKey:Set<ObserverType>] = [:]
     let workingQueue:DispatchQueue = DispatchQueue(label: "BroadcasterWorkingQueue")
     
     // Queue where broadcasts occur, main thread by default
     var preferredBroadcastQueue:DispatchQueue? = DispatchQueue.main
     
-    func add(observer:ObserverType, for key:KeyType) {
+    // Changes are batched until the broadcast queue runs the flush, one block per batch. A key changing several
+    // times in between is delivered once, with its latest value and the value it had before the first change. A key
+    // that is back to that value by the flush is not delivered at all.
+    var pendingBroadcasts:[ConcreteKey:PendingBroadcast] = [:]
+    var pendingKeys:[[ConcreteKey]] = Array(repeating: [], count: BroadcastPriority.allCases.count)
+    var flushScheduled = false
+    var priorities:[Parameter:BroadcastPriority] = [:]
+    
+    // Number of flush blocks enqueued on the broadcast queue so far, only touched on the working queue
+    private var flushCount = 0
+    var scheduledFlushCount:Int {
+        return self.workingQueue.sync { self.flushCount }
+    }
+    
+    func setPriority(_ priority:BroadcastPriority, for parameter:Parameter) {
+        self.workingQueue.async {
+            self.priorities[parameter] = priority
+        }
+    }
+    
+    func add(observer:ObserverType, for key:ConcreteKey) {
         self.workingQueue.async {
             if var observers = self.observers[key] {
                 observers.insert(observer)
@@ -393,7 +477,7 @@ class Broadcaster<ObserverType: BroadcastObserver, KeyType: ConcreteKey> {
         }
     }
     
-    func add(observer:ObserverType, for key:KeyType, broadcastAvailableValue:Bool) {
+    func add(observer:ObserverType, for key:ConcreteKey, broadcastAvailableValue:Bool) {
         self.workingQueue.async {
             if var observers = self.observers[key] {
                 observers.insert(observer)
@@ -406,7 +490,7 @@ class Broadcaster<ObserverType: BroadcastObserver, KeyType: ConcreteKey> {
         }
     }
     
-    func remove(observer:ObserverType, for key:KeyType) {
+    func remove(observer:ObserverType, for key:ConcreteKey) {
         self.workingQueue.async {
             if var observersForKey = self.observers[key] {
                 observersForKey.remove(observer)
@@ -417,7 +501,7 @@ class Broadcaster<ObserverType: BroadcastObserver, KeyType: ConcreteKey> {
     
     func removeAllInstancesOf(observer:ObserverType) {
         self.workingQueue.async {
-            var updatedObservers:[KeyType:Set<ObserverType>] = [:]
+            var updatedObservers:[ConcreteKey:Set<ObserverType>] = [:]
             
             for (key, value) in self.observers {
                 updatedObservers[key] = value.filter { (broadcastObserver:ObserverType) -> Bool in
@@ -435,15 +519,60 @@ class Broadcaster<ObserverType: BroadcastObserver, KeyType: ConcreteKey> {
         }
     }
     
-    func broadcast(updatedValue:ModelValue?, priorValue:ModelValue?, for key:KeyType) {
+    func broadcast(updatedValue:ModelValue?, priorValue:ModelValue?, for key:ConcreteKey) {
         self.workingQueue.async {
-            if let keyObservers = self.observers[key] {
-                for observer in keyObservers {
-                    self.preferredBroadcastQueue?.async {
-                        observer.broadcast(updatedValue: updatedValue, priorValue: priorValue, for: key)
+            guard let broadcastQueue = self.preferredBroadcastQueue else { return }
+            
+            if var pending = self.pendingBroadcasts[key] {
+                pending.updatedValue = updatedValue
+                self.pendingBroadcasts[key] = pending
+            } else {
+                self.pendingBroadcasts[key] = PendingBroadcast(updatedValue: updatedValue, priorValue: priorValue)
+                let lane = self.priorities[key.param] ?? .normal
+                self.pendingKeys[lane.rawValue].append(key)
+            }
+            
+            if !self.flushScheduled {
+                self.flushScheduled = true
+                self.flushCount += 1
+                broadcastQueue.async {
+                    self.flush()
+                }
+            }
+        }
+    }
+    
+    static func isUnchanged(_ pending:PendingBroadcast) -> Bool {
+        guard let updatedValue = pending.updatedValue else {
+            return pending.priorValue == nil
+        }
+        return updatedValue.testEqual(pending.priorValue)
+    }
+    
+    func flush() {
+        var batch:[(key:ConcreteKey, pending:PendingBroadcast, observers:Set<ObserverType>)] = []
+        self.workingQueue.sync {
+            for laneKeys in self.pendingKeys {
+                for key in laneKeys {
+                    if let pending = self.pendingBroadcasts[key], let keyObservers = self.observers[key], !keyObservers.isEmpty {
+                        if Broadcaster.isUnchanged(pending) {
+                            continue
+                        }
+                        batch.append((key: key, pending: pending, observers: keyObservers))
                     }
                 }
             }
+            self.pendingBroadcasts.removeAll(keepingCapacity: true)
+            for lane in self.pendingKeys.indices {
+                self.pendingKeys[lane].removeAll(keepingCapacity: true)
+            }
+            self.flushScheduled = false
+        }
+        
+        for entry in batch {
+            for observer in entry.observers {
+                observer.broadcast(updatedValue: entry.pending.updatedValue, priorValue: entry.pending.priorValue, for: entry.key)
+            }
         }
     }
 }
@@ -470,7 +599,15 @@ public typealias ObservableKeyedStoreUpdateBlock = (ModelValue?, ModelValue?, Ex
 
 public class ObservableInMemoryKeyedStore : NSObject, ObservableKeyedStore {
     let store:FlatStore = FlatStore()
-    let broadcaster:Broadcaster<ClosureBroadcastObserver, ConcreteKey> = Broadcaster()
+    let broadcaster:Broadcaster<ClosureBroadcastObserver> = Broadcaster()
+    
+    public override init() {
+        super.init()
+        // Keys changing what is on screen go ahead of the rest in a broadcast batch
+        for parameter:Parameter in [.Metric, .Imperial, .AFCEnabled, .PeakingThreshold] {
+            self.broadcaster.setPriority(.high, for: parameter)
+        }
+    }
     
     @objc(addObserver:forKey:broadcastAvailableValue:withUpdateBlock:)
     public func add(observer: NSObject?, for key:ExternalKey, broadcastAvailableValue:Bool, updateBlock:@escaping ObservableKeyedStoreUpdateBlock) {
@@ -506,13 +643,15 @@ public class ObservableInMemoryKeyedStore : NSObject, ObservableKeyedStore {
     
     @objc(setModelValue:forKey:)
     public func set(modelValue:ModelValue?, for key:ExternalKey) {
-        let oldValue = self.store.availableModelValueFor(key: key.concreteKey)
-        if let oldValue = oldValue {
-            if oldValue.testEqual(modelValue) {
-                return
+        let concreteKey = key.concreteKey
+        // Comparing and storing happen under the same lock, so only a real change is broadcast, in update order.
+        self.store.update(key: concreteKey, transform: { (oldValue) -> ModelValue? in
+            if let oldValue = oldValue, oldValue.testEqual(modelValue) {
+                return oldValue
             }
-        }
-        self.store.update(modelValue: modelValue, for: key.concreteKey)
-        self.broadcaster.broadcast(updatedValue: modelValue, priorValue: self.store.availableModelValueFor(key: key.concreteKey), for: key.concreteKey)
+            return modelValue
+        }, didChange: { (priorValue, updatedValue) in
+            self.broadcaster.broadcast(updatedValue: updatedValue, priorValue: priorValue, for: concreteKey)
+        })
     }
 }
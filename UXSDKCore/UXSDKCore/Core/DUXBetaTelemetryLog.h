@@ -0,0 +1,99 @@
+//
+//  DUXBetaTelemetryLog.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+#import <DJISDK/DJISDK.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString * const DUXBetaTelemetryLogErrorDomain;
+
+typedef NS_ENUM(NSInteger, DUXBetaTelemetryLogError) {
+    DUXBetaTelemetryLogErrorInvalidHeader = 1,
+    DUXBetaTelemetryLogErrorUnsupportedVersion,
+    DUXBetaTelemetryLogErrorCorrupted
+};
+
+/**
+ *  Writes key updates to a compact binary log. Every key is written out once and referred to by a number
+ *  afterwards, timestamps are stored as the delta to the previous event. Numbers, strings and data are stored
+ *  directly. Arrays, dictionaries, NSValues, dates and locations are archived with secure coding, and anything
+ *  else is stored as nil.
+ *  Thread safe.
+ */
+@interface DUXBetaTelemetryLogWriter : NSObject
+
+/**
+ *  Appends an update of the key, timestamped with the time elapsed since the writer was created.
+ */
+- (void)appendValue:(nullable id)value forKey:(DJIKey *)key;
+
+/**
+ *  Appends an update at an explicit timestamp, in nanoseconds from the start of the log. Timestamps lower than the
+ *  previous event's are clamped to it.
+ */
+- (void)appendValue:(nullable id)value forKey:(DJIKey *)key timestamp:(uint64_t)timestamp;
+
+@property (readonly, nonatomic) NSUInteger eventCount;
+
+/**
+ *  Copy of the log written so far.
+ */
+- (NSData *)data;
+
+/**
+ *  A synthetic log of the battery and flight controller keys the battery widget binds, updated round robin
+ *  every interval. Usable as a fixture when there is no recorded flight.
+ */
++ (NSData *)syntheticLogWithEventCount:(NSUInteger)eventCount interval:(NSTimeInterval)interval;
+
+@end
+
+/**
+ *  Reads a log written by DUXBetaTelemetryLogWriter one event at a time, without decoding it all upfront.
+ */
+@interface DUXBetaTelemetryLogReader : NSObject
+
+- (nullable instancetype)initWithData:(NSData *)data error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ *  Reads the next event. Returns NO at the end of the log, or when it is corrupted, in which case error is set.
+ *  An archived value holding a class the writer does not archive counts as corrupted.
+ */
+- (BOOL)readEventWithTimestamp:(uint64_t *)timestamp
+                           key:(DJIKey * _Nullable * _Nonnull)key
+                         value:(id _Nullable * _Nonnull)value
+                         error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ *  Starts over from the first event.
+ */
+- (void)rewind;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,402 @@
+//
+//  DUXBetaTelemetryLog.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaTelemetryLog.h"
+#import <CoreLocation/CoreLocation.h>
+#import <pthread/pthread.h>
+
+NSString * const DUXBetaTelemetryLogErrorDomain = @"DUXBetaTelemetryLogErrorDomain";
+
+static const char kDUXBetaTelemetryLogMagic[4] = {'D', 'U', 'X', 'T'};
+static const uint8_t kDUXBetaTelemetryLogVersion = 1;
+
+typedef NS_ENUM(uint8_t, DUXBetaTelemetryRecordType) {
+    DUXBetaTelemetryRecordTypeKey = 1,
+    DUXBetaTelemetryRecordTypeEvent = 2
+};
+
+typedef NS_ENUM(uint8_t, DUXBetaTelemetryValueType) {
+    DUXBetaTelemetryValueTypeNil = 0,
+    DUXBetaTelemetryValueTypeInteger = 1,
+    DUXBetaTelemetryValueTypeDouble = 2,
+    DUXBetaTelemetryValueTypeString = 3,
+    DUXBetaTelemetryValueTypeData = 4,
+    DUXBetaTelemetryValueTypeArchive = 5
+};
+
+/**
+ *  The only classes an archived value may contain. Logs can come from anywhere, so everything else is rejected
+ *  when reading rather than instantiated.
+ */
+static NSSet<Class> *DUXBetaTelemetryArchiveClasses(void) {
+    static NSSet<Class> *classes;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        classes = [NSSet setWithObjects:[NSNumber class], [NSString class], [NSData class], [NSArray class],
+                   [NSDictionary class], [NSValue class], [NSDate class], [CLLocation class], nil];
+    });
+    return classes;
+}
+
+static BOOL DUXBetaTelemetryIsArchivable(id value) {
+    for (Class archiveClass in DUXBetaTelemetryArchiveClasses()) {
+        if ([value isKindOfClass:archiveClass]) return YES;
+    }
+    return NO;
+}
+
+#pragma mark - Encoding
+
+static void DUXBetaTelemetryAppendByte(NSMutableData *data, uint8_t byte) {
+    [data appendBytes:&byte length:1];
+}
+
+static void DUXBetaTelemetryAppendVarint(NSMutableData *data, uint64_t value) {
+    uint8_t buffer[10];
+    NSUInteger length = 0;
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        buffer[length++] = value ? (byte | 0x80) : byte;
+    } while (value);
+    [data appendBytes:buffer length:length];
+}
+
+static void DUXBetaTelemetryAppendBytes(NSMutableData *data, const void *bytes, NSUInteger length) {
+    DUXBetaTelemetryAppendVarint(data, length);
+    [data appendBytes:bytes length:length];
+}
+
+static void DUXBetaTelemetryAppendString(NSMutableData *data, NSString *string) {
+    NSData *utf8 = [string ?: @"" dataUsingEncoding:NSUTF8StringEncoding];
+    DUXBetaTelemetryAppendBytes(data, utf8.bytes, utf8.length);
+}
+
+static void DUXBetaTelemetryAppendValue(NSMutableData *data, id value) {
+    if ([value isKindOfClass:[NSNumber class]]) {
+        const char *type = [value objCType];
+        if (type[0] == 'f' || type[0] == 'd') {
+            DUXBetaTelemetryAppendByte(data, DUXBetaTelemetryValueTypeDouble);
+            uint64_t bits = 0;
+            double number = [value doubleValue];
+            memcpy(&bits, &number, sizeof(bits));
+            bits = CFSwapInt64HostToLittle(bits);
+            [data appendBytes:&bits length:sizeof(bits)];
+        } else {
+            DUXBetaTelemetryAppendByte(data, DUXBetaTelemetryValueTypeInteger);
+            int64_t number = [value longLongValue];
+            DUXBetaTelemetryAppendVarint(data, ((uint64_t)number << 1) ^ (uint64_t)(number >> 63));
+        }
+    } else if ([value isKindOfClass:[NSString class]]) {
+        DUXBetaTelemetryAppendByte(data, DUXBetaTelemetryValueTypeString);
+        DUXBetaTelemetryAppendString(data, value);
+    } else if ([value isKindOfClass:[NSData class]]) {
+        DUXBetaTelemetryAppendByte(data, DUXBetaTelemetryValueTypeData);
+        DUXBetaTelemetryAppendBytes(data, [value bytes], [value length]);
+    } else if (DUXBetaTelemetryIsArchivable(value)) {
+        NSData *archive = [NSKeyedArchiver archivedDataWithRootObject:value requiringSecureCoding:YES error:nil];
+        if (archive) {
+            DUXBetaTelemetryAppendByte(data, DUXBetaTelemetryValueTypeArchive);
+            DUXBetaTelemetryAppendBytes(data, archive.bytes, archive.length);
+        } else {
+            DUXBetaTelemetryAppendByte(data, DUXBetaTelemetryValueTypeNil);
+        }
+    } else {
+        DUXBetaTelemetryAppendByte(data, DUXBetaTelemetryValueTypeNil);
+    }
+}
+
+static NSString *DUXBetaTelemetryKeyIdentifier(DJIKey *key) {
+    return [NSString stringWithFormat:@"%@|%lu|%@|%lu|%@", NSStringFromClass([key class]), (unsigned long)key.index, key.subComponent ?: @"", (unsigned long)key.subComponentIndex, key.param];
+}
+
+@interface DUXBetaTelemetryLogWriter ()
+{
+    pthread_mutex_t _mutex;
+    uint64_t _startTime;
+    uint64_t _lastTimestamp;
+}
+
+@property (strong, nonatomic) NSMutableData *buffer;
+@property (strong, nonatomic) NSMutableDictionary<NSString *, NSNumber *> *keyNumbers;
+@property (assign, nonatomic) NSUInteger eventCount;
+
+@end
+
+@implementation DUXBetaTelemetryLogWriter
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        pthread_mutex_init(&_mutex, NULL);
+        _startTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+        _keyNumbers = [[NSMutableDictionary alloc] init];
+        _buffer = [[NSMutableData alloc] init];
+        [_buffer appendBytes:kDUXBetaTelemetryLogMagic length:sizeof(kDUXBetaTelemetryLogMagic)];
+        DUXBetaTelemetryAppendByte(_buffer, kDUXBetaTelemetryLogVersion);
+    }
+    return self;
+}
+
+- (void)appendValue:(nullable id)value forKey:(DJIKey *)key {
+    [self appendValue:value forKey:key timestamp:clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - _startTime];
+}
+
+- (void)appendValue:(nullable id)value forKey:(DJIKey *)key timestamp:(uint64_t)timestamp {
+    NSString *identifier = DUXBetaTelemetryKeyIdentifier(key);
+    pthread_mutex_lock(&_mutex);
+    NSNumber *keyNumber = self.keyNumbers[identifier];
+    if (keyNumber == nil) {
+        keyNumber = @(self.keyNumbers.count);
+        self.keyNumbers[identifier] = keyNumber;
+        DUXBetaTelemetryAppendByte(self.buffer, DUXBetaTelemetryRecordTypeKey);
+        DUXBetaTelemetryAppendString(self.buffer, NSStringFromClass([key class]));
+        DUXBetaTelemetryAppendString(self.buffer, key.param);
+        DUXBetaTelemetryAppendVarint(self.buffer, key.index);
+        DUXBetaTelemetryAppendString(self.buffer, key.subComponent);
+        DUXBetaTelemetryAppendVarint(self.buffer, key.subComponentIndex);
+    }
+    timestamp = MAX(timestamp, _lastTimestamp);
+    DUXBetaTelemetryAppendByte(self.buffer, DUXBetaTelemetryRecordTypeEvent);
+    DUXBetaTelemetryAppendVarint(self.buffer, timestamp - _lastTimestamp);
+    DUXBetaTelemetryAppendVarint(self.buffer, keyNumber.unsignedLongLongValue);
+    DUXBetaTelemetryAppendValue(self.buffer, value);
+    _lastTimestamp = timestamp;
+    self.eventCount++;
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (NSData *)data {
+    pthread_mutex_lock(&_mutex);
+    NSData *data = [self.buffer copy];
+    pthread_mutex_unlock(&_mutex);
+    return data;
+}
+
++ (NSData *)syntheticLogWithEventCount:(NSUInteger)eventCount interval:(NSTimeInterval)interval {
+    NSArray<DJIKey *> *keys = @[[DJIFlightControllerKey keyWithParam:DJIParamConnection],
+                                [DJIBatteryKey keyWithIndex:0 andParam:DJIBatteryParamChargeRemainingInPercent],
+                                [DJIBatteryKey keyWithIndex:1 andParam:DJIBatteryParamChargeRemainingInPercent],
+                                [DJIFlightControllerKey keyWithParam:DJIFlightControllerParamBatteryPercentageNeededToGoHome],
+                                [DJIFlightControllerKey keyWithIndex:0 andParam:DJIFlightControllerParamBatteryThresholdBehavior],
+                                [DJIBatteryKey keyWithIndex:0 andParam:DJIBatteryParamCellVoltages],
+                                [DJIBatteryKey keyWithIndex:1 andParam:DJIBatteryParamCellVoltages]];
+    DUXBetaTelemetryLogWriter *writer = [[DUXBetaTelemetryLogWriter alloc] init];
+    uint64_t step = (uint64_t)(interval * NSEC_PER_SEC);
+    for (NSUInteger i = 0; i < eventCount; i++) {
+        NSUInteger keyIndex = i % keys.count;
+        // Every value carries its sequence number per key, so a replay can be checked for ordering.
+        NSUInteger sequence = i / keys.count;
+        id value = nil;
+        switch (keyIndex) {
+            case 0:
+                value = @YES;
+                break;
+            case 5:
+            case 6:
+                value = @[@(3800 + sequence % 400), @(3810 + sequence % 400), @(3790 + sequence % 400)];
+                break;
+            default:
+                value = @(sequence);
+                break;
+        }
+        [writer appendValue:value forKey:keys[keyIndex] timestamp:i * step];
+    }
+    return [writer data];
+}
+
+@end
+
+#pragma mark - Decoding
+
+@interface DUXBetaTelemetryLogReader ()
+{
+    const uint8_t *_bytes;
+    NSUInteger _length;
+    NSUInteger _offset;
+    uint64_t _timestamp;
+}
+
+@property (strong, nonatomic) NSData *data;
+@property (strong, nonatomic) NSMutableArray<DJIKey *> *keys;
+
+@end
+
+@implementation DUXBetaTelemetryLogReader
+
+- (nullable instancetype)initWithData:(NSData *)data error:(NSError * _Nullable * _Nullable)error {
+    if (self = [super init]) {
+        _data = [data copy];
+        _bytes = _data.bytes;
+        _length = _data.length;
+        if (_length < sizeof(kDUXBetaTelemetryLogMagic) + 1 || memcmp(_bytes, kDUXBetaTelemetryLogMagic, sizeof(kDUXBetaTelemetryLogMagic)) != 0) {
+            if (error) *error = [NSError errorWithDomain:DUXBetaTelemetryLogErrorDomain code:DUXBetaTelemetryLogErrorInvalidHeader userInfo:nil];
+            return nil;
+        }
+        if (_bytes[sizeof(kDUXBetaTelemetryLogMagic)] != kDUXBetaTelemetryLogVersion) {
+            if (error) *error = [NSError errorWithDomain:DUXBetaTelemetryLogErrorDomain code:DUXBetaTelemetryLogErrorUnsupportedVersion userInfo:nil];
+            return nil;
+        }
+        [self rewind];
+    }
+    return self;
+}
+
+- (void)rewind {
+    _offset = sizeof(kDUXBetaTelemetryLogMagic) + 1;
+    _timestamp = 0;
+    self.keys = [[NSMutableArray alloc] init];
+}
+
+- (BOOL)readByte:(uint8_t *)byte {
+    if (_offset >= _length) return NO;
+    *byte = _bytes[_offset++];
+    return YES;
+}
+
+- (BOOL)readVarint:(uint64_t *)value {
+    uint64_t result = 0;
+    for (NSUInteger shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = 0;
+        if (![self readByte:&byte]) return NO;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (nullable NSData *)readBytes {
+    uint64_t length = 0;
+    if (![self readVarint:&length] || length > _length - _offset) return nil;
+    NSData *bytes = [self.data subdataWithRange:NSMakeRange(_offset, (NSUInteger)length)];
+    _offset += (NSUInteger)length;
+    return bytes;
+}
+
+- (nullable NSString *)readString {
+    NSData *bytes = [self readBytes];
+    return bytes ? [[NSString alloc] initWithData:bytes encoding:NSUTF8StringEncoding] : nil;
+}
+
+- (BOOL)readValue:(id _Nullable * _Nonnull)value {
+    uint8_t type = 0;
+    if (![self readByte:&type]) return NO;
+    switch (type) {
+        case DUXBetaTelemetryValueTypeNil:
+            *value = nil;
+            return YES;
+        case DUXBetaTelemetryValueTypeInteger: {
+            uint64_t zigzag = 0;
+            if (![self readVarint:&zigzag]) return NO;
+            *value = @((int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1));
+            return YES;
+        }
+        case DUXBetaTelemetryValueTypeDouble: {
+            uint64_t bits = 0;
+            if (_length - _offset < sizeof(bits)) return NO;
+            memcpy(&bits, _bytes + _offset, sizeof(bits));
+            _offset += sizeof(bits);
+            bits = CFSwapInt64LittleToHost(bits);
+            double number = 0;
+            memcpy(&number, &bits, sizeof(number));
+            *value = @(number);
+            return YES;
+        }
+        case DUXBetaTelemetryValueTypeString:
+            *value = [self readString];
+            return *value != nil;
+        case DUXBetaTelemetryValueTypeData:
+            *value = [self readBytes];
+            return *value != nil;
+        case DUXBetaTelemetryValueTypeArchive: {
+            NSData *archive = [self readBytes];
+            if (archive == nil) return NO;
+            // An archive the writer would not have produced is treated as corruption.
+            *value = [NSKeyedUnarchiver unarchivedObjectOfClasses:DUXBetaTelemetryArchiveClasses() fromData:archive error:nil];
+            return *value != nil;
+        }
+        default:
+            return NO;
+    }
+}
+
+- (BOOL)readKey {
+    NSString *className = [self readString];
+    NSString *param = [self readString];
+    uint64_t index = 0;
+    uint64_t subComponentIndex = 0;
+    if (className == nil || param == nil || ![self readVarint:&index]) return NO;
+    NSString *subComponent = [self readString];
+    if (subComponent == nil || ![self readVarint:&subComponentIndex]) return NO;
+    
+    Class keyClass = NSClassFromString(className);
+    if (![keyClass isSubclassOfClass:[DJIKey class]]) return NO;
+    DJIKey *key = [keyClass keyWithIndex:(NSUInteger)index
+                            subComponent:subComponent.length > 0 ? subComponent : nil
+                       subComponentIndex:(NSUInteger)subComponentIndex
+                                andParam:param];
+    if (key == nil) return NO;
+    [self.keys addObject:key];
+    return YES;
+}
+
+- (BOOL)readEventWithTimestamp:(uint64_t *)timestamp
+                           key:(DJIKey * _Nullable * _Nonnull)key
+                         value:(id _Nullable * _Nonnull)value
+                         error:(NSError * _Nullable * _Nullable)error {
+    while (_offset < _length) {
+        uint8_t type = 0;
+        [self readByte:&type];
+        if (type == DUXBetaTelemetryRecordTypeKey) {
+            if ([self readKey]) continue;
+        } else if (type == DUXBetaTelemetryRecordTypeEvent) {
+            uint64_t delta = 0;
+            uint64_t keyNumber = 0;
+            if ([self readVarint:&delta] && [self readVarint:&keyNumber] && keyNumber < self.keys.count && [self readValue:value]) {
+                _timestamp += delta;
+                *timestamp = _timestamp;
+                *key = self.keys[(NSUInteger)keyNumber];
+                return YES;
+            }
+        }
+        
+        // Corrupted data is not read any further.
+        _offset = _length;
+        if (error) {
+            *error = [NSError errorWithDomain:DUXBetaTelemetryLogErrorDomain code:DUXBetaTelemetryLogErrorCorrupted userInfo:nil];
+        }
+    }
+    return NO;
+}
+
+@end
@@ -0,0 +1,52 @@
+//
+//  DUXBetaTelemetryRecordingKeyHandler.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+#import <UXSDKCore/DUXBetaKeyManager.h>
+#import <UXSDKCore/DUXBetaTelemetryLog.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Forwards to another DUXBetaKeyInterfaces handler and logs, timestamped, every value the handler pushes for a
+ *  listened key. The first listener on a key makes the recorder listen to it too, and each update is logged once
+ *  from there, however many listeners the key has. Values returned for a get are not logged, a replay only pushes
+ *  real updates. Install it with -[DUXBetaKeyInterfaceAdapter setHandler:] before the widgets bind, the log can be
+ *  replayed by DUXBetaTelemetryReplayKeyHandler in UXSDKCoreBenchmarks.
+ */
+@interface DUXBetaTelemetryRecordingKeyHandler : NSObject <DUXBetaKeyInterfaces>
+
+- (instancetype)initWithHandler:(id<DUXBetaKeyInterfaces>)handler;
+
+@property (strong, nonatomic, readonly) id<DUXBetaKeyInterfaces> handler;
+@property (strong, nonatomic, readonly) DUXBetaTelemetryLogWriter *writer;
+
+- (NSData *)recordedLog;
+
+@end
+
+NS_ASSUME_NONNULL_END
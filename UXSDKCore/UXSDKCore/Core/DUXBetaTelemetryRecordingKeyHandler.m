@@ -0,0 +1,135 @@
+//
+//  DUXBetaTelemetryRecordingKeyHandler.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaTelemetryRecordingKeyHandler.h"
+#import <pthread/pthread.h>
+
+@interface DUXBetaTelemetryRecordingKeyHandler ()
+{
+    pthread_mutex_t _mutex;
+}
+
+/**
+ *  Listener object for the recorder's own registrations, one per key. Callers' listeners are passed straight
+ *  through to the handler, so a key is logged once per update however many widgets observe it.
+ */
+@property (strong, nonatomic) NSObject *recordingListener;
+@property (strong, nonatomic) NSMutableSet<NSString *> *recordedKeys;
+
+@end
+
+static NSString *DUXBetaTelemetryRecordingKeyIdentifier(DJIKey *key) {
+    return [NSString stringWithFormat:@"%@|%lu|%@|%lu|%@", NSStringFromClass([key class]), (unsigned long)key.index, key.subComponent ?: @"", (unsigned long)key.subComponentIndex, key.param];
+}
+
+@implementation DUXBetaTelemetryRecordingKeyHandler
+
+- (void)dealloc {
+    [_handler stopAllListeningOfListeners:_recordingListener];
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (instancetype)init {
+    return [self initWithHandler:[DUXBetaKeyManager new]];
+}
+
+- (instancetype)initWithHandler:(id<DUXBetaKeyInterfaces>)handler {
+    if (self = [super init]) {
+        _handler = handler;
+        _writer = [[DUXBetaTelemetryLogWriter alloc] init];
+        _recordingListener = [[NSObject alloc] init];
+        _recordedKeys = [[NSMutableSet alloc] init];
+        pthread_mutex_init(&_mutex, NULL);
+    }
+    return self;
+}
+
+- (NSData *)recordedLog {
+    return [self.writer data];
+}
+
+- (void)startRecordingKey:(DJIKey *)key {
+    NSString *identifier = DUXBetaTelemetryRecordingKeyIdentifier(key);
+    pthread_mutex_lock(&_mutex);
+    BOOL recorded = [self.recordedKeys containsObject:identifier];
+    [self.recordedKeys addObject:identifier];
+    pthread_mutex_unlock(&_mutex);
+    if (recorded) {
+        return;
+    }
+    
+    // Registered before the caller's listener, so the log has the update by the time the caller sees it.
+    DUXBetaTelemetryLogWriter *writer = self.writer;
+    [self.handler startListeningForChangesOnKey:key withListener:self.recordingListener andUpdateBlock:^(DJIKeyedValue * _Nullable oldValue, DJIKeyedValue * _Nullable newValue) {
+        [writer appendValue:newValue.value forKey:key];
+    }];
+}
+
+#pragma mark - DUXBetaKeyInterfaces
+
+- (nullable DJIKeyedValue *)getValueForKey:(DJIKey *)key {
+    return [self.handler getValueForKey:key];
+}
+
+- (void)getValueForKey:(DJIKey *)key
+        withCompletion:(DJIKeyedGetCompletionBlock)completion {
+    [self.handler getValueForKey:key withCompletion:completion];
+}
+
+- (void)setValue:(id)value
+          forKey:(DJIKey *)key
+  withCompletion:(DJIKeyedSetCompletionBlock)completion {
+    [self.handler setValue:value forKey:key withCompletion:completion];
+}
+
+- (void)performActionForKey:(DJIKey *)key
+              withArguments:(nullable NSArray *)arguments
+              andCompletion:(DJIKeyedActionCompletionBlock)completion {
+    [self.handler performActionForKey:key withArguments:arguments andCompletion:completion];
+}
+
+- (void)startListeningForChangesOnKey:(DJIKey *)key
+                         withListener:(id)listener
+                       andUpdateBlock:(DJIKeyedListenerUpdateBlock)updateBlock {
+    [self startRecordingKey:key];
+    [self.handler startListeningForChangesOnKey:key withListener:listener andUpdateBlock:updateBlock];
+}
+
+- (void)stopListeningOnKey:(DJIKey *)key
+                ofListener:(id)listener {
+    [self.handler stopListeningOnKey:key ofListener:listener];
+}
+
+- (void)stopAllListeningOfListeners:(id)listener {
+    [self.handler stopAllListeningOfListeners:listener];
+}
+
+- (BOOL)isKeySupported:(DJIKey *)key {
+    return [self.handler isKeySupported:key];
+}
+
+@end
@@ -44,6 +44,13 @@ NS_ASSUME_NONNULL_BEGIN
 - (instancetype)initWithKey:(NSString*)key string:(NSString*)string;
 - (instancetype)initWithKey:(NSString*)key object:(id)object;
 
+/**
+ * Scalar payloads are stored unboxed. The accessors below return them boxed in an NSNumber, longLongValue and
+ * doubleValue read them without boxing.
+ */
+- (instancetype)initWithKey:(NSString*)key integer:(long long)integer;
+- (instancetype)initWithKey:(NSString*)key doubleValue:(double)doubleValue;
+
 /**
  * Accessors for the contents of the DUXBetaStateChangeBaseData instance.
  */
@@ -52,6 +59,8 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSNumber*)number;
 - (NSString*)string;
 - (id)object;
+- (long long)longLongValue;
+- (double)doubleValue;
 
 @end
 
@@ -25,67 +25,123 @@
 
 #import "DUXBetaStateChangeBaseData.h"
 
+typedef NS_ENUM(uint8_t, DUXBetaStateChangePayloadType) {
+    DUXBetaStateChangePayloadTypeObject,
+    DUXBetaStateChangePayloadTypeInteger,
+    DUXBetaStateChangePayloadTypeDouble
+};
+
+// The key and a single payload slot, an object or an unboxed scalar, so an event is one allocation.
 @interface DUXBetaStateChangeBaseData ()
-@property (nonatomic, strong) NSMutableDictionary *dict;
+{
+    NSString *_key;
+    id _object;
+    union {
+        long long integer;
+        double real;
+    } _scalar;
+    DUXBetaStateChangePayloadType _payloadType;
+}
 @end
 
 @implementation DUXBetaStateChangeBaseData
 
-- (instancetype)initWithKey:(NSString*)key {
+- (instancetype)initWithKey:(NSString*)key payloadObject:(id)object {
     if (self = [super init]) {
-        _dict = [[NSMutableDictionary alloc] init];
-        [_dict setObject:@(YES) forKey:key];
+        _key = [key copy];
+        _object = object;
+        _payloadType = DUXBetaStateChangePayloadTypeObject;
     }
     return self;
 }
 
+- (instancetype)initWithKey:(NSString*)key {
+    return [self initWithKey:key payloadObject:@(YES)];
+}
+
 - (instancetype)initWithKey:(NSString*)key number:(NSNumber*)number {
-    if (self = [super init]) {
-        _dict = [[NSMutableDictionary alloc] init];
-        [_dict setObject:number forKey:key];
-    }
-    return self;
+    return [self initWithKey:key payloadObject:number];
 }
+
 - (instancetype)initWithKey:(NSString*)key value:(NSValue*)value {
-    if (self = [super init]) {
-        _dict = [[NSMutableDictionary alloc] init];
-        [_dict setValue:value forKey:key];
-    }
-    return self;
+    return [self initWithKey:key payloadObject:value];
 }
+
 - (instancetype)initWithKey:(NSString*)key string:(NSString*)string {
-    if (self = [super init]) {
-        _dict = [[NSMutableDictionary alloc] init];
-        [_dict setObject:string forKey:key];
+    return [self initWithKey:key payloadObject:string];
+}
+
+- (instancetype)initWithKey:(NSString*)key object:(id)object {
+    return [self initWithKey:key payloadObject:object];
+}
+
+- (instancetype)initWithKey:(NSString*)key integer:(long long)integer {
+    if (self = [self initWithKey:key payloadObject:nil]) {
+        _scalar.integer = integer;
+        _payloadType = DUXBetaStateChangePayloadTypeInteger;
     }
     return self;
 }
-- (instancetype)initWithKey:(NSString*)key object:(id)object {
-    if (self = [super init]) {
-        _dict = [[NSMutableDictionary alloc] init];
-        [_dict setObject:object forKey:key];
+
+- (instancetype)initWithKey:(NSString*)key doubleValue:(double)doubleValue {
+    if (self = [self initWithKey:key payloadObject:nil]) {
+        _scalar.real = doubleValue;
+        _payloadType = DUXBetaStateChangePayloadTypeDouble;
     }
     return self;
 }
 
 - (NSString*)key {
-    return _dict.allKeys[0];
+    return _key;
+}
+
+- (id)payload {
+    switch (_payloadType) {
+        case DUXBetaStateChangePayloadTypeInteger:
+            return @(_scalar.integer);
+        case DUXBetaStateChangePayloadTypeDouble:
+            return @(_scalar.real);
+        default:
+            return _object;
+    }
 }
 
 - (NSValue*)value {
-    return _dict.allValues[0];
+    return [self payload];
 }
 
 - (NSNumber*)number {
-    return _dict.allValues[0];
+    return [self payload];
 }
 
 - (NSString*)string {
-    return _dict.allValues[0];
+    return [self payload];
 }
 
 - (id)object {
-    return _dict.allValues[0];
+    return [self payload];
+}
+
+- (long long)longLongValue {
+    switch (_payloadType) {
+        case DUXBetaStateChangePayloadTypeInteger:
+            return _scalar.integer;
+        case DUXBetaStateChangePayloadTypeDouble:
+            return (long long)_scalar.real;
+        default:
+            return [_object respondsToSelector:@selector(longLongValue)] ? [_object longLongValue] : 0;
+    }
+}
+
+- (double)doubleValue {
+    switch (_payloadType) {
+        case DUXBetaStateChangePayloadTypeInteger:
+            return (double)_scalar.integer;
+        case DUXBetaStateChangePayloadTypeDouble:
+            return _scalar.real;
+        default:
+            return [_object respondsToSelector:@selector(doubleValue)] ? [_object doubleValue] : 0;
+    }
 }
 
 @end
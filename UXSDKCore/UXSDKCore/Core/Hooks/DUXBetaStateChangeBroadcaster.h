@@ -34,10 +34,18 @@ typedef void(^AnalyticsHandler)(DUXBetaStateChangeBaseData *analyticsData);
 + (void)send:(DUXBetaStateChangeBaseData*)analyticsData;  // Convenience method to just send
 
 - (void)registerListener:(id)listener analyticsClassName:(NSString*)analyticsClassName handler:(AnalyticsHandler)block;
+- (void)registerListener:(id)listener analyticsClass:(Class)analyticsClass handler:(AnalyticsHandler)block;
 - (void)unregisterListener:(id)listener;
 - (void)unregisterListener:(id)listener forClassName:(NSString*)analyticsClassNane;
+- (void)unregisterListener:(id)listener forClass:(Class)analyticsClass;
 
+// Each send is delivered to all handlers of its class in one block on the delivery queue.
 - (void)send:(DUXBetaStateChangeBaseData*)analyticsData;
+
+// Delivers sends of the class at most once per interval. Sends arriving sooner replace each other and only the
+// latest one is delivered once the interval has passed. An interval of 0 removes the limit.
+- (void)setMinimumInterval:(NSTimeInterval)interval forClassName:(NSString*)analyticsClassName;
+- (void)setMinimumInterval:(NSTimeInterval)interval forClass:(Class)analyticsClass;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -25,6 +25,7 @@
 
 #import "DUXBetaStateChangeBroadcaster.h"
 #import "DUXBetaStateChangeBaseData.h"
+#import <pthread/pthread.h>
 
 @interface OwnerHandlerTuple : NSObject
 @property (nonatomic, strong) id<NSCopying> ownerKey;
@@ -43,14 +44,43 @@
 }
 @end
 
+// Everything registered for one analytics class. The handlers array is immutable and replaced on every change, so a
+// send can take it and deliver outside the lock.
+@interface StateChangeClassEntry : NSObject
+@property (nonatomic, copy) NSArray<OwnerHandlerTuple*> *handlers;
+@property (nonatomic, assign) NSTimeInterval minimumInterval;
+@property (nonatomic, assign) uint64_t lastDeliveryTime;
+@property (nonatomic, strong) DUXBetaStateChangeBaseData *pendingData;
+@property (nonatomic, assign) BOOL deliveryScheduled;
+@end
+
+@implementation StateChangeClassEntry
+- (instancetype)init {
+    if (self = [super init]) {
+        _handlers = @[];
+    }
+    return self;
+}
+
+- (BOOL)isUnused {
+    return self.handlers.count == 0 && self.minimumInterval <= 0 && !self.deliveryScheduled;
+}
+@end
+
 @interface DUXBetaStateChangeBroadcaster ()
-// The handlersDict is a dictionary of classnames as keys and an array of the handlers to
-// call when an item of that class is sent.
-@property (atomic, strong) NSMutableDictionary<NSString*, NSMutableArray<OwnerHandlerTuple*> *> *handlersDict;
+{
+    pthread_mutex_t _mutex;
+}
+// The handlersByClass is a dictionary of analytics classes as keys and the handlers to call when an item of
+// that class is sent. Names registered before their class can be looked up wait in unresolvedHandlers and are
+// moved over by the first send of that class. Sent classes are only checked against unresolvedHandlers once,
+// checkedClasses remembers them until another name is parked.
+@property (nonatomic, strong) NSMutableDictionary<Class, StateChangeClassEntry*> *handlersByClass;
+@property (nonatomic, strong) NSMutableDictionary<NSString*, StateChangeClassEntry*> *unresolvedHandlers;
+@property (nonatomic, strong) NSMutableSet<Class> *checkedClasses;
 // The listenersDict is a dictionary of the objects and all the classnames that it listens for.
-// It is used to register and unregister listener classes efficiently. the strings in the set
-// will match keys in the handlersDict for efficient removal.
-@property (atomic, strong) NSMutableDictionary<id, NSMutableSet<NSString*>*> *listenersDict;
+// It is used to register and unregister listener classes efficiently.
+@property (nonatomic, strong) NSMutableDictionary<id, NSMutableSet<NSString*>*> *listenersDict;
 
 @property (nonatomic, strong, readonly) dispatch_queue_t syncQueue;
 @end
@@ -75,7 +105,10 @@
 
 - (instancetype)init {
     if (self = [super init]) {
-        _handlersDict = [[NSMutableDictionary alloc] init];
+        pthread_mutex_init(&_mutex, NULL);
+        _handlersByClass = [[NSMutableDictionary alloc] init];
+        _unresolvedHandlers = [[NSMutableDictionary alloc] init];
+        _checkedClasses = [[NSMutableSet alloc] init];
         _listenersDict = [[NSMutableDictionary alloc] init];
         _syncQueue = dispatch_queue_create("analytics delivery", DISPATCH_QUEUE_SERIAL);
     }
@@ -83,70 +116,199 @@
 }
 
 - (void)dealloc {
-    
+    pthread_mutex_destroy(&_mutex);
 }
 
-- (void)registerListener:(id)listener analyticsClassName:(NSString*)analyticsClassName handler:(AnalyticsHandler)block {
+- (void)registerListener:(id)listener analyticsClass:(Class)analyticsClass handler:(AnalyticsHandler)block {
+    [self registerListener:listener analyticsClassName:NSStringFromClass(analyticsClass) handler:block];
+}
 
+- (void)registerListener:(id)listener analyticsClassName:(NSString*)analyticsClassName handler:(AnalyticsHandler)block {
     id<NSCopying> listenerKey = [self instanceToKey:listener];
-    NSMutableSet<NSString*> *classSet = _listenersDict[listenerKey];   // Get the class set for this particular listener
+    OwnerHandlerTuple *tuple = [[OwnerHandlerTuple alloc] initWithOwner:listener handler:block];
+
+    pthread_mutex_lock(&_mutex);
+    NSMutableSet<NSString*> *classSet = self.listenersDict[listenerKey];   // Get the class set for this particular listener
     if (classSet == nil) {
         classSet = [NSMutableSet setWithObject:analyticsClassName];
         self.listenersDict[listenerKey] = classSet;
     } else {
         [classSet addObject:analyticsClassName]; // Since a set is unique, when isEqual: is called on each member, strings are treated as strings, not object pointers for the comparison.
     }
-    
-    // Now add the handler to the handlersDict
-    OwnerHandlerTuple *tuple = [[OwnerHandlerTuple alloc] initWithOwner:listener handler:block];
-    NSMutableArray<OwnerHandlerTuple*> *workArray = _handlersDict[analyticsClassName];
-    if (workArray == nil) {
-        workArray = [[NSMutableArray<OwnerHandlerTuple*> alloc] init];
-        _handlersDict[analyticsClassName] = workArray;
-    }
-    [workArray addObject:tuple];
+
+    // Now add the handler to the class entry
+    StateChangeClassEntry *entry = [self entryForClassName:analyticsClassName create:YES];
+    entry.handlers = [entry.handlers arrayByAddingObject:tuple];
+    pthread_mutex_unlock(&_mutex);
 }
 
 - (void)unregisterListener:(id)listener {
     id<NSCopying> listenerKey = [self instanceToKey:listener];
 
-    NSMutableSet<NSString*> *theClassNames = _listenersDict[listenerKey];
-    for(NSString *classname in theClassNames) {
-        [self unregisterListener:listener forClassName:classname];
+    pthread_mutex_lock(&_mutex);
+    NSSet<NSString*> *theClassNames = self.listenersDict[listenerKey];
+    for (NSString *classname in theClassNames) {
+        [self removeListenerKey:listenerKey forClassName:classname];
     }
-    [_listenersDict removeObjectForKey:listenerKey];
+    [self.listenersDict removeObjectForKey:listenerKey];
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)unregisterListener:(id)listener forClass:(Class)analyticsClass {
+    [self unregisterListener:listener forClassName:NSStringFromClass(analyticsClass)];
 }
 
 - (void)unregisterListener:(id)listener forClassName:(NSString*)analyticsClassNane {
-    // Iterate in any order. We are removing unique entries.
     id<NSCopying> listenerKey = [self instanceToKey:listener];
-     NSMutableArray<OwnerHandlerTuple*> *handlersList = _handlersDict[analyticsClassNane];
-     NSMutableArray *removeObjects = [[NSMutableArray alloc] init];
-     for (OwnerHandlerTuple *tuple in handlersList) {
-         if ([(NSObject*)tuple.ownerKey isEqual:listenerKey]) {
-             [removeObjects addObject:tuple];
-         }
-     }
-     [handlersList removeObjectsInArray:removeObjects];
-    if (handlersList.count == 0) {
-        [_handlersDict removeObjectForKey:analyticsClassNane];
-    } else {
-        _handlersDict[analyticsClassNane] = handlersList;
+
+    pthread_mutex_lock(&_mutex);
+    [self removeListenerKey:listenerKey forClassName:analyticsClassNane];
+    NSMutableSet<NSString*> *classSet = self.listenersDict[listenerKey];
+    [classSet removeObject:analyticsClassNane];
+    if (classSet.count == 0) {
+        [self.listenersDict removeObjectForKey:listenerKey];
     }
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)setMinimumInterval:(NSTimeInterval)interval forClass:(Class)analyticsClass {
+    [self setMinimumInterval:interval forClassName:NSStringFromClass(analyticsClass)];
+}
+
+- (void)setMinimumInterval:(NSTimeInterval)interval forClassName:(NSString*)analyticsClassName {
+    pthread_mutex_lock(&_mutex);
+    StateChangeClassEntry *entry = [self entryForClassName:analyticsClassName create:(interval > 0)];
+    entry.minimumInterval = MAX(interval, 0);
+    if ([entry isUnused]) {
+        [self removeEntryForClassName:analyticsClassName];
+    }
+    pthread_mutex_unlock(&_mutex);
 }
 
 - (id<NSCopying>)instanceToKey:(id)listener {
     return @((long long) listener);
 }
 
+#pragma mark - Registry, called with the mutex held
+
+// Moves the handlers parked under the name of a class that can now be looked up into its class entry, merging
+// them into the entry when the class was registered on its own already. Returns the class entry.
+- (StateChangeClassEntry *)resolveEntryForClass:(Class)analyticsClass className:(NSString*)analyticsClassName {
+    StateChangeClassEntry *entry = self.handlersByClass[(id<NSCopying>)analyticsClass];
+    StateChangeClassEntry *unresolvedEntry = self.unresolvedHandlers[analyticsClassName];
+    if (unresolvedEntry == nil) {
+        return entry;
+    }
+    [self.unresolvedHandlers removeObjectForKey:analyticsClassName];
+    if (entry == nil) {
+        self.handlersByClass[(id<NSCopying>)analyticsClass] = unresolvedEntry;
+        return unresolvedEntry;
+    }
+    entry.handlers = [entry.handlers arrayByAddingObjectsFromArray:unresolvedEntry.handlers];
+    if (entry.minimumInterval <= 0) {
+        entry.minimumInterval = unresolvedEntry.minimumInterval;
+    }
+    return entry;
+}
+
+- (StateChangeClassEntry *)entryForClassName:(NSString*)analyticsClassName create:(BOOL)create {
+    Class analyticsClass = NSClassFromString(analyticsClassName);
+    StateChangeClassEntry *entry = analyticsClass ? [self resolveEntryForClass:analyticsClass className:analyticsClassName] : self.unresolvedHandlers[analyticsClassName];
+    if (entry == nil && create) {
+        entry = [[StateChangeClassEntry alloc] init];
+        if (analyticsClass) {
+            self.handlersByClass[(id<NSCopying>)analyticsClass] = entry;
+        } else {
+            self.unresolvedHandlers[analyticsClassName] = entry;
+            [self.checkedClasses removeAllObjects];
+        }
+    }
+    return entry;
+}
+
+- (void)removeEntryForClassName:(NSString*)analyticsClassName {
+    Class analyticsClass = NSClassFromString(analyticsClassName);
+    if (analyticsClass) {
+        [self.handlersByClass removeObjectForKey:(id<NSCopying>)analyticsClass];
+    } else {
+        [self.unresolvedHandlers removeObjectForKey:analyticsClassName];
+    }
+}
+
+- (void)removeListenerKey:(id<NSCopying>)listenerKey forClassName:(NSString*)analyticsClassName {
+    StateChangeClassEntry *entry = [self entryForClassName:analyticsClassName create:NO];
+    if (entry == nil) {
+        return;
+    }
+    entry.handlers = [entry.handlers filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(OwnerHandlerTuple *tuple, NSDictionary *bindings) {
+        return ![(NSObject*)tuple.ownerKey isEqual:listenerKey];
+    }]];
+    if ([entry isUnused]) {
+        [self removeEntryForClassName:analyticsClassName];
+    }
+}
+
+- (StateChangeClassEntry *)entryForSentClass:(Class)analyticsClass {
+    if (self.unresolvedHandlers.count > 0 && ![self.checkedClasses containsObject:analyticsClass]) {
+        [self.checkedClasses addObject:analyticsClass];
+        return [self resolveEntryForClass:analyticsClass className:NSStringFromClass(analyticsClass)];
+    }
+    return self.handlersByClass[(id<NSCopying>)analyticsClass];
+}
+
+#pragma mark - Delivery
+
 - (void)send:(DUXBetaStateChangeBaseData*)analyticsData {
-    NSString *classname = NSStringFromClass([analyticsData class]);
-    NSMutableArray<OwnerHandlerTuple*> *handlersList = _handlersDict[classname];
-    for (OwnerHandlerTuple *ownerHandler in handlersList) {
-        AnalyticsHandler handler = ownerHandler.handler;
+    NSArray<OwnerHandlerTuple*> *handlers = nil;
+    BOOL scheduleDelivery = NO;
+    NSTimeInterval delay = 0;
+
+    pthread_mutex_lock(&_mutex);
+    StateChangeClassEntry *entry = [self entryForSentClass:[analyticsData class]];
+    if (entry.minimumInterval > 0) {
+        uint64_t now = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+        uint64_t intervalNanoseconds = (uint64_t)(entry.minimumInterval * NSEC_PER_SEC);
+        if (entry.deliveryScheduled) {
+            entry.pendingData = analyticsData;
+        } else if (entry.lastDeliveryTime == 0 || now - entry.lastDeliveryTime >= intervalNanoseconds) {
+            entry.lastDeliveryTime = now;
+            handlers = entry.handlers;
+        } else {
+            entry.pendingData = analyticsData;
+            entry.deliveryScheduled = YES;
+            scheduleDelivery = YES;
+            delay = (double)(entry.lastDeliveryTime + intervalNanoseconds - now) / NSEC_PER_SEC;
+        }
+    } else {
+        handlers = entry.handlers;
+    }
+    pthread_mutex_unlock(&_mutex);
+
+    if (handlers.count > 0) {
         dispatch_async(_syncQueue, ^(){
-            handler(analyticsData);
+            for (OwnerHandlerTuple *ownerHandler in handlers) {
+                ownerHandler.handler(analyticsData);
+            }
         });
+    } else if (scheduleDelivery) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), _syncQueue, ^{
+            [self deliverPendingDataOfEntry:entry];
+        });
+    }
+}
+
+// Runs on the delivery queue.
+- (void)deliverPendingDataOfEntry:(StateChangeClassEntry *)entry {
+    pthread_mutex_lock(&_mutex);
+    DUXBetaStateChangeBaseData *analyticsData = entry.pendingData;
+    NSArray<OwnerHandlerTuple*> *handlers = entry.handlers;
+    entry.pendingData = nil;
+    entry.deliveryScheduled = NO;
+    entry.lastDeliveryTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    pthread_mutex_unlock(&_mutex);
+
+    for (OwnerHandlerTuple *ownerHandler in handlers) {
+        ownerHandler.handler(analyticsData);
     }
 }
 @end
@@ -45,9 +45,13 @@ protocol DUXBetaSwiftBindings {
     func bindRKVOModel(_ target: NSObject, _ selector: Selector, _ observedKeyPaths: String...)
     func bindRKVOModel(_ target: NSObject, _ selector: Selector, _ observedKeyPaths: String)
     func bindRKVOModel(_ target: NSObject, _ selector: Selector, _ observedKeyPaths: [String])
+    func bindRKVOModelCoalesced(_ target: NSObject, _ selector: Selector, _ observedKeyPaths: String...)
+    func bindRKVOModelCoalesced(_ target: NSObject, _ selector: Selector, interval: TimeInterval, _ observedKeyPaths: [String])
     func unbindRKVOModel(_ target: NSObject)
     func bindSDKKey(_ key: DJIKey, _ property: String )
+    func bindSDKKey(_ key: DJIKey, _ property: String, mode: DUXBetaSDKBindMode)
     func checkSDKBindPropertyIsValid(_ propertyName: String)
+    func unbindSDKKey(_ key: DJIKey, _ property: String)
     func unbindSDK(_ target: NSObject)
 }
 
@@ -68,6 +72,14 @@ extension NSObject: DUXBetaSwiftBindings {
         }
     }
     
+    open func bindRKVOModelCoalesced(_ target: NSObject, _ selector: Selector, _ observedKeyPaths: String...) {
+        bindRKVOModelCoalesced(target, selector, interval: 0, observedKeyPaths)
+    }
+    
+    open func bindRKVOModelCoalesced(_ target: NSObject, _ selector: Selector, interval: TimeInterval, _ observedKeyPaths: [String]) {
+        duxbeta_bindCoalescedRKVO(withTarget: target, selector: selector, interval: interval, properties: observedKeyPaths)
+    }
+    
     open func unbindRKVOModel(_ target: NSObject) {
         target.duxbeta_unBindRKVO()
     }
@@ -76,10 +88,18 @@ extension NSObject: DUXBetaSwiftBindings {
         self.duxbeta_bindSDKKey(key, propertyName: property)
     }
     
+    open func bindSDKKey(_ key: DJIKey, _ property: String, mode: DUXBetaSDKBindMode) {
+        self.duxbeta_bindSDKKey(key, propertyName: property, mode: mode)
+    }
+    
     open func checkSDKBindPropertyIsValid(_ propertyName: String) {
         self.duxbeta_checkSDKBindPropertyIsValid(propertyName)
     }
     
+    open func unbindSDKKey(_ key: DJIKey, _ property: String) {
+        self.duxbeta_unBindSDKKey(key, propertyName: property)
+    }
+    
     open func unbindSDK(_ target: NSObject) {
         target.duxbeta_unBindSDK()
     }
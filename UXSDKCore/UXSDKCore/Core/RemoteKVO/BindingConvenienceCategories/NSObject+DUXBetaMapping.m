@@ -26,6 +26,7 @@
 #import "NSObject+DUXBetaMapping.h"
 #import <objc/runtime.h>
 #import <objc/message.h>
+#import <pthread/pthread.h>
 
 typedef NS_ENUM(NSUInteger, DUXBetaPropertyType) {
     // unknown
@@ -74,6 +75,19 @@ typedef NS_ENUM(NSUInteger, DUXBetaPropertyType) {
     DUXBetaPropertyType_NSCustomObject
 };
 
+typedef NS_ENUM(NSUInteger, DUXBetaPropertyConversion) {
+    // the property can't be mapped
+    DUXBetaPropertyConversion_None,
+    // scalar, set with KVC from an NSNumber
+    DUXBetaPropertyConversion_Number,
+    // object, set with KVC when the value is of the property's class
+    DUXBetaPropertyConversion_Object,
+    // C array, union, struct or bit field, set with KVC from an NSValue of the same type
+    DUXBetaPropertyConversion_Value,
+    // class, pointer, selector or block, sent straight to the setter
+    DUXBetaPropertyConversion_Setter
+};
+
 static inline Class NSBlockClass() {
     static Class cls;
     static dispatch_once_t onceToken;
@@ -87,47 +101,93 @@ static inline Class NSBlockClass() {
     return cls;
 }
 
-static inline const char* DUXBetaObjCTypeEncodingFromProperty(objc_property_t property) {
-    unsigned int count = 0;
-    objc_property_attribute_t* attributes = property_copyAttributeList(property, &count);
-    const char *typeEncoding = NULL;
-    
-    for (int i = 0; i < count; i ++) {
-        const char* attributesName = attributes[i].name;
-        if (attributesName[0] == 'T') {
-            typeEncoding = attributes[i].value;
-            return typeEncoding;
-        }
+static Class DUXBetaClassFromAttributeValue(const char *attributesValue) {
+    size_t len = strlen(attributesValue);
+    if (len > 3) {
+        char name[len - 2];
+        name[len - 3] = '\0';
+        memcpy(name, attributesValue + 2, len - 3);
+        Class cls = objc_getClass(name);
+        return cls;
     }
-    
-    return typeEncoding;
+    return nil;
 }
 
-@interface DUXBetaBaseWidgetModelProperty : NSObject
-@property (nonatomic) DUXBetaPropertyType propertyType;
-@property (nonatomic) const char* objcType;
-@property (nonatomic, copy) NSString* ivarName;
-@property (nonatomic, copy) NSString* setterName;
-@end
-@implementation DUXBetaBaseWidgetModelProperty
-@end
-
-static void* kDUXBetaBaseWidgetModelMappingKey = &kDUXBetaBaseWidgetModelMappingKey;
-
-@implementation NSObject (DUXBetaMapping)
+static DUXBetaPropertyType DUXBetaPropertyTypeFromClass(Class cls) {
+    if (!cls) return  DUXBetaPropertyType_Unknown;
+    if ([cls isSubclassOfClass:[NSString class]]) return  DUXBetaPropertyType_NSString;
+    if ([cls isSubclassOfClass:[NSMutableString class]]) return  DUXBetaPropertyType_NSMutableString;
+    if ([cls isSubclassOfClass:[NSDecimalNumber class]]) return  DUXBetaPropertyType_NSDecimalNumber;
+    if ([cls isSubclassOfClass:[NSNumber class]]) return  DUXBetaPropertyType_NSNumber;
+    if ([cls isSubclassOfClass:[NSValue class]]) return  DUXBetaPropertyType_NSValue;
+    if ([cls isSubclassOfClass:[NSMutableData class]]) return  DUXBetaPropertyType_NSMutableData;
+    if ([cls isSubclassOfClass:[NSData class]]) return  DUXBetaPropertyType_NSData;
+    if ([cls isSubclassOfClass:[NSDate class]]) return  DUXBetaPropertyType_NSDate;
+    if ([cls isSubclassOfClass:[NSURL class]]) return  DUXBetaPropertyType_NSURL;
+    if ([cls isSubclassOfClass:[NSMutableArray class]]) return  DUXBetaPropertyType_NSMutableArray;
+    if ([cls isSubclassOfClass:[NSArray class]]) return  DUXBetaPropertyType_NSArray;
+    if ([cls isSubclassOfClass:[NSMutableDictionary class]]) return  DUXBetaPropertyType_NSMutableDictionary;
+    if ([cls isSubclassOfClass:[NSDictionary class]]) return  DUXBetaPropertyType_NSDictionary;
+    if ([cls isSubclassOfClass:[NSMutableSet class]]) return  DUXBetaPropertyType_NSMutableSet;
+    if ([cls isSubclassOfClass:[NSSet class]]) return  DUXBetaPropertyType_NSSet;
+    return  DUXBetaPropertyType_NSCustomObject;
+}
 
-- (void)duxbeta_setCustomMappingValue:(id)value forKey:(NSString *)key {
-    if (!value || [value isEqual:[NSNull null]] || key.length == 0) {
-        return;
+static DUXBetaPropertyType DUXBetaPropertyTypeFromAttributeValue(const char *attributesValue) {
+    size_t len = strlen(attributesValue);
+    if (len == 0 ) {
+        return DUXBetaPropertyType_Unknown;
+    }
+    switch (*attributesValue) {
+        case 'v': return  DUXBetaPropertyType_Void;
+        case 'B': return  DUXBetaPropertyType_Bool;
+        case 'c': return  DUXBetaPropertyType_Int8;
+        case 'C': return  DUXBetaPropertyType_UInt8;
+        case 's': return  DUXBetaPropertyType_Int16;
+        case 'S': return  DUXBetaPropertyType_UInt16;
+        case 'i': return  DUXBetaPropertyType_Int32;
+        case 'I': return  DUXBetaPropertyType_UInt32;
+        case 'l': return  DUXBetaPropertyType_Int32;
+        case 'L': return  DUXBetaPropertyType_UInt32;
+        case 'q': return  DUXBetaPropertyType_Int64;
+        case 'Q': return  DUXBetaPropertyType_UInt64;
+        case 'f': return  DUXBetaPropertyType_Float;
+        case 'd': return  DUXBetaPropertyType_Double;
+        case 'D': return  DUXBetaPropertyType_LongDouble;
+        case '#': return  DUXBetaPropertyType_Class;
+        case '^': return  DUXBetaPropertyType_Pointer;
+        case ':': return  DUXBetaPropertyType_Selector;
+        case '*': return  DUXBetaPropertyType_CFString;
+        case '[': return  DUXBetaPropertyType_CFArray;
+        case '(': return  DUXBetaPropertyType_CFUnion;
+        case '{': return  DUXBetaPropertyType_CFStruct;
+        case 'b': return  DUXBetaPropertyType_CFBitFiled;
+        case '@':{
+            if (len == 2 && *(attributesValue + 1) == '?') {
+                return DUXBetaPropertyType_Block;
+            }
+            else {
+                if (len == 1) {
+                    return DUXBetaPropertyType_Id;
+                }
+                //Other ObjC object types except blocks and ID types
+                Class cls = DUXBetaClassFromAttributeValue(attributesValue);
+                if (cls) {
+                    return DUXBetaPropertyTypeFromClass(cls);
+                }
+                return DUXBetaPropertyType_Id;
+            }
+        default:
+            return DUXBetaPropertyType_Unknown;
+        }
     }
-    DUXBetaBaseWidgetModelProperty* property = [self propertyTypeFromPropertyName:key];
-    DUXBetaPropertyType propertyType = property.propertyType;
+}
+
+static DUXBetaPropertyConversion DUXBetaPropertyConversionFromType(DUXBetaPropertyType propertyType) {
     switch (propertyType) {
         case DUXBetaPropertyType_Unknown:
-        case DUXBetaPropertyType_Void:{
-            NSAssert(0, @"the property type unknown ..");
-            return;
-        }
+        case DUXBetaPropertyType_Void:
+            return DUXBetaPropertyConversion_None;
         case DUXBetaPropertyType_Bool:
         case DUXBetaPropertyType_Int8:
         case DUXBetaPropertyType_UInt8:
@@ -139,15 +199,8 @@ static void* kDUXBetaBaseWidgetModelMappingKey = &kDUXBetaBaseWidgetModelMapping
         case DUXBetaPropertyType_UInt64:
         case DUXBetaPropertyType_Float:
         case DUXBetaPropertyType_Double:
-        case DUXBetaPropertyType_LongDouble: {
-            if ([value isKindOfClass:[NSNumber class]]) {
-                [self setValue:value forKey:key];
-            }
-            else {
-                NSAssert(0, @"the property's type does not match ..");
-            }
-        }
-            break;
+        case DUXBetaPropertyType_LongDouble:
+            return DUXBetaPropertyConversion_Number;
         case DUXBetaPropertyType_Id:
         case DUXBetaPropertyType_NSString:
         case DUXBetaPropertyType_NSMutableString:
@@ -164,9 +217,131 @@ static void* kDUXBetaBaseWidgetModelMappingKey = &kDUXBetaBaseWidgetModelMapping
         case DUXBetaPropertyType_NSMutableDictionary:
         case DUXBetaPropertyType_NSSet:
         case DUXBetaPropertyType_NSMutableSet:
-        case DUXBetaPropertyType_NSCustomObject: {
-            Class cls = [self customObjectClassFromAttributesValue:property.objcType];
-            if (cls && [value isKindOfClass:cls]) {
+        case DUXBetaPropertyType_NSCustomObject:
+            return DUXBetaPropertyConversion_Object;
+        case DUXBetaPropertyType_CFArray:
+        case DUXBetaPropertyType_CFUnion:
+        case DUXBetaPropertyType_CFBitFiled:
+        case DUXBetaPropertyType_CFStruct:
+            return DUXBetaPropertyConversion_Value;
+        case DUXBetaPropertyType_Class:
+        case DUXBetaPropertyType_Pointer:
+        case DUXBetaPropertyType_Selector:
+        case DUXBetaPropertyType_CFString:
+        case DUXBetaPropertyType_Block:
+            return DUXBetaPropertyConversion_Setter;
+    }
+}
+
+/**
+ *  Everything the mapping needs to know about one property of one class. Built once per class and property name
+ *  and shared by every instance of that class.
+ */
+@interface DUXBetaBaseWidgetModelProperty : NSObject
+@property (nonatomic) DUXBetaPropertyType propertyType;
+@property (nonatomic) DUXBetaPropertyConversion conversion;
+// Owned copy of the property's type encoding.
+@property (nonatomic) const char* objcType;
+// Class the value must be a kind of, when the property is an object of a known class.
+@property (nonatomic, assign) Class objectClass;
+@property (nonatomic) SEL setterSelector;
+@end
+
+@implementation DUXBetaBaseWidgetModelProperty
+
+- (void)dealloc {
+    free((void *)_objcType);
+}
+
+@end
+
+static DUXBetaBaseWidgetModelProperty *DUXBetaReflectProperty(Class cls, NSString *propertyName) {
+    DUXBetaBaseWidgetModelProperty* property = [[DUXBetaBaseWidgetModelProperty alloc] init];
+    NSString *setterName = [NSString stringWithFormat:@"set%@%@:",[propertyName substringToIndex:1].uppercaseString,[propertyName substringFromIndex:1]];
+    objc_property_t p = class_getProperty(cls, propertyName.UTF8String);
+    if (p != NULL) {
+        unsigned int count = 0;
+        objc_property_attribute_t* attributes = property_copyAttributeList(p, &count);
+        for (unsigned int i = 0; i < count; i ++) {
+            const char* attributesName = attributes[i].name;
+            const char* attributeValue = attributes[i].value;
+            switch (attributesName[0]) {
+                // Type
+                case 'T': {
+                    property.propertyType = DUXBetaPropertyTypeFromAttributeValue(attributeValue);
+                    property.objcType = strdup(attributeValue);
+                    if (attributeValue[0] == '@') {
+                        property.objectClass = DUXBetaClassFromAttributeValue(attributeValue);
+                    }
+                }
+                    break;
+                // Setter
+                case 'S': {
+                    if (attributeValue) {
+                        setterName = [NSString stringWithUTF8String:attributeValue];
+                    }
+                }
+                    break;
+                default:break;
+            }
+        }
+        free(attributes);
+    }
+    property.conversion = DUXBetaPropertyConversionFromType(property.propertyType);
+    property.setterSelector = NSSelectorFromString(setterName);
+    return property;
+}
+
+static pthread_rwlock_t DUXBetaPropertyCacheLock = PTHREAD_RWLOCK_INITIALIZER;
+static NSMapTable *DUXBetaPropertyCache = nil;
+
+/**
+ *  Process wide cache, keyed by the runtime class of the instance and the property name. Reflection only runs the
+ *  first time a class maps a property.
+ */
+static DUXBetaBaseWidgetModelProperty *DUXBetaCachedProperty(Class cls, NSString *propertyName) {
+    DUXBetaBaseWidgetModelProperty *property = nil;
+    pthread_rwlock_rdlock(&DUXBetaPropertyCacheLock);
+    property = [DUXBetaPropertyCache objectForKey:cls][propertyName];
+    pthread_rwlock_unlock(&DUXBetaPropertyCacheLock);
+    if (property) {
+        return property;
+    }
+    
+    property = DUXBetaReflectProperty(cls, propertyName);
+    
+    pthread_rwlock_wrlock(&DUXBetaPropertyCacheLock);
+    if (DUXBetaPropertyCache == nil) {
+        DUXBetaPropertyCache = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    NSMutableDictionary<NSString *, DUXBetaBaseWidgetModelProperty *> *classProperties = [DUXBetaPropertyCache objectForKey:cls];
+    if (classProperties == nil) {
+        classProperties = [[NSMutableDictionary alloc] init];
+        [DUXBetaPropertyCache setObject:classProperties forKey:cls];
+    }
+    if (classProperties[propertyName]) {
+        property = classProperties[propertyName];
+    } else {
+        classProperties[propertyName] = property;
+    }
+    pthread_rwlock_unlock(&DUXBetaPropertyCacheLock);
+    return property;
+}
+
+@implementation NSObject (DUXBetaMapping)
+
+- (void)duxbeta_setCustomMappingValue:(id)value forKey:(NSString *)key {
+    if (!value || [value isEqual:[NSNull null]] || key.length == 0) {
+        return;
+    }
+    DUXBetaBaseWidgetModelProperty* property = DUXBetaCachedProperty(object_getClass(self), key);
+    switch (property.conversion) {
+        case DUXBetaPropertyConversion_None: {
+            NSAssert(0, @"the property type unknown ..");
+            return;
+        }
+        case DUXBetaPropertyConversion_Number: {
+            if ([value isKindOfClass:[NSNumber class]]) {
                 [self setValue:value forKey:key];
             }
             else {
@@ -174,37 +349,21 @@ static void* kDUXBetaBaseWidgetModelMappingKey = &kDUXBetaBaseWidgetModelMapping
             }
         }
             break;
-        case DUXBetaPropertyType_Class:
-        case DUXBetaPropertyType_Pointer:
-        case DUXBetaPropertyType_Selector:
-        case DUXBetaPropertyType_CFString:
-        case DUXBetaPropertyType_CFArray:
-        case DUXBetaPropertyType_CFUnion:
-        case DUXBetaPropertyType_CFBitFiled:
-        case DUXBetaPropertyType_CFStruct:
-        case DUXBetaPropertyType_Block: [self internalSetCustomValueWithMsgSend:value forKey:key property:property];
+        case DUXBetaPropertyConversion_Object: {
+            Class cls = property.objectClass;
+            if (cls && [value isKindOfClass:cls]) {
+                [self setValue:value forKey:key];
+            }
+            else {
+                NSAssert(0, @"the property's type does not match ..");
+            }
+        }
             break;
-    }
-}
-
-- (void)internalSetCustomValueWithMsgSend:(id)value forKey:(NSString *)key property:(DUXBetaBaseWidgetModelProperty *)property {
-    SEL setterSelector = NSSelectorFromString(property.setterName);
-    BOOL isNull = (value == (id)kCFNull);
-    switch (property.propertyType) {
-        case DUXBetaPropertyType_CFArray:
-        case DUXBetaPropertyType_CFUnion:
-        case DUXBetaPropertyType_CFBitFiled:
-        case DUXBetaPropertyType_CFStruct: {
+        case DUXBetaPropertyConversion_Value: {
             if ([value isKindOfClass:[NSValue class]]) {
                 const char* valueType = ((NSValue *)value).objCType;
-                // Invert how property.ivarName is created, remove _ prefix
-                NSString *propertyName = [[property.ivarName mutableCopy] substringFromIndex:1];
-                objc_property_t propertyStructure = class_getProperty([self class], [propertyName UTF8String]);
-                const char* metaType = DUXBetaObjCTypeEncodingFromProperty(propertyStructure);
-                if (metaType != NULL) {
-                    if (valueType && strcmp(valueType, metaType) == 0) {
-                        [self setValue:value forKey:key];
-                    }
+                if (property.objcType != NULL && valueType && strcmp(valueType, property.objcType) == 0) {
+                    [self setValue:value forKey:key];
                 }
             }
             else {
@@ -212,28 +371,35 @@ static void* kDUXBetaBaseWidgetModelMappingKey = &kDUXBetaBaseWidgetModelMapping
             }
         }
             break;
+        case DUXBetaPropertyConversion_Setter: [self internalSetCustomValueWithSetter:value property:property];
+            break;
+    }
+}
+
+- (void)internalSetCustomValueWithSetter:(id)value property:(DUXBetaBaseWidgetModelProperty *)property {
+    // Only the selector is cached, the setter is always sent as a message so KVO and overriding setters run.
+    SEL setterSelector = property.setterSelector;
+    BOOL isNull = (value == (id)kCFNull);
+    switch (property.propertyType) {
         case DUXBetaPropertyType_Class: {
+            void (* setterPtr) (id, SEL, Class) = (void (*)(id, SEL, Class))objc_msgSend;
             if (isNull) {
-                void (* msgSendPtr) (id, SEL, Class) = (void (*)(id, SEL, Class))objc_msgSend;
-                msgSendPtr((id)self, setterSelector,(Class) NULL);
+                setterPtr((id)self, setterSelector,(Class) NULL);
             }
             else {
                 if ([value isKindOfClass:[NSString class]]) {
                     Class cls = NSClassFromString(value);
                     if (cls) {
-                        void (* msgSendPtr) (id, SEL,Class) = (void (*)(id, SEL, Class))objc_msgSend;
-                        msgSendPtr(self, setterSelector,(Class)cls);
+                        setterPtr(self, setterSelector,(Class)cls);
                     }
                 }
                 else {
                     Class cls = object_getClass(value);
                     if (cls) {
                         if (class_isMetaClass(cls)) {
-                            void (* msgSendPtr) (id, SEL,Class) = (void (*)(id, SEL, Class))objc_msgSend;
-                            msgSendPtr(self, setterSelector,(Class)value);
+                            setterPtr(self, setterSelector,(Class)value);
                         } else {
-                            void (* msgSendPtr) (id, SEL,Class) = (void (*)(id, SEL, Class))objc_msgSend;
-                            msgSendPtr(self, setterSelector,(Class)cls);
+                            setterPtr(self, setterSelector,(Class)cls);
                         }
                     }
                 }
@@ -242,15 +408,14 @@ static void* kDUXBetaBaseWidgetModelMappingKey = &kDUXBetaBaseWidgetModelMapping
             break;
         case DUXBetaPropertyType_CFString:
         case DUXBetaPropertyType_Pointer: {
+            void (* setterPtr) (id, SEL, void *) = (void (*)(id, SEL, void *))objc_msgSend;
             if (isNull) {
-                void (* msgSendPtr)(id, SEL,void *) = (void (*)(id, SEL,void*))objc_msgSend;
-                msgSendPtr(self, setterSelector, (void *)NULL);
+                setterPtr(self, setterSelector, (void *)NULL);
             }
             else if ([value isKindOfClass:[NSValue class]]) {
                 NSValue* nsValue = value;
                 if (nsValue.objCType && strcmp(nsValue.objCType, "^v") == 0) {
-                    void (* msgSendPtr) (id, SEL, void *) = (void (*)(id, SEL, void *))objc_msgSend;
-                    msgSendPtr(self, setterSelector,nsValue.pointerValue);
+                    setterPtr(self, setterSelector,nsValue.pointerValue);
                 }
             }
             else {
@@ -259,15 +424,14 @@ static void* kDUXBetaBaseWidgetModelMappingKey = &kDUXBetaBaseWidgetModelMapping
         }
             break;
         case DUXBetaPropertyType_Selector: {
+            void (* setterPtr) (id, SEL, SEL) = (void (*)(id, SEL, SEL))objc_msgSend;
             if (isNull) {
-                void (* msgSendPtr)(id, SEL,SEL) = (void (*)(id, SEL, SEL))objc_msgSend;
-                msgSendPtr(self,setterSelector,(SEL)NULL);
+                setterPtr(self,setterSelector,(SEL)NULL);
             }
             else if ([value isKindOfClass:[NSString class]]) {
                 SEL theSel = NSSelectorFromString(value);
                 if (theSel) {
-                    void (*msgSendPtr)(id, SEL, SEL) = (void (*)(id, SEL, SEL))objc_msgSend;
-                    msgSendPtr(self,setterSelector,theSel);
+                    setterPtr(self,setterSelector,theSel);
                 }
             }
             else {
@@ -276,12 +440,11 @@ static void* kDUXBetaBaseWidgetModelMappingKey = &kDUXBetaBaseWidgetModelMapping
         }
             break;
         case DUXBetaPropertyType_Block: {
+            void (* setterPtr) (id, SEL, void (^)(void)) = (void (*)(id, SEL, void (^)(void)))objc_msgSend;
             if (isNull) {
-                void (* msgSendPtr) (id, SEL, void (^)(void)) = (void (*)(id, SEL, void (^)(void)))objc_msgSend;
-                msgSendPtr(self,setterSelector, (void (^)(void))NULL);
+                setterPtr(self,setterSelector, (void (^)(void))NULL);
             } else if ([value isKindOfClass:NSBlockClass()]) {
-                void (* msgSendPtr) (id, SEL, void (^)(void)) = (void (*)(id, SEL, void (^)(void)))objc_msgSend;
-                msgSendPtr(self, setterSelector,(void (^)(void))value);
+                setterPtr(self, setterSelector,(void (^)(void))value);
             }
             else {
                 NSAssert(0, @"the property's type does not match ..");
@@ -292,143 +455,6 @@ static void* kDUXBetaBaseWidgetModelMappingKey = &kDUXBetaBaseWidgetModelMapping
     }
 }
 
-- (DUXBetaBaseWidgetModelProperty *)propertyTypeFromPropertyName:(NSString *)propertyName {
-    //If we already have cached values
-    if ([self.propertyTypeMap objectForKey:propertyName]) {
-        return [self.propertyTypeMap objectForKey:propertyName];
-    }
-    //No cached values
-    DUXBetaBaseWidgetModelProperty* property = [[DUXBetaBaseWidgetModelProperty alloc] init];
-    objc_property_t p = class_getProperty([self class],propertyName.UTF8String);
-    property.setterName = [NSString stringWithFormat:@"set%@%@:",[propertyName substringToIndex:1].uppercaseString,[propertyName substringFromIndex:1]];
-    property.ivarName = [NSString stringWithFormat:@"_%@",propertyName];
-    unsigned int count = 0;
-    objc_property_attribute_t* attributes = property_copyAttributeList(p, &count);
-    for (int i = 0; i < count; i ++) {
-        const char* attributesName = attributes[i].name;
-        switch (attributesName[0]) {
-            // Type
-            case 'T': {
-                const char* attributeValue = attributes[i].value;
-                DUXBetaPropertyType propertyType = [self typeFromPropertyAttributeValue:attributeValue];
-                property.propertyType = propertyType;
-                property.objcType = attributeValue;
-            }
-                break;
-            // Setter
-            case 'S': {
-                const char* attributeValue = attributes[i].value;
-                if (attributeValue) {
-                    property.setterName = [NSString stringWithUTF8String:attributeValue];
-                }
-            }
-                break;
-            // IVar
-            case 'V': {
-                const char* attributeValue = attributes[i].value;
-                if (attributeValue) {
-                    property.ivarName = [NSString stringWithUTF8String:attributeValue];
-                }
-            }
-                break;
-            default:break;
-        }
-    }
-    [self.propertyTypeMap setObject:property forKey:propertyName];
-    return property;
-}
-
-- (NSMutableDictionary *)propertyTypeMap {
-    NSMutableDictionary* propertyTypeMap = objc_getAssociatedObject(self, kDUXBetaBaseWidgetModelMappingKey);
-    if (!propertyTypeMap) {
-        propertyTypeMap = [[NSMutableDictionary alloc] init];
-        objc_setAssociatedObject(self, kDUXBetaBaseWidgetModelMappingKey, propertyTypeMap, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
-    }
-    return propertyTypeMap;
-}
-
-- (DUXBetaPropertyType)typeFromPropertyAttributeValue:(const char *)attributesValue {
-    size_t len = strlen(attributesValue);
-    if (len == 0 ) {
-        return DUXBetaPropertyType_Unknown;
-    }
-    switch (*attributesValue) {
-        case 'v': return  DUXBetaPropertyType_Void;
-        case 'B': return  DUXBetaPropertyType_Bool;
-        case 'c': return  DUXBetaPropertyType_Int8;
-        case 'C': return  DUXBetaPropertyType_UInt8;
-        case 's': return  DUXBetaPropertyType_Int16;
-        case 'S': return  DUXBetaPropertyType_UInt16;
-        case 'i': return  DUXBetaPropertyType_Int32;
-        case 'I': return  DUXBetaPropertyType_UInt32;
-        case 'l': return  DUXBetaPropertyType_Int32;
-        case 'L': return  DUXBetaPropertyType_UInt32;
-        case 'q': return  DUXBetaPropertyType_Int64;
-        case 'Q': return  DUXBetaPropertyType_UInt64;
-        case 'f': return  DUXBetaPropertyType_Float;
-        case 'd': return  DUXBetaPropertyType_Double;
-        case 'D': return  DUXBetaPropertyType_LongDouble;
-        case '#': return  DUXBetaPropertyType_Class;
-        case '^': return  DUXBetaPropertyType_Pointer;
-        case ':': return  DUXBetaPropertyType_Selector;
-        case '*': return  DUXBetaPropertyType_CFString;
-        case '[': return  DUXBetaPropertyType_CFArray;
-        case '(': return  DUXBetaPropertyType_CFUnion;
-        case '{': return  DUXBetaPropertyType_CFStruct;
-        case 'b': return  DUXBetaPropertyType_CFBitFiled;
-        case '@':{
-            if (len == 2 && *(attributesValue + 1) == '?') {
-                return DUXBetaPropertyType_Block;
-            }
-            else {
-                if (len == 1) {
-                    return DUXBetaPropertyType_Id;
-                }
-                //Other ObjC object types except blocks and ID types
-                Class cls = [self customObjectClassFromAttributesValue:attributesValue];
-                if (cls) {
-                    return [self propertyTypeFromClass:cls];
-                }
-                return DUXBetaPropertyType_Id;
-            }
-        default:
-            return DUXBetaPropertyType_Unknown;
-        }
-    }
-}
-
-- (Class)customObjectClassFromAttributesValue:(const char*)attributesValue {
-    size_t len = strlen(attributesValue);
-    if (len > 3) {
-        char name[len - 2];
-        name[len - 3] = '\0';
-        memcpy(name, attributesValue + 2, len - 3);
-        Class cls = objc_getClass(name);
-        return cls;
-    }
-    return nil;
-}
-
-- (DUXBetaPropertyType)propertyTypeFromClass:(Class)cls {
-    if (!cls) return  DUXBetaPropertyType_Unknown;
-    if ([cls isSubclassOfClass:[NSString class]]) return  DUXBetaPropertyType_NSString;
-    if ([cls isSubclassOfClass:[NSMutableString class]]) return  DUXBetaPropertyType_NSMutableString;
-    if ([cls isSubclassOfClass:[NSDecimalNumber class]]) return  DUXBetaPropertyType_NSDecimalNumber;
-    if ([cls isSubclassOfClass:[NSNumber class]]) return  DUXBetaPropertyType_NSNumber;
-    if ([cls isSubclassOfClass:[NSValue class]]) return  DUXBetaPropertyType_NSValue;
-    if ([cls isSubclassOfClass:[NSMutableData class]]) return  DUXBetaPropertyType_NSMutableData;
-    if ([cls isSubclassOfClass:[NSData class]]) return  DUXBetaPropertyType_NSData;
-    if ([cls isSubclassOfClass:[NSDate class]]) return  DUXBetaPropertyType_NSDate;
-    if ([cls isSubclassOfClass:[NSURL class]]) return  DUXBetaPropertyType_NSURL;
-    if ([cls isSubclassOfClass:[NSMutableArray class]]) return  DUXBetaPropertyType_NSMutableArray;
-    if ([cls isSubclassOfClass:[NSArray class]]) return  DUXBetaPropertyType_NSArray;
-    if ([cls isSubclassOfClass:[NSMutableDictionary class]]) return  DUXBetaPropertyType_NSMutableDictionary;
-    if ([cls isSubclassOfClass:[NSDictionary class]]) return  DUXBetaPropertyType_NSDictionary;
-    if ([cls isSubclassOfClass:[NSMutableSet class]]) return  DUXBetaPropertyType_NSMutableSet;
-    if ([cls isSubclassOfClass:[NSSet class]]) return  DUXBetaPropertyType_NSSet;
-    return  DUXBetaPropertyType_NSCustomObject;
-}
-
 - (NSString *)propetyTypeNameWithType:(DUXBetaPropertyType)type {
     switch (type) {
         case DUXBetaPropertyType_Unknown:return @"DUXBetaPropertyType_Unknown";
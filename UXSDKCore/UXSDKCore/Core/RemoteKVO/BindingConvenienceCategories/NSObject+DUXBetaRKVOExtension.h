@@ -32,6 +32,8 @@ NS_ASSUME_NONNULL_BEGIN
  *  Use this class as a parameter to your selector in your bindRKVO call in order to determine what keyPath
  *  changed and what the old and new values are.  This is useful in an instance where you need to run some logic
  *  that depends on a certain order of values.
+ *  Every call is handed a transform of its own, so it can be kept. Bindings to a selector without a parameter
+ *  skip the transform and do not allocate per update.
  */
 
 @interface DUXBetaRKVOTransform : NSObject
@@ -65,6 +67,19 @@ typeof(__target__) __id_temp_target__ = __target__; \
 #endif
 
 
+/**
+ *  Same as BindRKVOModel, but updates of the listed properties are collapsed into one selector call at the next
+ *  turn of the main run loop. Use it when many properties feed a single state recompute.
+ */
+
+#ifndef BindRKVOModelCoalesced
+#define BindRKVOModelCoalesced(__target__, __SELECTOR__, ...) \
+{\
+typeof(__target__) __id_temp_target__ = __target__; \
+[__target__ duxbeta_bindCoalescedRKVOWithTarget:self selector:__SELECTOR__ interval:0 properties:@[metamacro_foreach(SelfKeypath, , __VA_ARGS__)]]; \
+}
+#endif
+
 #ifndef UnBindRKVOModel
 #define UnBindRKVOModel(__target__) [__target__ duxbeta_unBindRKVO]
 #endif
@@ -102,6 +117,22 @@ typeof(__target__) __id_temp_target__ = __target__; \
 
 - (void)duxbeta_bindRKVOWithTarget:(id)target selector:(SEL)selector propertiesList:(va_list)properties;
 
+/**
+ *  Bind a target and its properties' keyPaths to a selector, coalescing updates. However many of the properties
+ *  change, the selector is called once on the main queue, at the next turn of the run loop when interval is 0 or
+ *  after interval seconds otherwise. It is also called once right away with the current values. A selector taking a
+ *  DUXBetaRKVOTransform receives the last change.
+ */
+
+- (void)duxbeta_bindCoalescedRKVOWithTarget:(id)target selector:(SEL)selector interval:(NSTimeInterval)interval properties:(NSArray<NSString *> *)properties;
+
+/**
+ *  Immediately calls the selectors of coalesced bindings that have pending updates, instead of waiting for them to
+ *  be scheduled. Meant for tests.
+ */
+
+- (void)duxbeta_flushCoalescedRKVO;
+
 /**
  *  UnBind all keypaths with the current target.
  */
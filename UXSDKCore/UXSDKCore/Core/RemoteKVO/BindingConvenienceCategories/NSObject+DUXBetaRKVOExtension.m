@@ -25,6 +25,13 @@
 
 #import "NSObject+DUXBetaRKVOExtension.h"
 #import "NSObject+DUXBetaCustomKVO.h"
+#import "DUXBetaCustomKeyPath.h"
+#import "DUXBetaBindingInstrumentation.h"
+#import <objc/message.h>
+#import <objc/runtime.h>
+#import <pthread/pthread.h>
+
+static void* kDUXBetaRKVOCoalescersKey = &kDUXBetaRKVOCoalescersKey;
 
 @implementation DUXBetaRKVOTransform
 
@@ -34,42 +41,177 @@
 
 @end
 
-typedef void(^DUXBetaObjectRKVOBindUpdateBlock)(id target , id _Nullable oldValue, id _Nullable newValue);
+/**
+ *  Everything needed to call the bound selector, resolved once when binding. Only the selector and its argument
+ *  count are kept, every update is still sent as a message so KVO and overriding methods on the target run.
+ */
+@interface DUXBetaRKVOInvocationPlan : NSObject
+
+@property (weak, nonatomic) id target;
+@property (assign, nonatomic) SEL selector;
+@property (assign, nonatomic) BOOL respondsToSelector;
+@property (assign, nonatomic) NSUInteger argumentCount;
+
+- (instancetype)initWithTarget:(id)target selector:(SEL)selector;
+- (void)invokeForKeyPath:(NSString *)keyPath oldValue:(id)oldValue newValue:(id)newValue;
+
+@end
+
+@implementation DUXBetaRKVOInvocationPlan
+
+- (instancetype)initWithTarget:(id)target selector:(SEL)selector {
+    self = [super init];
+    _target = target;
+    _selector = selector;
+    _respondsToSelector = [target respondsToSelector:selector];
+    if (_respondsToSelector) {
+        _argumentCount = [[target methodSignatureForSelector:selector] numberOfArguments];
+    }
+    return self;
+}
+
+- (void)invokeForKeyPath:(NSString *)keyPath oldValue:(id)oldValue newValue:(id)newValue {
+    id target = self.target;
+    if (target == nil || !_respondsToSelector) {
+        return;
+    }
+    if (!DUXBetaBindingInstrumentationIsEnabled()) {
+        [self callTarget:target keyPath:keyPath oldValue:oldValue newValue:newValue];
+        return;
+    }
+    
+    DUXBetaBindingInstrumentation *instrumentation = [DUXBetaBindingInstrumentation sharedInstance];
+    uint64_t start = DUXBetaBindingInstrumentationNow();
+    uint64_t updateStart = DUXBetaBindingInstrumentationCurrentUpdateStart();
+    if (updateStart != 0) {
+        [instrumentation recordHop:DUXBetaBindingHopKeyToCallback key:keyPath modelClass:[target class] value:start - updateStart];
+    }
+    [self callTarget:target keyPath:keyPath oldValue:oldValue newValue:newValue];
+    [instrumentation recordHop:DUXBetaBindingHopCallback key:keyPath modelClass:[target class] value:DUXBetaBindingInstrumentationNow() - start];
+}
+
+- (void)callTarget:(id)target keyPath:(NSString *)keyPath oldValue:(id)oldValue newValue:(id)newValue {
+    if (_argumentCount == 2) {
+        ((void (*)(id, SEL))objc_msgSend)(target, _selector);
+        return;
+    }
+    
+    // Every call gets a transform of its own, targets are free to keep it.
+    DUXBetaRKVOTransform *transform = [[DUXBetaRKVOTransform alloc] init];
+    transform.keyPath = keyPath;
+    transform.oldValue = oldValue;
+    transform.updatedValue = newValue;
+    ((void (*)(id, SEL, id))objc_msgSend)(target, _selector, transform);
+}
+
+@end
+
+/**
+ *  Collects updates of several key paths bound to one selector and calls the selector once for all of them, on the
+ *  main queue at the next turn of the run loop or once the interval has passed. The last change is the one handed to
+ *  a selector taking a DUXBetaRKVOTransform.
+ */
+@interface DUXBetaRKVOCoalescer : NSObject
+{
+    pthread_mutex_t _mutex;
+}
+
+@property (strong, nonatomic) DUXBetaRKVOInvocationPlan *plan;
+@property (assign, nonatomic) NSTimeInterval interval;
+@property (assign, nonatomic) BOOL scheduled;
+@property (copy, nonatomic) NSString *lastKeyPath;
+@property (strong, nonatomic) id lastOldValue;
+@property (strong, nonatomic) id lastNewValue;
+
+- (instancetype)initWithPlan:(DUXBetaRKVOInvocationPlan *)plan interval:(NSTimeInterval)interval;
+- (void)markDirtyForKeyPath:(NSString *)keyPath oldValue:(id)oldValue newValue:(id)newValue;
+- (void)flush;
+- (void)cancel;
+
+@end
+
+@implementation DUXBetaRKVOCoalescer
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (instancetype)initWithPlan:(DUXBetaRKVOInvocationPlan *)plan interval:(NSTimeInterval)interval {
+    self = [super init];
+    _plan = plan;
+    _interval = interval;
+    pthread_mutex_init(&_mutex, NULL);
+    return self;
+}
+
+- (void)markDirtyForKeyPath:(NSString *)keyPath oldValue:(id)oldValue newValue:(id)newValue {
+    BOOL shouldSchedule = NO;
+    pthread_mutex_lock(&_mutex);
+    self.lastKeyPath = keyPath;
+    self.lastOldValue = oldValue;
+    self.lastNewValue = newValue;
+    if (!self.scheduled) {
+        self.scheduled = YES;
+        shouldSchedule = YES;
+    }
+    pthread_mutex_unlock(&_mutex);
+    
+    if (shouldSchedule) {
+        __weak typeof(self) weakSelf = self;
+        dispatch_block_t flushBlock = ^{
+            [weakSelf flush];
+        };
+        if (self.interval > 0) {
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.interval * NSEC_PER_SEC)), dispatch_get_main_queue(), flushBlock);
+        } else {
+            dispatch_async(dispatch_get_main_queue(), flushBlock);
+        }
+    }
+}
+
+- (void)flush {
+    pthread_mutex_lock(&_mutex);
+    if (!self.scheduled) {
+        pthread_mutex_unlock(&_mutex);
+        return;
+    }
+    self.scheduled = NO;
+    NSString *keyPath = self.lastKeyPath;
+    id oldValue = self.lastOldValue;
+    id newValue = self.lastNewValue;
+    self.lastKeyPath = nil;
+    self.lastOldValue = nil;
+    self.lastNewValue = nil;
+    pthread_mutex_unlock(&_mutex);
+    
+    [self.plan invokeForKeyPath:keyPath oldValue:oldValue newValue:newValue];
+}
+
+- (void)cancel {
+    pthread_mutex_lock(&_mutex);
+    self.scheduled = NO;
+    self.lastKeyPath = nil;
+    self.lastOldValue = nil;
+    self.lastNewValue = nil;
+    pthread_mutex_unlock(&_mutex);
+}
+
+@end
 
 @implementation NSObject (DUXBetaRKVOExtension)
 
-- (void)setupRKVOKey:(NSString *)key target:(id)target updateBlock:(DUXBetaObjectRKVOBindUpdateBlock)block {
-    NSAssert(block != nil, @"The block to setup cannot be nil. ");
+- (void)setupRKVOKey:(NSString *)key target:(id)target selector:(SEL)selector {
+    DUXBetaRKVOInvocationPlan *plan = [[DUXBetaRKVOInvocationPlan alloc] initWithTarget:target selector:selector];
     [self duxbeta_addCustomObserver:target forKeyPath:key block:^(id  _Nullable oldValue, id  _Nullable newValue) {
-        block(target,oldValue,newValue);
+        [plan invokeForKeyPath:key oldValue:oldValue newValue:newValue];
     }];
-    block(target,[self valueForKeyPath:key],[self valueForKeyPath:key]);
+    id value = [[DUXBetaCustomKeyPath keyPathWithString:key] valueForObject:self];
+    [plan invokeForKeyPath:key oldValue:value newValue:value];
 }
 
 - (void)duxbeta_bindRKVOWithTarget:(id)target selector:(SEL)selector property:(NSString *)property {
     if (property) {
-        [self setupRKVOKey:property target:target updateBlock:^(id target, id  _Nullable oldValue, id  _Nullable newValue) {
-            if ([target respondsToSelector:selector]) {
-                NSMethodSignature* methodSignature = [[target class] instanceMethodSignatureForSelector:selector];
-                NSUInteger argumentNum = [methodSignature numberOfArguments];
-                if (argumentNum == 2) {
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                    [target performSelector:selector];
-    #pragma clang diagnostic pop
-                }
-                else {
-                    DUXBetaRKVOTransform* transform = [[DUXBetaRKVOTransform alloc] init];
-                    transform.keyPath = property;
-                    transform.oldValue = oldValue;
-                    transform.updatedValue = newValue;
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                    [target performSelector:selector withObject:transform];
-    #pragma clang diagnostic pop
-                }
-            }
-        }];
+        [self setupRKVOKey:property target:target selector:selector];
     }
 }
 
@@ -79,28 +221,7 @@ typedef void(^DUXBetaObjectRKVOBindUpdateBlock)(id target , id _Nullable oldValu
     if (properties) {
         NSString* nextArg = properties;
         while(nextArg) {
-            [self setupRKVOKey:nextArg target:target updateBlock:^(id target, id  _Nullable oldValue, id  _Nullable newValue) {
-                if ([target respondsToSelector:selector]) {
-                    NSMethodSignature* methodSignature = [[target class] instanceMethodSignatureForSelector:selector];
-                    NSUInteger argumentNum = [methodSignature numberOfArguments];
-                    if (argumentNum == 2) {
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                        [target performSelector:selector];
-#pragma clang diagnostic pop
-                    }
-                    else {
-                        DUXBetaRKVOTransform* transform = [[DUXBetaRKVOTransform alloc] init];
-                        transform.keyPath = nextArg;
-                        transform.oldValue = oldValue;
-                        transform.updatedValue = newValue;
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                        [target performSelector:selector withObject:transform];
-#pragma clang diagnostic pop
-                    }
-                }
-            }];
+            [self setupRKVOKey:nextArg target:target selector:selector];
             nextArg = va_arg(args, NSString *);
         }
     }
@@ -110,34 +231,57 @@ typedef void(^DUXBetaObjectRKVOBindUpdateBlock)(id target , id _Nullable oldValu
 - (void)duxbeta_bindRKVOWithTarget:(id)target selector:(SEL)selector propertiesList:(va_list)properties {
     NSString* nextArg = va_arg(properties, NSString *);
     while(nextArg) {
-        [self setupRKVOKey:nextArg target:target updateBlock:^(id target, id  _Nullable oldValue, id  _Nullable newValue) {
-            if ([target respondsToSelector:selector]) {
-                NSMethodSignature* methodSignature = [[target class] instanceMethodSignatureForSelector:selector];
-                NSUInteger argumentNum = [methodSignature numberOfArguments];
-                if (argumentNum == 2) {
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                    [target performSelector:selector];
-#pragma clang diagnostic pop
-                }
-                else {
-                    DUXBetaRKVOTransform* transform = [[DUXBetaRKVOTransform alloc] init];
-                    transform.keyPath = nextArg;
-                    transform.oldValue = oldValue;
-                    transform.updatedValue = newValue;
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                    [target performSelector:selector withObject:transform];
-#pragma clang diagnostic pop
-                }
-            }
-        }];
+        [self setupRKVOKey:nextArg target:target selector:selector];
         nextArg = va_arg(properties, NSString *);
     }
 }
 
+- (void)duxbeta_bindCoalescedRKVOWithTarget:(id)target selector:(SEL)selector interval:(NSTimeInterval)interval properties:(NSArray<NSString *> *)properties {
+    if (properties.count == 0) {
+        return;
+    }
+    DUXBetaRKVOInvocationPlan *plan = [[DUXBetaRKVOInvocationPlan alloc] initWithTarget:target selector:selector];
+    DUXBetaRKVOCoalescer *coalescer = [[DUXBetaRKVOCoalescer alloc] initWithPlan:plan interval:interval];
+    for (NSString *key in properties) {
+        [self duxbeta_addCustomObserver:target forKeyPath:key block:^(id  _Nullable oldValue, id  _Nullable newValue) {
+            [coalescer markDirtyForKeyPath:key oldValue:oldValue newValue:newValue];
+        }];
+    }
+    @synchronized (self) {
+        NSMutableArray *coalescers = objc_getAssociatedObject(self, kDUXBetaRKVOCoalescersKey);
+        if (!coalescers) {
+            coalescers = [[NSMutableArray alloc] init];
+            objc_setAssociatedObject(self, kDUXBetaRKVOCoalescersKey, coalescers, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+        [coalescers addObject:coalescer];
+    }
+    
+    // One initial call for the whole group rather than one per key path.
+    NSString *key = properties.lastObject;
+    id value = [[DUXBetaCustomKeyPath keyPathWithString:key] valueForObject:self];
+    [plan invokeForKeyPath:key oldValue:value newValue:value];
+}
+
+- (void)duxbeta_flushCoalescedRKVO {
+    NSArray *coalescers = nil;
+    @synchronized (self) {
+        coalescers = [objc_getAssociatedObject(self, kDUXBetaRKVOCoalescersKey) copy];
+    }
+    for (DUXBetaRKVOCoalescer *coalescer in coalescers) {
+        [coalescer flush];
+    }
+}
+
 - (void)duxbeta_unBindRKVO {
     [self duxbeta_removeCustomObserver:self];
+    NSArray *coalescers = nil;
+    @synchronized (self) {
+        coalescers = objc_getAssociatedObject(self, kDUXBetaRKVOCoalescersKey);
+        objc_setAssociatedObject(self, kDUXBetaRKVOCoalescersKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    for (DUXBetaRKVOCoalescer *coalescer in coalescers) {
+        [coalescer cancel];
+    }
 }
 
 @end
@@ -40,6 +40,10 @@
 #define BindSDKKey(__key__, __property__) [self duxbeta_bindSDKKey:__key__ propertyName:@DUXBetaVMProperty(__property__)]
 #endif
 
+#ifndef BindSDKKeyAsync
+#define BindSDKKeyAsync(__key__, __property__) [self duxbeta_bindSDKKey:__key__ propertyName:@DUXBetaVMProperty(__property__) mode:DUXBetaSDKBindModeAsynchronous]
+#endif
+
 #ifndef UnBindSDK
 #define UnBindSDK [self duxbeta_unBindSDK]
 #endif
@@ -56,6 +60,17 @@ NS_ASSUME_NONNULL_BEGIN
 
 @class DUXBetaKey;
 
+/**
+ *  How a bind gets the key's current value.
+ *  Synchronous reads it from the key manager before the bind returns.
+ *  Asynchronous starts listening and does the same cached read on a background queue, so setup does not wait on the
+ *  key manager. Pushed updates received in the meantime win over the read.
+ */
+typedef NS_ENUM(NSUInteger, DUXBetaSDKBindMode) {
+    DUXBetaSDKBindModeSynchronous,
+    DUXBetaSDKBindModeAsynchronous
+};
+
 /**
  *  Use these methods to manage the binding of DJI SDK Keys to an associated property's keypath.
  *  This uses the runtime to map the DJIKey's value's type to the propertyName's property type.
@@ -65,12 +80,25 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface NSObject (DUXBetaSDKBind)
 
+/**
+ *  The mode used by duxbeta_bindSDKKey:propertyName: and BindSDKKey. Synchronous unless changed.
+ */
+
++ (void)duxbeta_setDefaultSDKBindMode:(DUXBetaSDKBindMode)mode;
++ (DUXBetaSDKBindMode)duxbeta_defaultSDKBindMode;
+
 /**
  *  Bind a DJI Key to a property's keypath
  */
 
 - (void)duxbeta_bindSDKKey:(DJIKey *)key propertyName:(NSString *)propertyName;
 
+/**
+ *  Bind a DJI Key to a property's keypath, reading the initial value as the mode says.
+ */
+
+- (void)duxbeta_bindSDKKey:(DJIKey *)key propertyName:(NSString *)propertyName mode:(DUXBetaSDKBindMode)mode;
+
 /**
  *  Checks if the given keypath to a property has a valid value associated with it.  A property is considered
  *  valid if the key it has been bound to has updated.
@@ -78,6 +106,13 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (BOOL)duxbeta_checkSDKBindPropertyIsValid:(NSString *)propertyName;
 
+/**
+ *  UnBind one DJI Key from the property it was bound to, leaving the other bindings in place. An initial read of the
+ *  key still in flight is dropped.
+ */
+
+- (void)duxbeta_unBindSDKKey:(DJIKey *)key propertyName:(NSString *)propertyName;
+
 /**
  *  UnBind all DJI Keys and properties.
  */
@@ -26,75 +26,315 @@
 //  
 
 #import <objc/runtime.h>
+#import <pthread/pthread.h>
+#import <stdatomic.h>
 #import <DJISDK/DJISDK.h>
 #import "DUXBetaKeyManager.h"
+#import "DUXBetaBindingInstrumentation.h"
+#import "NSObject+DUXBetaSDKBind.h"
 #import "NSObject+DUXBetaMapping.h"
 
-static void* DUXBetaObjectSharedLibBindDictKey = &DUXBetaObjectSharedLibBindDictKey;
-static void* DUXBetaObjectSharedLibBindDictLockKey = &DUXBetaObjectSharedLibBindDictLockKey;
+static void* DUXBetaObjectSharedLibBindStateKey = &DUXBetaObjectSharedLibBindStateKey;
+
+static const NSUInteger kDUXBetaSDKBindWordsPerPage = 4;
+static const NSUInteger kDUXBetaSDKBindPropertiesPerPage = kDUXBetaSDKBindWordsPerPage * 64;
+
+static _Atomic(DUXBetaSDKBindMode) DUXBetaSDKBindDefaultMode = DUXBetaSDKBindModeSynchronous;
+
+/**
+ *  Valid and pushed bits of 256 bound properties. Pages are only ever appended, so a page reached through next stays
+ *  valid until the bind state is released.
+ */
+typedef struct DUXBetaSDKBindPage {
+    _Atomic(uint64_t) validBits[kDUXBetaSDKBindWordsPerPage];
+    _Atomic(uint64_t) pushedBits[kDUXBetaSDKBindWordsPerPage];
+    struct DUXBetaSDKBindPage * _Atomic next;
+} DUXBetaSDKBindPage;
 
 typedef void (^DUXBetaObjectSDKBindUpdateBlock)(DJIKey * _Nonnull key,
                                                DJIKeyedValue * _Nullable oldValue,
                                                DJIKeyedValue * _Nullable updatedValue,
                                                BOOL isFromPush);
 
+/**
+ *  Per object bind bookkeeping. Every bound property gets a bit, set in validBits while the property holds a value
+ *  and in pushedBits once a push arrived since it was bound, so an asynchronous initial read never overwrites a
+ *  newer pushed value. Updates only touch the bits, the property name to bit table is only used when binding and
+ *  when checking validity. Every bind of a property takes a new bind token, so a late initial read from a key the
+ *  property was unbound from is dropped as well. The bits live in pages of 256 properties, another page is appended
+ *  when an object binds more properties than that.
+ *  Writes of bound values go through the update lock. An initial read checks the pushed bit and writes its value
+ *  under it, so a push can't land in between and be overwritten.
+ */
+@interface DUXBetaSDKBindState : NSObject
+{
+    pthread_mutex_t _mutex;
+    pthread_mutex_t _updateMutex;
+    DUXBetaSDKBindPage _firstPage;
+    DUXBetaSDKBindPage *_lastPage;
+    _Atomic(NSUInteger) _generation;
+}
+
+@property (strong, nonatomic) NSMutableDictionary<NSString *, NSNumber *> *propertyIndexes;
+@property (strong, nonatomic) NSMutableDictionary<NSNumber *, NSNumber *> *bindTokens;
+@property (assign, nonatomic) NSUInteger lastBindToken;
+
+- (NSUInteger)indexForPropertyName:(NSString *)propertyName;
+- (BOOL)isValidPropertyName:(NSString *)propertyName;
+
+@end
+
+@implementation DUXBetaSDKBindState
+
+- (void)dealloc {
+    DUXBetaSDKBindPage *page = atomic_load(&_firstPage.next);
+    while (page != NULL) {
+        DUXBetaSDKBindPage *next = atomic_load(&page->next);
+        free(page);
+        page = next;
+    }
+    pthread_mutex_destroy(&_mutex);
+    pthread_mutex_destroy(&_updateMutex);
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        // Recursive, setting a property notifies its observers, which may push or bind on the same object.
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        pthread_mutex_init(&_updateMutex, &attr);
+        pthread_mutexattr_destroy(&attr);
+        _propertyIndexes = [[NSMutableDictionary alloc] init];
+        _bindTokens = [[NSMutableDictionary alloc] init];
+        for (NSUInteger i = 0; i < kDUXBetaSDKBindWordsPerPage; i++) {
+            atomic_init(&_firstPage.validBits[i], 0);
+            atomic_init(&_firstPage.pushedBits[i], 0);
+        }
+        atomic_init(&_firstPage.next, NULL);
+        _lastPage = &_firstPage;
+        atomic_init(&_generation, 0);
+    }
+    return self;
+}
+
+- (NSUInteger)indexForPropertyName:(NSString *)propertyName {
+    pthread_mutex_lock(&_mutex);
+    NSNumber *index = self.propertyIndexes[propertyName];
+    if (index == nil) {
+        index = @(self.propertyIndexes.count);
+        self.propertyIndexes[propertyName] = index;
+        if (index.unsignedIntegerValue > 0 && index.unsignedIntegerValue % kDUXBetaSDKBindPropertiesPerPage == 0) {
+            // calloc leaves every bit cleared and next NULL, the page is published once it is ready.
+            DUXBetaSDKBindPage *page = calloc(1, sizeof(DUXBetaSDKBindPage));
+            atomic_store(&_lastPage->next, page);
+            _lastPage = page;
+        }
+    }
+    pthread_mutex_unlock(&_mutex);
+    return index.unsignedIntegerValue;
+}
+
+- (DUXBetaSDKBindPage *)pageForIndex:(NSUInteger)index {
+    DUXBetaSDKBindPage *page = &_firstPage;
+    for (NSUInteger i = index / kDUXBetaSDKBindPropertiesPerPage; i > 0 && page != NULL; i--) {
+        page = atomic_load(&page->next);
+    }
+    return page;
+}
+
+- (NSUInteger)nextBindTokenAtIndex:(NSUInteger)index {
+    pthread_mutex_lock(&_mutex);
+    NSUInteger token = ++self.lastBindToken;
+    self.bindTokens[@(index)] = @(token);
+    pthread_mutex_unlock(&_mutex);
+    return token;
+}
+
+- (BOOL)isCurrentBindToken:(NSUInteger)token atIndex:(NSUInteger)index {
+    pthread_mutex_lock(&_mutex);
+    BOOL current = self.bindTokens[@(index)].unsignedIntegerValue == token;
+    pthread_mutex_unlock(&_mutex);
+    return current;
+}
+
+- (void)setValid:(BOOL)valid atIndex:(NSUInteger)index {
+    DUXBetaSDKBindPage *page = [self pageForIndex:index];
+    if (page == NULL) return;
+    NSUInteger word = (index % kDUXBetaSDKBindPropertiesPerPage) / 64;
+    uint64_t mask = 1ULL << (index % 64);
+    if (valid) {
+        atomic_fetch_or(&page->validBits[word], mask);
+    } else {
+        atomic_fetch_and(&page->validBits[word], ~mask);
+    }
+}
+
+- (void)setPushed:(BOOL)pushed atIndex:(NSUInteger)index {
+    DUXBetaSDKBindPage *page = [self pageForIndex:index];
+    if (page == NULL) return;
+    NSUInteger word = (index % kDUXBetaSDKBindPropertiesPerPage) / 64;
+    uint64_t mask = 1ULL << (index % 64);
+    if (pushed) {
+        atomic_fetch_or(&page->pushedBits[word], mask);
+    } else {
+        atomic_fetch_and(&page->pushedBits[word], ~mask);
+    }
+}
+
+- (BOOL)isPushedAtIndex:(NSUInteger)index {
+    DUXBetaSDKBindPage *page = [self pageForIndex:index];
+    if (page == NULL) return NO;
+    NSUInteger word = (index % kDUXBetaSDKBindPropertiesPerPage) / 64;
+    return (atomic_load(&page->pushedBits[word]) & (1ULL << (index % 64))) != 0;
+}
+
+- (BOOL)isValidPropertyName:(NSString *)propertyName {
+    pthread_mutex_lock(&_mutex);
+    NSNumber *index = self.propertyIndexes[propertyName];
+    pthread_mutex_unlock(&_mutex);
+    if (index == nil) {
+        return NO;
+    }
+    NSUInteger i = index.unsignedIntegerValue;
+    DUXBetaSDKBindPage *page = [self pageForIndex:i];
+    if (page == NULL) return NO;
+    return (atomic_load(&page->validBits[(i % kDUXBetaSDKBindPropertiesPerPage) / 64]) & (1ULL << (i % 64))) != 0;
+}
+
+- (void)lockUpdates {
+    pthread_mutex_lock(&_updateMutex);
+}
+
+- (void)unlockUpdates {
+    pthread_mutex_unlock(&_updateMutex);
+}
+
+- (NSUInteger)generation {
+    return atomic_load(&_generation);
+}
+
+- (void)invalidateGeneration {
+    atomic_fetch_add(&_generation, 1);
+}
+
+@end
+
 @implementation NSObject (DUXBetaSDKBind)
 
-- (void)setupSDKKey:(DJIKey *)key updateBlock:(DUXBetaObjectSDKBindUpdateBlock)block {
++ (void)duxbeta_setDefaultSDKBindMode:(DUXBetaSDKBindMode)mode {
+    atomic_store(&DUXBetaSDKBindDefaultMode, mode);
+}
+
++ (DUXBetaSDKBindMode)duxbeta_defaultSDKBindMode {
+    return atomic_load(&DUXBetaSDKBindDefaultMode);
+}
+
+- (void)setupSDKKey:(DJIKey *)key propertyName:(NSString *)propertyName mode:(DUXBetaSDKBindMode)mode updateBlock:(DUXBetaObjectSDKBindUpdateBlock)block {
     NSAssert(block != nil, @"The block to setup cannot be nil. ");
+    uint64_t start = DUXBetaBindingInstrumentationIsEnabled() ? DUXBetaBindingInstrumentationNow() : 0;
     if ([[DUXBetaKeyInterfaceAdapter sharedInstance] getHandler] == nil) {
         [[DUXBetaKeyInterfaceAdapter sharedInstance] setHandler:nil];
     }
-    [[[DUXBetaKeyInterfaceAdapter sharedInstance] getHandler] startListeningForChangesOnKey:key withListener:self andUpdateBlock:^(DJIKeyedValue * _Nullable oldValue, DJIKeyedValue * _Nullable newValue) {
+    id<DUXBetaKeyInterfaces> handler = [[DUXBetaKeyInterfaceAdapter sharedInstance] getHandler];
+    [handler startListeningForChangesOnKey:key withListener:self andUpdateBlock:^(DJIKeyedValue * _Nullable oldValue, DJIKeyedValue * _Nullable newValue) {
         block(key, oldValue, newValue, YES);
     }];
-    DJIKeyedValue *value = [[[DUXBetaKeyInterfaceAdapter sharedInstance] getHandler]getValueForKey:key];
-    block(key, nil, value,NO);
+    DJIKeyedValue *value = nil;
+    if (mode == DUXBetaSDKBindModeSynchronous) {
+        value = [handler getValueForKey:key];
+    }
+    if (start != 0) {
+        [[DUXBetaBindingInstrumentation sharedInstance] recordHop:DUXBetaBindingHopAdapterDispatch
+                                                              key:propertyName
+                                                       modelClass:[self class]
+                                                            value:DUXBetaBindingInstrumentationNow() - start];
+    }
+    
+    if (mode == DUXBetaSDKBindModeAsynchronous) {
+        // The same cached read as the synchronous mode, only moved off the binding thread. Fetching from the
+        // aircraft would cost a round trip per bind and never seed keys that can only be pushed.
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+            DJIKeyedValue *value = [handler getValueForKey:key];
+            block(key, nil, value, NO);
+        });
+    } else {
+        block(key, nil, value,NO);
+    }
 }
 
 - (void)duxbeta_bindSDKKey:(DJIKey *)key propertyName:(NSString *)propertyName {
+    [self duxbeta_bindSDKKey:key propertyName:propertyName mode:[NSObject duxbeta_defaultSDKBindMode]];
+}
+
+- (void)duxbeta_bindSDKKey:(DJIKey *)key propertyName:(NSString *)propertyName mode:(DUXBetaSDKBindMode)mode {
     __weak typeof(self) weakSelf = self;
-    [self setupSDKKey:key updateBlock:^(DJIKey * _Nonnull key, DJIKeyedValue * _Nullable oldValue, DJIKeyedValue * _Nullable newValue, BOOL isFromPush) {
+    DUXBetaSDKBindState *state = [self bindState];
+    NSUInteger index = [state indexForPropertyName:propertyName];
+    NSUInteger generation = [state generation];
+    NSUInteger token = [state nextBindTokenAtIndex:index];
+    [state setPushed:NO atIndex:index];
+    [self setupSDKKey:key propertyName:propertyName mode:mode updateBlock:^(DJIKey * _Nonnull key, DJIKeyedValue * _Nullable oldValue, DJIKeyedValue * _Nullable newValue, BOOL isFromPush) {
         __strong typeof(weakSelf) target = weakSelf;
-        NSNumber* invalidValue = (newValue.value == nil ? @(NO) : @(YES));
-        [[self bindDictLock] lock];
-        [[self propertyValidDict] setObject:invalidValue forKey:propertyName];
-        [[self bindDictLock] unlock];
+        if (target == nil) {
+            return;
+        }
+        [state lockUpdates];
+        if (isFromPush) {
+            [state setPushed:YES atIndex:index];
+        } else if ([state isPushedAtIndex:index] || [state generation] != generation || ![state isCurrentBindToken:token atIndex:index]) {
+            // A late initial read, either a push already delivered a newer value or the object or property was unbound.
+            [state unlockUpdates];
+            return;
+        }
+        [state setValid:(newValue.value != nil) atIndex:index];
+        if (!DUXBetaBindingInstrumentationIsEnabled()) {
+            [target duxbeta_setCustomMappingValue:[newValue value] forKey:propertyName];
+            [state unlockUpdates];
+            return;
+        }
+        uint64_t start = DUXBetaBindingInstrumentationNow();
+        uint64_t previous = DUXBetaBindingInstrumentationBeginUpdate(start);
         [target duxbeta_setCustomMappingValue:[newValue value] forKey:propertyName];
+        DUXBetaBindingInstrumentationEndUpdate(previous);
+        [state unlockUpdates];
+        [[DUXBetaBindingInstrumentation sharedInstance] recordHop:DUXBetaBindingHopKeyToProperty
+                                                              key:propertyName
+                                                       modelClass:[target class]
+                                                            value:DUXBetaBindingInstrumentationNow() - start];
     }];
 }
 
 - (BOOL)duxbeta_checkSDKBindPropertyIsValid:(NSString *)propertyName {
-    BOOL isValid = NO;
-    [[self bindDictLock] lock];
-    NSNumber* validValue = [[self propertyValidDict] objectForKey:propertyName];
-    [[self bindDictLock] unlock];
-    if (validValue != nil) {
-        isValid = validValue.boolValue;
-    }
-    return isValid;
+    DUXBetaSDKBindState *state = objc_getAssociatedObject(self, DUXBetaObjectSharedLibBindStateKey);
+    return [state isValidPropertyName:propertyName];
 }
 
-- (NSLock *)bindDictLock {
-    NSLock* lock = objc_getAssociatedObject(self, DUXBetaObjectSharedLibBindDictLockKey);
-    if (!lock) {
-        lock = [[NSLock alloc] init];
-        objc_setAssociatedObject(self, DUXBetaObjectSharedLibBindDictLockKey, lock, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+- (DUXBetaSDKBindState *)bindState {
+    DUXBetaSDKBindState *state = nil;
+    @synchronized (self) {
+        state = objc_getAssociatedObject(self, DUXBetaObjectSharedLibBindStateKey);
+        if (!state) {
+            state = [[DUXBetaSDKBindState alloc] init];
+            objc_setAssociatedObject(self, DUXBetaObjectSharedLibBindStateKey, state, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
     }
-    return lock;
+    return state;
 }
 
-- (NSMutableDictionary *)propertyValidDict {
-    NSMutableDictionary* dict = objc_getAssociatedObject(self, DUXBetaObjectSharedLibBindDictKey);
-    if (!dict) {
-        dict = [[NSMutableDictionary alloc] init];
-        objc_setAssociatedObject(self, DUXBetaObjectSharedLibBindDictKey, dict, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
-    }
-    return dict;
+- (void)duxbeta_unBindSDKKey:(DJIKey *)key propertyName:(NSString *)propertyName {
+    DUXBetaSDKBindState *state = [self bindState];
+    NSUInteger index = [state indexForPropertyName:propertyName];
+    [state nextBindTokenAtIndex:index];
+    [state setValid:NO atIndex:index];
+    [[[DUXBetaKeyInterfaceAdapter sharedInstance] getHandler] stopListeningOnKey:key ofListener:self];
 }
 
 - (void)duxbeta_unBindSDK {
-    [[DJISDKManager keyManager] stopAllListeningOfListeners:self];
+    [objc_getAssociatedObject(self, DUXBetaObjectSharedLibBindStateKey) invalidateGeneration];
+    [[[DUXBetaKeyInterfaceAdapter sharedInstance] getHandler] stopAllListeningOfListeners:self];
 }
 
 @end
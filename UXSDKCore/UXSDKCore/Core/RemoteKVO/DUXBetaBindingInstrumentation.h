@@ -0,0 +1,118 @@
+//
+//  DUXBetaBindingInstrumentation.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  The measured steps of the binding chain, from a key update reaching NSObject+DUXBetaSDKBind to the RKVO
+ *  selector of the widget or model. Latencies are in nanoseconds.
+ */
+typedef NS_ENUM(NSUInteger, DUXBetaBindingHop) {
+    // Binding a key, from looking its handler up on DUXBetaKeyInterfaceAdapter until the handler has started
+    // listening and returned the initial value.
+    DUXBetaBindingHopAdapterDispatch,
+    // Key update received until the bound property is set, including everything the set triggers.
+    DUXBetaBindingHopKeyToProperty,
+    // Key update received until the custom observer runtime starts delivering the property change.
+    DUXBetaBindingHopKeyToObserver,
+    // Key update received until a bound RKVO selector is called.
+    DUXBetaBindingHopKeyToCallback,
+    // Time spent inside a bound RKVO selector.
+    DUXBetaBindingHopCallback,
+    // Number of observers a property change is delivered to, not a latency.
+    DUXBetaBindingHopFanOut
+};
+
+/**
+ *  Aggregated measurements of one hop for one key and one model class. The key is the model property or key path,
+ *  at every hop, so the hops of one property join up.
+ */
+@interface DUXBetaBindingMetric : NSObject
+
+@property (readonly, nonatomic) DUXBetaBindingHop hop;
+@property (readonly, nonatomic) NSString *key;
+@property (readonly, nonatomic) NSString *modelClass;
+@property (readonly, nonatomic) NSUInteger count;
+@property (readonly, nonatomic) uint64_t total;
+@property (readonly, nonatomic) uint64_t maximum;
+
+/**
+ *  Power of two histogram. Bucket 0 counts values under 1, bucket i values in [2^(i-1), 2^i), the last bucket
+ *  everything above. Latencies are bucketed in microseconds, fan-out in observers.
+ */
+@property (readonly, nonatomic) NSArray<NSNumber *> *histogram;
+
+- (NSDictionary<NSString *, id> *)dictionaryRepresentation;
+
+@end
+
+/**
+ *  Opt-in measurement of the binding chain. While disabled every instrumented call site costs one relaxed atomic
+ *  load. It can be enabled with any DUXBetaKeyInterfaces handler installed, including a mock one.
+ */
+@interface DUXBetaBindingInstrumentation : NSObject
+
++ (instancetype)sharedInstance;
+
+@property (assign, nonatomic, getter=isEnabled) BOOL enabled;
+
+/**
+ *  Adds one value to the metric of the hop, key and model class. Only the first value of a metric allocates.
+ */
+- (void)recordHop:(DUXBetaBindingHop)hop key:(NSString *)key modelClass:(Class)modelClass value:(uint64_t)value;
+
+/**
+ *  Copy of everything recorded since the last reset.
+ */
+- (NSArray<DUXBetaBindingMetric *> *)snapshot;
+
+/**
+ *  The snapshot as a JSON array of metric dictionaries.
+ */
+- (nullable NSData *)JSONSnapshot;
+
+- (void)reset;
+
+@end
+
+/**
+ *  Used by the binding categories and the observer runtime.
+ */
+FOUNDATION_EXPORT BOOL DUXBetaBindingInstrumentationIsEnabled(void);
+FOUNDATION_EXPORT uint64_t DUXBetaBindingInstrumentationNow(void);
+
+/**
+ *  Marks the key update being handled on the current thread, returning the previous mark to restore with
+ *  DUXBetaBindingInstrumentationEndUpdate. Downstream hops measure their latency from it, 0 when there is none.
+ */
+FOUNDATION_EXPORT uint64_t DUXBetaBindingInstrumentationBeginUpdate(uint64_t start);
+FOUNDATION_EXPORT void DUXBetaBindingInstrumentationEndUpdate(uint64_t previous);
+FOUNDATION_EXPORT uint64_t DUXBetaBindingInstrumentationCurrentUpdateStart(void);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,258 @@
+//
+//  DUXBetaBindingInstrumentation.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaBindingInstrumentation.h"
+#import <pthread/pthread.h>
+#import <stdatomic.h>
+#import <time.h>
+
+static const NSUInteger kDUXBetaBindingHistogramBuckets = 24;
+static const NSUInteger kDUXBetaBindingHopCount = DUXBetaBindingHopFanOut + 1;
+
+static atomic_bool DUXBetaBindingInstrumentationEnabledFlag = false;
+static _Thread_local uint64_t DUXBetaBindingInstrumentationUpdateStart = 0;
+
+BOOL DUXBetaBindingInstrumentationIsEnabled(void) {
+    return atomic_load_explicit(&DUXBetaBindingInstrumentationEnabledFlag, memory_order_relaxed);
+}
+
+uint64_t DUXBetaBindingInstrumentationNow(void) {
+    return clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+}
+
+uint64_t DUXBetaBindingInstrumentationBeginUpdate(uint64_t start) {
+    uint64_t previous = DUXBetaBindingInstrumentationUpdateStart;
+    DUXBetaBindingInstrumentationUpdateStart = start;
+    return previous;
+}
+
+void DUXBetaBindingInstrumentationEndUpdate(uint64_t previous) {
+    DUXBetaBindingInstrumentationUpdateStart = previous;
+}
+
+uint64_t DUXBetaBindingInstrumentationCurrentUpdateStart(void) {
+    return DUXBetaBindingInstrumentationUpdateStart;
+}
+
+static NSString *DUXBetaBindingHopName(DUXBetaBindingHop hop) {
+    switch (hop) {
+        case DUXBetaBindingHopAdapterDispatch: return @"adapterDispatch";
+        case DUXBetaBindingHopKeyToProperty: return @"keyToProperty";
+        case DUXBetaBindingHopKeyToObserver: return @"keyToObserver";
+        case DUXBetaBindingHopKeyToCallback: return @"keyToCallback";
+        case DUXBetaBindingHopCallback: return @"callback";
+        case DUXBetaBindingHopFanOut: return @"fanOut";
+    }
+}
+
+@interface DUXBetaBindingMetric ()
+{
+    @public
+    NSUInteger _buckets[kDUXBetaBindingHistogramBuckets];
+}
+
+@property (assign, nonatomic) DUXBetaBindingHop hop;
+@property (copy, nonatomic) NSString *key;
+@property (copy, nonatomic) NSString *modelClass;
+@property (assign, nonatomic) NSUInteger count;
+@property (assign, nonatomic) uint64_t total;
+@property (assign, nonatomic) uint64_t maximum;
+
+@end
+
+@implementation DUXBetaBindingMetric
+
+- (void)addValue:(uint64_t)value {
+    uint64_t bucketValue = (self.hop == DUXBetaBindingHopFanOut) ? value : value / NSEC_PER_USEC;
+    NSUInteger bucket = 0;
+    while (bucketValue > 0 && bucket < kDUXBetaBindingHistogramBuckets - 1) {
+        bucketValue >>= 1;
+        bucket++;
+    }
+    _buckets[bucket]++;
+    self.count++;
+    self.total += value;
+    self.maximum = MAX(self.maximum, value);
+}
+
+- (DUXBetaBindingMetric *)snapshotCopy {
+    DUXBetaBindingMetric *metric = [[DUXBetaBindingMetric alloc] init];
+    metric.hop = self.hop;
+    metric.key = self.key;
+    metric.modelClass = self.modelClass;
+    metric.count = self.count;
+    metric.total = self.total;
+    metric.maximum = self.maximum;
+    memcpy(metric->_buckets, _buckets, sizeof(_buckets));
+    return metric;
+}
+
+- (NSArray<NSNumber *> *)histogram {
+    NSMutableArray *histogram = [[NSMutableArray alloc] initWithCapacity:kDUXBetaBindingHistogramBuckets];
+    for (NSUInteger i = 0; i < kDUXBetaBindingHistogramBuckets; i++) {
+        [histogram addObject:@(_buckets[i])];
+    }
+    return histogram;
+}
+
+- (NSDictionary<NSString *, id> *)dictionaryRepresentation {
+    return @{
+        @"hop" : DUXBetaBindingHopName(self.hop),
+        @"key" : self.key,
+        @"modelClass" : self.modelClass,
+        @"count" : @(self.count),
+        @"total" : @(self.total),
+        @"maximum" : @(self.maximum),
+        @"histogram" : self.histogram
+    };
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@ %@ %@ count:%lu total:%llu max:%llu", DUXBetaBindingHopName(self.hop), self.modelClass, self.key, (unsigned long)self.count, self.total, self.maximum];
+}
+
+@end
+
+/**
+ *  The metrics of every hop for one key of one model class, indexed by hop.
+ */
+@interface DUXBetaBindingKeyMetrics : NSObject
+{
+    @public
+    DUXBetaBindingMetric *_hops[kDUXBetaBindingHopCount];
+}
+@end
+
+@implementation DUXBetaBindingKeyMetrics
+@end
+
+@interface DUXBetaBindingInstrumentation ()
+{
+    pthread_mutex_t _mutex;
+}
+
+/**
+ *  Metrics by model class, then by key. Looking a metric up hashes the class pointer and the key, recording into
+ *  an existing metric allocates nothing.
+ */
+@property (strong, nonatomic) NSMapTable<Class, NSMutableDictionary<NSString *, DUXBetaBindingKeyMetrics *> *> *metrics;
+
+@end
+
+@implementation DUXBetaBindingInstrumentation
+
++ (instancetype)sharedInstance {
+    static DUXBetaBindingInstrumentation *instrumentation = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instrumentation = [DUXBetaBindingInstrumentation new];
+    });
+    return instrumentation;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        pthread_mutex_init(&_mutex, NULL);
+        _metrics = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    return self;
+}
+
+- (BOOL)isEnabled {
+    return DUXBetaBindingInstrumentationIsEnabled();
+}
+
+- (void)setEnabled:(BOOL)enabled {
+    atomic_store(&DUXBetaBindingInstrumentationEnabledFlag, enabled);
+}
+
+- (void)recordHop:(DUXBetaBindingHop)hop key:(NSString *)key modelClass:(Class)modelClass value:(uint64_t)value {
+    if (hop >= kDUXBetaBindingHopCount) {
+        return;
+    }
+    key = key ?: @"";
+    pthread_mutex_lock(&_mutex);
+    NSMutableDictionary<NSString *, DUXBetaBindingKeyMetrics *> *classMetrics = [self.metrics objectForKey:modelClass];
+    if (classMetrics == nil) {
+        classMetrics = [[NSMutableDictionary alloc] init];
+        [self.metrics setObject:classMetrics forKey:modelClass];
+    }
+    DUXBetaBindingKeyMetrics *keyMetrics = classMetrics[key];
+    if (keyMetrics == nil) {
+        keyMetrics = [[DUXBetaBindingKeyMetrics alloc] init];
+        classMetrics[key] = keyMetrics;
+    }
+    DUXBetaBindingMetric *metric = keyMetrics->_hops[hop];
+    if (metric == nil) {
+        metric = [[DUXBetaBindingMetric alloc] init];
+        metric.hop = hop;
+        metric.key = key;
+        metric.modelClass = NSStringFromClass(modelClass) ?: @"";
+        keyMetrics->_hops[hop] = metric;
+    }
+    [metric addValue:value];
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (NSArray<DUXBetaBindingMetric *> *)snapshot {
+    NSMutableArray<DUXBetaBindingMetric *> *snapshot = [[NSMutableArray alloc] init];
+    pthread_mutex_lock(&_mutex);
+    for (NSMutableDictionary<NSString *, DUXBetaBindingKeyMetrics *> *classMetrics in self.metrics.objectEnumerator) {
+        for (DUXBetaBindingKeyMetrics *keyMetrics in classMetrics.objectEnumerator) {
+            for (NSUInteger hop = 0; hop < kDUXBetaBindingHopCount; hop++) {
+                if (keyMetrics->_hops[hop]) {
+                    [snapshot addObject:[keyMetrics->_hops[hop] snapshotCopy]];
+                }
+            }
+        }
+    }
+    pthread_mutex_unlock(&_mutex);
+    [snapshot sortUsingComparator:^NSComparisonResult(DUXBetaBindingMetric *first, DUXBetaBindingMetric *second) {
+        if (first.hop != second.hop) {
+            return first.hop < second.hop ? NSOrderedAscending : NSOrderedDescending;
+        }
+        NSComparisonResult result = [first.modelClass compare:second.modelClass];
+        return result != NSOrderedSame ? result : [first.key compare:second.key];
+    }];
+    return snapshot;
+}
+
+- (nullable NSData *)JSONSnapshot {
+    NSMutableArray *array = [[NSMutableArray alloc] init];
+    for (DUXBetaBindingMetric *metric in [self snapshot]) {
+        [array addObject:[metric dictionaryRepresentation]];
+    }
+    return [NSJSONSerialization dataWithJSONObject:array options:NSJSONWritingPrettyPrinted error:nil];
+}
+
+- (void)reset {
+    pthread_mutex_lock(&_mutex);
+    [self.metrics removeAllObjects];
+    pthread_mutex_unlock(&_mutex);
+}
+
+@end
@@ -25,6 +25,7 @@
 //  
 
 #import "DUXBetaCustomAsyncMethod.h"
+#import "DUXBetaCustomKeyPath.h"
 
 @interface DUXBetaCustomAsyncMethod ()
 
@@ -119,12 +120,7 @@
 {
     if (_defaultGetMethod == nil)
     {
-        NSArray *array = [self.keyPath componentsSeparatedByString:@"."];
-        NSString *key = array.lastObject;
-        
-        NSString *setMethodName = [NSString stringWithFormat:@"get%@%@Completion:",[[key substringWithRange:NSMakeRange(0, 1)] uppercaseString],[key substringWithRange:NSMakeRange(1, key.length - 1)]];
-        
-        _defaultGetMethod = NSSelectorFromString(setMethodName);
+        _defaultGetMethod = [DUXBetaCustomKeyPath keyPathWithString:self.keyPath].defaultGetSelector;
     }
     if (self.object)
     {
@@ -138,12 +134,7 @@
 {
     if (_defaultSetMethod == nil)
     {
-        NSArray *array = [self.keyPath componentsSeparatedByString:@"."];
-        NSString *key = array.lastObject;
-        
-        NSString *setMethodName = [NSString stringWithFormat:@"set%@%@:completion:",[[key substringWithRange:NSMakeRange(0, 1)] uppercaseString],[key substringWithRange:NSMakeRange(1, key.length - 1)]];
-        
-        _defaultSetMethod = NSSelectorFromString(setMethodName);
+        _defaultSetMethod = [DUXBetaCustomKeyPath keyPathWithString:self.keyPath].defaultSetSelector;
     }
     if (self.object)
     {
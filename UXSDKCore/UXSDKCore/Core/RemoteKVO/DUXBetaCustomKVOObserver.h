@@ -25,6 +25,7 @@
 //  
 
 #import <Foundation/Foundation.h>
+#import <UXSDKCore/DUXBetaCustomKeyPath.h>
 
 @interface DUXBetaCustomKVOObserver : NSObject
 
@@ -37,6 +38,11 @@
 
 - (void)callbackWithOldValue:(nullable id)oldValue withNewValue:(nullable id)newValue;
 
+/**
+ *  The observed key path, parsed.
+ */
+@property (readonly, nonatomic, nonnull) DUXBetaCustomKeyPath *keyPath;
+
 /**
  *  Observe key.
  *
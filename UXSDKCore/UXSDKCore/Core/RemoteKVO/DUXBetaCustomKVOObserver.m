@@ -28,8 +28,7 @@
 
 @interface DUXBetaCustomKVOObserver ()
 
-@property (strong, nonatomic) NSString *observeKey;
-@property (strong, nonatomic) NSString *observeSubpath;
+@property (strong, nonatomic) DUXBetaCustomKeyPath *keyPath;
 
 @end
 
@@ -56,16 +55,17 @@
 
 - (void)setKeypath:(NSString *)keypath
 {
-    NSRange range = [keypath rangeOfString:@"."];
-    if (range.location == NSNotFound)
-    {
-        self.observeKey = keypath;
-    }
-    else
-    {
-        self.observeKey = [keypath substringToIndex:range.location];
-        self.observeSubpath = [keypath substringFromIndex:range.location+1];
-    }
+    self.keyPath = [DUXBetaCustomKeyPath keyPathWithString:keypath];
+}
+
+- (NSString *)observeKey
+{
+    return self.keyPath.observeKey;
+}
+
+- (NSString *)observeSubpath
+{
+    return self.keyPath.observeSubpath.string;
 }
 
 - (void)callbackWithOldValue:(id)oldValue withNewValue:(id)newValue{
@@ -0,0 +1,73 @@
+//
+//  DUXBetaCustomKeyPath.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  A key path parsed once and shared. Instances are interned, asking twice for the same string returns the same
+ *  object, so the observer runtime and the binding categories never split the same key path again. The intern table
+ *  is bounded, once full new key paths are still parsed but no longer interned.
+ */
+@interface DUXBetaCustomKeyPath : NSObject
+
++ (instancetype)keyPathWithString:(NSString *)keyPath;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (readonly, nonatomic) NSString *string;
+
+/**
+ *  The key path split on ".".
+ */
+@property (readonly, nonatomic) NSArray<NSString *> *components;
+
+/**
+ *  Only the first component, the key observed on the object itself.
+ */
+@property (readonly, nonatomic) NSString *observeKey;
+
+/**
+ *  Everything after the first component, nil for a single key.
+ */
+@property (readonly, nonatomic, nullable) DUXBetaCustomKeyPath *observeSubpath;
+
+/**
+ *  get<LastComponent>Completion: and set<LastComponent>:completion:, the default async accessors.
+ */
+@property (readonly, nonatomic) SEL defaultGetSelector;
+@property (readonly, nonatomic) SEL defaultSetSelector;
+
+/**
+ *  Resolves the key path on the object one component at a time, stopping at the first nil.
+ */
+- (nullable id)valueForObject:(NSObject *)object;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,117 @@
+//
+//  DUXBetaCustomKeyPath.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaCustomKeyPath.h"
+#import <pthread/pthread.h>
+
+/**
+ *  Key paths come from binding declarations, so the table settles at a few hundred entries. It stops growing at
+ *  DUXBetaCustomKeyPathMapLimit anyway, key paths built at runtime past that point are parsed for each call instead.
+ */
+static const NSUInteger DUXBetaCustomKeyPathMapLimit = 4096;
+static pthread_rwlock_t DUXBetaCustomKeyPathLock = PTHREAD_RWLOCK_INITIALIZER;
+static NSMutableDictionary<NSString *, DUXBetaCustomKeyPath *> *DUXBetaCustomKeyPathMap = nil;
+
+@interface DUXBetaCustomKeyPath ()
+
+@property (strong, nonatomic) NSString *string;
+@property (strong, nonatomic) NSArray<NSString *> *components;
+@property (strong, nonatomic) NSString *observeKey;
+@property (strong, nonatomic) DUXBetaCustomKeyPath *observeSubpath;
+@property (assign, nonatomic) SEL defaultGetSelector;
+@property (assign, nonatomic) SEL defaultSetSelector;
+
+@end
+
+@implementation DUXBetaCustomKeyPath
+
++ (instancetype)keyPathWithString:(NSString *)keyPath
+{
+    // Read mostly, every custom KVO call looks its key path up and almost never adds one.
+    pthread_rwlock_rdlock(&DUXBetaCustomKeyPathLock);
+    DUXBetaCustomKeyPath *compiled = DUXBetaCustomKeyPathMap[keyPath];
+    pthread_rwlock_unlock(&DUXBetaCustomKeyPathLock);
+    if (compiled) {
+        return compiled;
+    }
+    
+    // Parsed outside the lock, the subpath interns itself through this same method.
+    compiled = [[DUXBetaCustomKeyPath alloc] initWithString:keyPath];
+    
+    pthread_rwlock_wrlock(&DUXBetaCustomKeyPathLock);
+    if (DUXBetaCustomKeyPathMap == nil) {
+        DUXBetaCustomKeyPathMap = [[NSMutableDictionary alloc] init];
+    }
+    if (DUXBetaCustomKeyPathMap[keyPath]) {
+        compiled = DUXBetaCustomKeyPathMap[keyPath];
+    } else if (DUXBetaCustomKeyPathMap.count < DUXBetaCustomKeyPathMapLimit) {
+        DUXBetaCustomKeyPathMap[compiled.string] = compiled;
+    }
+    pthread_rwlock_unlock(&DUXBetaCustomKeyPathLock);
+    return compiled;
+}
+
+- (instancetype)initWithString:(NSString *)keyPath
+{
+    self = [super init];
+    _string = [keyPath copy];
+    _components = [_string componentsSeparatedByString:@"."];
+    _observeKey = _components.firstObject;
+    
+    NSRange range = [_string rangeOfString:@"."];
+    if (range.location != NSNotFound) {
+        _observeSubpath = [DUXBetaCustomKeyPath keyPathWithString:[_string substringFromIndex:range.location + 1]];
+    }
+    
+    NSString *key = _components.lastObject;
+    if (key.length > 0) {
+        NSString *capitalizedKey = [NSString stringWithFormat:@"%@%@", [[key substringToIndex:1] uppercaseString], [key substringFromIndex:1]];
+        _defaultGetSelector = NSSelectorFromString([NSString stringWithFormat:@"get%@Completion:", capitalizedKey]);
+        _defaultSetSelector = NSSelectorFromString([NSString stringWithFormat:@"set%@:completion:", capitalizedKey]);
+    }
+    return self;
+}
+
+- (nullable id)valueForObject:(NSObject *)object
+{
+    id lastValue = object;
+    for (NSString *component in _components) {
+        lastValue = [lastValue valueForKey:component];
+        if (lastValue == nil)
+        {
+            break;
+        }
+    }
+    return lastValue;
+}
+
+- (NSString *)description
+{
+    return _string;
+}
+
+@end
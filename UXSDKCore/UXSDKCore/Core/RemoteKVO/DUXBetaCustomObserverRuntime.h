@@ -42,6 +42,13 @@
 - (void)unregisterCustomObserver:(nonnull NSObject *)observer;
 - (void)unregisterAllCustomObservers;
 
+/**
+ *  Every change is delivered, one thread at a time per key path. A change arriving while another thread is still
+ *  delivering the same key path is handed to that thread instead of blocking, and changes piling up that way are
+ *  merged so only the latest value is delivered. This counts the merged changes.
+ */
+@property (readonly, nonatomic) NSUInteger coalescedNotificationCount;
+
 @end
 
 @interface DUXBetaCustomObserverRuntime (DUXBetaCustomAsyncKVO)
@@ -27,28 +27,75 @@
 #import <pthread/pthread.h>
 
 #import "DUXBetaCustomObserverRuntime.h"
+#import "DUXBetaBindingInstrumentation.h"
 #import "DUXBetaCustomAsyncCache.h"
 #import "DUXBetaCustomAsyncMethod.h"
 #import "DUXBetaCustomKVOObserver.h"
+#import "DUXBetaCustomKeyPath.h"
 
 #import "NSObject+DUXBetaCustomKVO.h"
 
 /**
- *  Need improve speed.
+ *  Attached to every observer registered on a runtime, keyed by the runtime's address. It is the observer
+ *  identity side of the registry: it counts the observe keys the observer is registered on, so unregistering an
+ *  observer only touches those keys, and it prunes the registry as soon as the observer is released.
  */
+@interface DUXBetaCustomObserverToken : NSObject
+
+@property (weak, nonatomic) DUXBetaCustomObserverRuntime *runtime;
+@property (strong, nonatomic) NSCountedSet<NSString *> *observeKeys;
+
+@end
+
+/**
+ *  Delivery slot of one observe key. Only one thread delivers a key at a time, a change arriving meanwhile replaces
+ *  the value parked here (last value wins) and the delivering thread picks it up before it exits.
+ */
+@interface DUXBetaCustomNotificationState : NSObject
+
+@property (assign, nonatomic) BOOL delivering;
+@property (assign, nonatomic) BOOL pending;
+@property (strong, nonatomic) id pendingNewValue;
+
+@end
+
+@implementation DUXBetaCustomNotificationState
+@end
+
 @interface DUXBetaCustomObserverRuntime ()
 {
     pthread_mutex_t _observerMutex;
+    pthread_mutex_t _notificationMutex;
     pthread_mutex_t _asyncCacheMutex;
     pthread_mutex_t _asyncMethodMutex;
+    NSUInteger _coalescedNotificationCount;
 }
 
 @property (assign, nonatomic) NSObject * _Nullable observedObject;
 
-@property (strong, nonatomic) NSMutableDictionary<NSString *,NSMutableArray<DUXBetaCustomKVOObserver *> *> *customObserverMap;
+/**
+ *  Observers indexed by observe key. The arrays are immutable and replaced on every change, so the notification
+ *  path can hold on to a snapshot without copying it.
+ */
+@property (strong, nonatomic) NSMutableDictionary<NSString *,NSArray<DUXBetaCustomKVOObserver *> *> *customObserverMap;
+@property (strong, nonatomic) NSMutableDictionary<NSString *,DUXBetaCustomNotificationState *> *notificationStateMap;
 @property (strong, nonatomic) NSMutableDictionary<NSString *,DUXBetaCustomAsyncCache *> *customAsyncCacheMap;
 @property (strong, nonatomic) NSMutableDictionary<NSString *,DUXBetaCustomAsyncMethod *> *customAsyncMethodMap;
 
+- (void)pruneReleasedObserversForKeys:(NSSet<NSString *> *)observeKeys;
+
+@end
+
+@implementation DUXBetaCustomObserverToken
+
+- (void)dealloc
+{
+    // Only reached with keys left when the observer itself is being released, its weak references are nil by now.
+    if (self.observeKeys.count > 0) {
+        [self.runtime pruneReleasedObserversForKeys:self.observeKeys];
+    }
+}
+
 @end
 
 @implementation DUXBetaCustomObserverRuntime
@@ -57,6 +104,7 @@
     [self unregisterAllCustomObservers];
     _observedObject = nil;
     pthread_mutex_destroy(&_observerMutex);
+    pthread_mutex_destroy(&_notificationMutex);
     pthread_mutex_destroy(&_asyncCacheMutex);
     pthread_mutex_destroy(&_asyncMethodMutex);
 }
@@ -65,11 +113,18 @@
 {
     self = [super init];
     self.customObserverMap = [[NSMutableDictionary alloc] init];
+    self.notificationStateMap = [[NSMutableDictionary alloc] init];
     self.customAsyncCacheMap = [[NSMutableDictionary alloc] init];
     self.customAsyncMethodMap = [[NSMutableDictionary alloc] init];
     [self setObservedObject:object];
     
-    pthread_mutex_init(&_observerMutex, NULL);
+    // Recursive, releasing an observer token while the lock is held can prune the registry again.
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&_observerMutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    pthread_mutex_init(&_notificationMutex, NULL);
     pthread_mutex_init(&_asyncCacheMutex, NULL);
     pthread_mutex_init(&_asyncMethodMutex, NULL);
     
@@ -78,51 +133,252 @@
 
 - (void)registerCustomObserver:(NSObject *)observer forKeyPath:(NSString *)keyPath block:(void(^)(id oldValue,id newValue))block{
     DUXBetaCustomKVOObserver *observerObject = [DUXBetaCustomKVOObserver observerWithKeypath:keyPath withObject:observer withBlock:block];
+    [self addObserverObject:observerObject observer:observer options:NSKeyValueObservingOptionOld|NSKeyValueObservingOptionNew];
+}
+
+- (void)registerCustomObserver:(NSObject *)observer forKeyPath:(NSString *)keyPath selector:(SEL)selector{
+    DUXBetaCustomKVOObserver *observerObject = [DUXBetaCustomKVOObserver observerWithKeypath:keyPath withObject:observer withSelector:selector];
+    [self addObserverObject:observerObject observer:observer options:NSKeyValueObservingOptionOld|NSKeyValueObservingOptionNew|NSKeyValueObservingOptionInitial];
+}
+
+- (void)unregisterCustomObserver:(NSObject *)observer forKeyPath:(NSString *)keyPath{
+    DUXBetaCustomKeyPath *compiledKeyPath = [DUXBetaCustomKeyPath keyPathWithString:keyPath];
+    NSString *observeKey = compiledKeyPath.observeKey;
+    NSString *observeSubpath = compiledKeyPath.observeSubpath.string;
+    
+    // Everything dropped from the registry is kept alive until the lock is released. Observer blocks may hold the
+    // last reference to an observer, and its token would re-enter the registry while it is released.
+    NSMutableArray *released = [[NSMutableArray alloc] init];
+    pthread_mutex_lock(&_observerMutex);
+    DUXBetaCustomObserverToken *token = [self tokenForObserver:observer create:NO];
+    if ([token.observeKeys countForObject:observeKey] > 0) {
+        [self removeObserverObjectsForKey:observeKey token:token released:released passingTest:^BOOL(DUXBetaCustomKVOObserver *callback) {
+            if (callback.object != observer) return NO;
+            if (callback.observeSubpath == nil && observeSubpath == nil) return YES;
+            return callback.observeSubpath && observeSubpath && [callback.observeSubpath isEqualToString:observeSubpath];
+        }];
+        [self releaseTokenIfUnused:token observer:observer];
+    }
+    pthread_mutex_unlock(&_observerMutex);
+    released = nil;
+}
+
+- (void)unregisterCustomObserver:(NSObject *)observer{
+    NSMutableArray *released = [[NSMutableArray alloc] init];
+    pthread_mutex_lock(&_observerMutex);
+    DUXBetaCustomObserverToken *token = [self tokenForObserver:observer create:NO];
+    for (NSString *observeKey in [token.observeKeys allObjects]) {
+        [self removeObserverObjectsForKey:observeKey token:token released:released passingTest:^BOOL(DUXBetaCustomKVOObserver *callback) {
+            return callback.object == observer;
+        }];
+    }
+    [self releaseTokenIfUnused:token observer:observer];
+    pthread_mutex_unlock(&_observerMutex);
+    released = nil;
+}
+
+- (void)unregisterAllCustomObservers{
     pthread_mutex_lock(&_observerMutex);
-    NSMutableArray *array = [_customObserverMap objectForKey:observerObject.observeKey];
-    if(array){
-        [array addObject:observerObject];
+    NSDictionary<NSString *,NSArray<DUXBetaCustomKVOObserver *> *> *released = _customObserverMap;
+    _customObserverMap = [[NSMutableDictionary alloc] init];
+    for (NSString *keyPath in released) {
+        [_observedObject removeObserver:self forKeyPath:keyPath];
+        for (DUXBetaCustomKVOObserver *callback in released[keyPath]) {
+            // Tokens of live observers are left behind and ignored, they only point back to this runtime weakly.
+            [[self tokenForObserver:callback.object create:NO].observeKeys removeAllObjects];
+        }
     }
-    else{
-        array = [[NSMutableArray alloc] init];
-        [array addObject:observerObject];
-        [_customObserverMap setObject:array forKey:observerObject.observeKey];
-        [_observedObject addObserver:self forKeyPath:observerObject.observeKey options:NSKeyValueObservingOptionOld|NSKeyValueObservingOptionNew context:NULL];
+    pthread_mutex_unlock(&_observerMutex);
+    released = nil;
+}
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary<NSString *,id> *)change context:(void *)context{
+    id oldValue = change[NSKeyValueChangeOldKey];
+    id newValue = change[NSKeyValueChangeNewKey];
+	if (oldValue == [NSNull null]) oldValue = nil;
+	if (newValue == [NSNull null]) newValue = nil;
+
+    if((!(oldValue == nil && newValue == nil)) && ![oldValue isEqual:newValue]){
+        if (![self beginNotificationForKeyPath:keyPath newValue:newValue]) {
+            // Another thread is delivering this key, it will deliver this change too.
+            return;
+        }
+        do {
+            if ((!(oldValue == nil && newValue == nil)) && ![oldValue isEqual:newValue]) {
+                [self deliverChangeForKeyPath:keyPath oldValue:oldValue newValue:newValue];
+            }
+        } while ([self continueNotificationForKeyPath:keyPath oldValue:&oldValue newValue:&newValue]);
     }
+}
+
+- (void)deliverChangeForKeyPath:(NSString *)keyPath oldValue:(id)oldValue newValue:(id)newValue
+{
+    pthread_mutex_lock(&_observerMutex);
+    NSArray *array = [_customObserverMap objectForKey:keyPath];
     pthread_mutex_unlock(&_observerMutex);
     
-    if (observerObject.observeSubpath)
-    {
-        id subObject = [self.observedObject valueForKey:observerObject.observeKey];
-        if (subObject)
+    if (DUXBetaBindingInstrumentationIsEnabled()) {
+        DUXBetaBindingInstrumentation *instrumentation = [DUXBetaBindingInstrumentation sharedInstance];
+        Class observedClass = [self.observedObject class];
+        [instrumentation recordHop:DUXBetaBindingHopFanOut key:keyPath modelClass:observedClass value:array.count];
+        uint64_t start = DUXBetaBindingInstrumentationCurrentUpdateStart();
+        if (start != 0) {
+            [instrumentation recordHop:DUXBetaBindingHopKeyToObserver key:keyPath modelClass:observedClass value:DUXBetaBindingInstrumentationNow() - start];
+        }
+    }
+    
+    for (DUXBetaCustomKVOObserver *callback in array) {
+        // Released observers are pruned by their token, this only skips one released during this delivery.
+        if (callback.object == nil) continue;
+        
+        if (callback.observeSubpath) //如果监听的是路径，则在第一级key上增加监听器。
         {
-            __weak DUXBetaCustomKVOObserver *weakObserverObject = observerObject;
-            [subObject duxbeta_addCustomObserver:observerObject forKeyPath:observerObject.observeSubpath block:^(id  _Nullable oldValue, id  _Nullable newValue) {
-                if (weakObserverObject == nil) return;
-                [weakObserverObject callbackWithOldValue:oldValue withNewValue:newValue];
-            }];
+            if (oldValue)
+            {
+                [oldValue duxbeta_removeCustomObserver:callback forKeyPath:callback.observeSubpath];
+            }
+            if (newValue)
+            {
+                __weak DUXBetaCustomKVOObserver *weakCallback = callback;
+                [newValue duxbeta_addCustomObserver:callback forKeyPath:callback.observeSubpath block:^(id  _Nullable oldValue, id  _Nullable newValue) {
+                    if (weakCallback == nil) return;
+                    [weakCallback callbackWithOldValue:oldValue withNewValue:newValue];
+                }];
+            }
+            DUXBetaCustomKeyPath *subpath = callback.keyPath.observeSubpath;
+            id oldSubValue = oldValue?[subpath valueForObject:oldValue]:nil;
+            id newSubValue = newValue?[subpath valueForObject:newValue]:nil;
+            if (oldSubValue == [NSNull null]) oldSubValue = nil;
+            if (newSubValue == [NSNull null]) newSubValue = nil;
+
+            if ((!(oldSubValue == nil && newSubValue == nil)) && ![oldSubValue isEqual:newSubValue])
+            {
+                [callback callbackWithOldValue:oldSubValue withNewValue:newSubValue];
+            }
+        }
+        else
+        {
+            [callback callbackWithOldValue:oldValue withNewValue:newValue];
         }
     }
 }
 
-- (void)registerCustomObserver:(NSObject *)observer forKeyPath:(NSString *)keyPath selector:(SEL)selector{
-    DUXBetaCustomKVOObserver *observerObject = [DUXBetaCustomKVOObserver observerWithKeypath:keyPath withObject:observer withSelector:selector];
+#pragma mark - Delivery
+
+/**
+ *  Returns YES when the caller should deliver the change. Otherwise the change was parked for the thread already
+ *  delivering the key, replacing any value parked before it (last value wins).
+ */
+- (BOOL)beginNotificationForKeyPath:(NSString *)keyPath newValue:(id)newValue
+{
+    BOOL shouldDeliver = YES;
+    pthread_mutex_lock(&_notificationMutex);
+    DUXBetaCustomNotificationState *state = _notificationStateMap[keyPath];
+    if (state == nil) {
+        state = [[DUXBetaCustomNotificationState alloc] init];
+        _notificationStateMap[keyPath] = state;
+    }
+    if (state.delivering) {
+        if (state.pending) {
+            _coalescedNotificationCount++;
+        }
+        state.pending = YES;
+        state.pendingNewValue = newValue;
+        shouldDeliver = NO;
+    } else {
+        state.delivering = YES;
+    }
+    pthread_mutex_unlock(&_notificationMutex);
+    return shouldDeliver;
+}
+
+/**
+ *  Hands the delivering thread its next change, or ends the delivery. The old value is always the value delivered
+ *  last, so observers of a subpath are moved from the object they were added to. Before the delivery ends the key is
+ *  read once more: KVO may report concurrent changes in another order than they were made, and the value read here
+ *  makes sure observers end on the current one.
+ */
+- (BOOL)continueNotificationForKeyPath:(NSString *)keyPath oldValue:(id *)oldValue newValue:(id *)newValue
+{
+    id deliveredValue = *newValue;
+    if ([self takePendingValueForKeyPath:keyPath newValue:newValue endDelivery:NO]) {
+        *oldValue = deliveredValue;
+        return YES;
+    }
+    
+    id currentValue = [self.observedObject valueForKey:keyPath];
+    if (currentValue == [NSNull null]) currentValue = nil;
+    if (!(currentValue == nil && deliveredValue == nil) && ![currentValue isEqual:deliveredValue]) {
+        *oldValue = deliveredValue;
+        *newValue = currentValue;
+        return YES;
+    }
+    
+    if ([self takePendingValueForKeyPath:keyPath newValue:newValue endDelivery:YES]) {
+        *oldValue = deliveredValue;
+        return YES;
+    }
+    return NO;
+}
+
+- (BOOL)takePendingValueForKeyPath:(NSString *)keyPath newValue:(id *)newValue endDelivery:(BOOL)endDelivery
+{
+    BOOL hasPending = NO;
+    pthread_mutex_lock(&_notificationMutex);
+    DUXBetaCustomNotificationState *state = _notificationStateMap[keyPath];
+    if (state.pending) {
+        *newValue = state.pendingNewValue;
+        state.pending = NO;
+        state.pendingNewValue = nil;
+        hasPending = YES;
+    } else if (endDelivery) {
+        state.delivering = NO;
+    }
+    pthread_mutex_unlock(&_notificationMutex);
+    return hasPending;
+}
+
+- (NSUInteger)coalescedNotificationCount
+{
+    pthread_mutex_lock(&_notificationMutex);
+    NSUInteger count = _coalescedNotificationCount;
+    pthread_mutex_unlock(&_notificationMutex);
+    return count;
+}
+
+#pragma mark - Registry
+
+- (void)addObserverObject:(DUXBetaCustomKVOObserver *)observerObject observer:(NSObject *)observer options:(NSKeyValueObservingOptions)options
+{
+    NSString *observeKey = observerObject.observeKey;
+    NSArray *released = nil;
+    BOOL notifyInitial = NO;
     pthread_mutex_lock(&_observerMutex);
-    NSMutableArray *array = [_customObserverMap objectForKey:observerObject.observeKey];
-    if(array){
-        [array addObject:observerObject];
+    [[self tokenForObserver:observer create:YES].observeKeys addObject:observeKey];
+    released = _customObserverMap[observeKey];
+    if (released) {
+        _customObserverMap[observeKey] = [released arrayByAddingObject:observerObject];
     }
-    else{
-        array = [[NSMutableArray alloc] init];
-        [array addObject:observerObject];
-        [_customObserverMap setObject:array forKey:observerObject.observeKey];
-        [_observedObject addObserver:self forKeyPath:observerObject.observeKey options:NSKeyValueObservingOptionOld|NSKeyValueObservingOptionNew|NSKeyValueObservingOptionInitial context:NULL];
+    else {
+        _customObserverMap[observeKey] = @[observerObject];
+        // The initial notification is sent below, once the lock is released, so its callbacks can register and
+        // unregister freely.
+        notifyInitial = (options & NSKeyValueObservingOptionInitial) != 0;
+        [_observedObject addObserver:self forKeyPath:observeKey options:options & ~NSKeyValueObservingOptionInitial context:NULL];
     }
     pthread_mutex_unlock(&_observerMutex);
+    released = nil;
+    
+    if (notifyInitial) {
+        id initialValue = [self.observedObject valueForKey:observeKey];
+        if (initialValue) {
+            [self observeValueForKeyPath:observeKey ofObject:self.observedObject change:@{NSKeyValueChangeNewKey : initialValue} context:NULL];
+        }
+    }
     
     if (observerObject.observeSubpath)
     {
-        id subObject = [self.observedObject valueForKey:observerObject.observeKey];
+        id subObject = [self.observedObject valueForKey:observeKey];
         if (subObject)
         {
             __weak DUXBetaCustomKVOObserver *weakObserverObject = observerObject;
@@ -134,145 +390,69 @@
     }
 }
 
-- (void)unregisterCustomObserver:(NSObject *)observer forKeyPath:(NSString *)keyPath{
-    NSRange range = [keyPath rangeOfString:@"."];
-    NSString *observeKey = nil;
-    NSString *observeSubpath = nil;
-    if (range.location == NSNotFound)
-    {
-        observeKey = keyPath;
+/**
+ *  Replaces the snapshot for the key with one that excludes the matching observers. Must be called with the observer
+ *  lock held, the previous snapshot is handed to released so it is not freed under the lock.
+ */
+- (void)removeObserverObjectsForKey:(NSString *)observeKey token:(DUXBetaCustomObserverToken *)token released:(NSMutableArray *)released passingTest:(BOOL (^)(DUXBetaCustomKVOObserver *callback))test
+{
+    NSArray<DUXBetaCustomKVOObserver *> *array = _customObserverMap[observeKey];
+    if (array == nil) return;
+    
+    NSIndexSet *removed = [array indexesOfObjectsPassingTest:^BOOL(DUXBetaCustomKVOObserver *callback, NSUInteger idx, BOOL *stop) {
+        return test(callback);
+    }];
+    if (removed.count == 0) return;
+    
+    [released addObject:array];
+    for (NSUInteger i = 0; i < removed.count; i++) {
+        [token.observeKeys removeObject:observeKey];
     }
-    else
-    {
-        observeKey = [keyPath substringToIndex:range.location];
-        observeSubpath = [keyPath substringFromIndex:range.location - 1];
+    if (removed.count == array.count) {
+        [_customObserverMap removeObjectForKey:observeKey];
+        [_observedObject removeObserver:self forKeyPath:observeKey];
     }
-    
-    pthread_mutex_lock(&_observerMutex);
-    NSMutableArray *array = _customObserverMap[observeKey];
-    if(array){
-        NSMutableArray *toRemoved = [[NSMutableArray alloc] init];
-        for (DUXBetaCustomKVOObserver *callback in array) {
-            if(callback.object == observer){
-                if (callback.observeSubpath == nil && observeSubpath == nil)
-                {
-                    [toRemoved addObject:callback];
-                }
-                else if(callback.observeSubpath && observeSubpath && [callback.observeSubpath isEqualToString:observeSubpath])
-                {
-                    [toRemoved addObject:callback];
-                }
-            }
-        }
-        [array removeObjectsInArray:toRemoved];
-        if(array.count == 0){
-            [_customObserverMap removeObjectForKey:observeKey];
-            [_observedObject removeObserver:self forKeyPath:observeKey];
-        }
+    else {
+        NSMutableArray *remaining = [array mutableCopy];
+        [remaining removeObjectsAtIndexes:removed];
+        _customObserverMap[observeKey] = [remaining copy];
     }
-    pthread_mutex_unlock(&_observerMutex);
 }
 
-- (void)unregisterCustomObserver:(NSObject *)observer{
-	pthread_mutex_lock(&_observerMutex);
-	NSArray *observeKeys = _customObserverMap.allKeys;
-	for (NSString *observeKey in observeKeys)
-	{
-		NSMutableArray *array = _customObserverMap[observeKey];
-		if(array){
-			NSMutableArray *toRemoved = [[NSMutableArray alloc] init];
-			for (DUXBetaCustomKVOObserver *callback in array) {
-				if(callback.object == observer){
-					[toRemoved addObject:callback];
-				}
-			}
-			[array removeObjectsInArray:toRemoved];
-			if(array.count == 0){
-				[_customObserverMap removeObjectForKey:observeKey];
-				[_observedObject removeObserver:self forKeyPath:observeKey];
-			}
-		}
-	}
-	pthread_mutex_unlock(&_observerMutex);
-
-}
-
-- (void)unregisterAllCustomObservers{
+- (void)pruneReleasedObserversForKeys:(NSSet<NSString *> *)observeKeys
+{
+    NSMutableArray *released = [[NSMutableArray alloc] init];
     pthread_mutex_lock(&_observerMutex);
-    for (NSString *keyPath in _customObserverMap.allKeys) {
-        [_observedObject removeObserver:self forKeyPath:keyPath];
+    for (NSString *observeKey in observeKeys) {
+        [self removeObserverObjectsForKey:observeKey token:nil released:released passingTest:^BOOL(DUXBetaCustomKVOObserver *callback) {
+            return callback.object == nil;
+        }];
     }
-    [_customObserverMap removeAllObjects];
     pthread_mutex_unlock(&_observerMutex);
+    released = nil;
 }
 
-- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary<NSString *,id> *)change context:(void *)context{
-    id oldValue = change[NSKeyValueChangeOldKey];
-    id newValue = change[NSKeyValueChangeNewKey];
-	if (oldValue == [NSNull null]) oldValue = nil;
-	if (newValue == [NSNull null]) newValue = nil;
+- (DUXBetaCustomObserverToken *)tokenForObserver:(NSObject *)observer create:(BOOL)create
+{
+    if (observer == nil) return nil;
+    DUXBetaCustomObserverToken *token = objc_getAssociatedObject(observer, (__bridge const void *)self);
+    if (token.runtime != self) {
+        // Left behind by a released runtime that had the same address.
+        token = nil;
+    }
+    if (token == nil && create) {
+        token = [[DUXBetaCustomObserverToken alloc] init];
+        token.runtime = self;
+        token.observeKeys = [[NSCountedSet alloc] init];
+        objc_setAssociatedObject(observer, (__bridge const void *)self, token, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return token;
+}
 
-    if((!(oldValue == nil && newValue == nil)) && ![oldValue isEqual:newValue]){
-        pthread_mutex_trylock(&_observerMutex);
-        NSArray *array = [_customObserverMap objectForKey:keyPath];
-        if (array != nil) array = [array copy];
-        pthread_mutex_unlock(&_observerMutex);
-        
-        if(array){
-            NSMutableArray *emptyCallback = nil;
-            for (DUXBetaCustomKVOObserver *callback in array) {
-                if (callback.object == nil)
-                {
-                    if (emptyCallback == nil) emptyCallback = [[NSMutableArray alloc] init];
-                    [emptyCallback addObject:callback];
-                }
-                else
-                {
-                    if (callback.observeSubpath) //如果监听的是路径，则在第一级key上增加监听器。
-                    {
-                        if (oldValue)
-                        {
-                            [oldValue duxbeta_removeCustomObserver:callback forKeyPath:callback.observeSubpath];
-                        }
-                        if (newValue)
-                        {
-                            __weak DUXBetaCustomKVOObserver *weakCallback = callback;
-                            [newValue duxbeta_addCustomObserver:callback forKeyPath:callback.observeSubpath block:^(id  _Nullable oldValue, id  _Nullable newValue) {
-                                if (weakCallback == nil) return;
-                                [weakCallback callbackWithOldValue:oldValue withNewValue:newValue];
-                            }];
-                        }
-                        id oldSubValue = oldValue?[oldValue duxbeta_customValueForKeyPath:callback.observeSubpath]:nil;
-                        id newSubValue = newValue?[newValue duxbeta_customValueForKeyPath:callback.observeSubpath]:nil;
-						if (oldSubValue == [NSNull null]) oldSubValue = nil;
-						if (newSubValue == [NSNull null]) newSubValue = nil;
-
-                        if ((!(oldSubValue == nil && newSubValue == nil)) && ![oldSubValue isEqual:newSubValue])
-                        {
-                            [callback callbackWithOldValue:oldSubValue withNewValue:newSubValue];
-                        }
-                    }
-                    else
-                    {
-                        [callback callbackWithOldValue:oldValue withNewValue:newValue];
-                    }
-                }
-            }
-            if (emptyCallback) //If found some already release observer, should release.
-            {
-                pthread_mutex_lock(&_observerMutex);
-                NSMutableArray *array = _customObserverMap[keyPath];
-                if(array){
-                    [array removeObjectsInArray:emptyCallback];
-                    if (array.count == 0)
-                    {
-                        [_customObserverMap removeObjectForKey:keyPath];
-                        [_observedObject removeObserver:self forKeyPath:keyPath];
-                    }
-                }
-                pthread_mutex_unlock(&_observerMutex);
-            }
-        }
+- (void)releaseTokenIfUnused:(DUXBetaCustomObserverToken *)token observer:(NSObject *)observer
+{
+    if (token && token.observeKeys.count == 0) {
+        objc_setAssociatedObject(observer, (__bridge const void *)self, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
     }
 }
 
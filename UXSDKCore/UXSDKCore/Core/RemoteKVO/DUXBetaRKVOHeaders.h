@@ -33,6 +33,7 @@
 #import <UXSDKCore/NSError+DUXBetaCustomKVO.h>
 #import <UXSDKCore/DUXBetaCustomValueConfirmation.h>
 #import <UXSDKCore/NSObject+DUXBetaCustomKVO.h>
+#import <UXSDKCore/DUXBetaBindingInstrumentation.h>
 
 #import <UXSDKCore/NSObject+DUXBetaSDKBind.h>
 #import <UXSDKCore/NSObject+DUXBetaCommand.h>
@@ -94,6 +94,14 @@
  */
 - (void)duxbeta_removeCustomObserver:(nonnull NSObject *)observer;
 
+/**
+ *  Count of changes merged into a later one because they arrived while the same key path was still being
+ *  delivered on another thread.
+ *
+ *  @return merged change count, 0 if nothing observes the receiver.
+ */
+- (NSUInteger)duxbeta_coalescedCustomNotificationCount;
+
 @end
 
 @interface NSObject (DUXBetaCustomAsyncKVO)
@@ -27,6 +27,7 @@
 #import "NSObject+DUXBetaCustomKVO.h"
 #import "DUXBetaCustomObserverRuntime.h"
 #import "DUXBetaCustomValueConfirmation.h"
+#import "DUXBetaCustomKeyPath.h"
 #import <objc/runtime.h>
 #import <objc/objc.h>
 
@@ -86,6 +87,11 @@ if(__name__ == nil){ \
     [runtime unregisterAllCustomObservers];
 }
 
+- (NSUInteger)duxbeta_coalescedCustomNotificationCount{
+    DUXBetaCustomObserverRuntime *runtime = objc_getAssociatedObject(self, DUXBetaCustomObserverKey);
+    return runtime.coalescedNotificationCount;
+}
+
 //DO NOT USE THIE METHOD! Because it will let runtime be autorelease, and delay release, cause crash.
 - (DUXBetaCustomObserverRuntime *)customObserver{
     DUXBetaCustomObserverRuntime *runtime = objc_getAssociatedObject(self, DUXBetaCustomObserverKey);
@@ -102,22 +108,7 @@ if(__name__ == nil){ \
 
 - (nullable id)duxbeta_customValueForKeyPath:(nonnull NSString *)keyPath
 {
-    NSArray *array = [keyPath componentsSeparatedByString:@"."];
-    id lastValue = nil;
-    for (int i = 0;i < array.count; i++) {
-        if (i == 0){
-            lastValue = [self valueForKey:array[i]];
-        }
-        else
-        {
-            lastValue = [lastValue valueForKey:array[i]];
-        }
-        if (lastValue == nil)
-        {
-            break;
-        }
-    }
-    return lastValue;
+    return [[DUXBetaCustomKeyPath keyPathWithString:keyPath] valueForObject:self];
 }
 
 - (void)duxbeta_setCustomValue:(nullable id)value forKeyPath:(nonnull NSString *)keyPath completion:(nullable DUXBetaCustomValueSetCompletionBlock)block
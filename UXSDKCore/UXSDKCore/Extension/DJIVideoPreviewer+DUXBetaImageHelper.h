@@ -26,6 +26,7 @@
 //
 
 #import <DJIWidget/DJIWidget.h>
+#import <UXSDKCore/DUXBetaSnapshotDistributor.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -33,12 +34,12 @@ typedef void(^snapshotReceiverBlock)(UIImage* snapshot);
 
 /**
  * The methods in the DJIVideoPreviewer ImageHelper category are designed to facilitate easy snapshot access from the previewer
- * by supporting multiple snapshot invocations instead of a single invocation. It also will remove callbacks which contain
- * no image data.
+ * by supporting multiple snapshot invocations instead of a single invocation. Snapshots are taken as frames are decoded,
+ * only while there are receivers, and every receiver due for a frame shares the same image.
  */
 // This helper extension only supports snapshots, not thumbnails currently.
 @interface  DJIVideoPreviewer (ImageHelper)
-@property (nonatomic, strong) NSMutableDictionary *DUXBetaSnapshottersDict;
+@property (nonatomic, strong, readonly) DUXBetaSnapshotDistributor *DUXBetaSnapshotDistributor;
 
 /**
  * Call addPersistentSnapshotPreview to add a callback block for snapshots which will be called for each decoded frame. This block
@@ -46,6 +47,11 @@ typedef void(^snapshotReceiverBlock)(UIImage* snapshot);
  */
 - (void)addPersistentSnapshotPreview:(snapshotReceiverBlock)persisentBlock;
 
+/**
+ * Same as addPersistentSnapshotPreview, with the block called at most framesPerSecond times per second. The default is 60.
+ */
+- (void)addPersistentSnapshotPreview:(snapshotReceiverBlock)persisentBlock maximumRate:(double)framesPerSecond;
+
 /**
  * Call removePersistentSnapshotPreview to remove the persistent block added with addPersistentSnapshotPreview, which will prevent it
  * from being called again.
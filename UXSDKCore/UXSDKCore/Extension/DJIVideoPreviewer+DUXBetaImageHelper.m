@@ -28,130 +28,78 @@
 #import "DJIVideoPreviewer+DUXBetaImageHelper.h"
 #import <objc/runtime.h>
 
-// Key for the dict in the associated object.
-static void *DUXBetaSnapshottersDictKey = "DUXBetaSnapshottersDictKey";
-// The global queue for the snapshotter.
-static dispatch_queue_t _DUXBetaSnapshotterHelperQueue;
+// Keys for the distributor and its frame processor in the associated objects.
+static void *DUXBetaSnapshotDistributorKey = "DUXBetaSnapshotDistributorKey";
+static void *DUXBetaSnapshotFrameProcessorKey = "DUXBetaSnapshotFrameProcessorKey";
+// Matches the previewer's highest supported frame rate.
+static const double DUXBetaDefaultSnapshotRate = 60.0;
 
-// Macro to validated and create snapshotter dispatch queue if needed.
-#define validate_processing_queue { if (_DUXBetaSnapshotterHelperQueue == nil) { _DUXBetaSnapshotterHelperQueue = dispatch_queue_create("snapshotterHelperQueue", DISPATCH_QUEUE_SERIAL); } }
+/**
+ * Forwards the previewer's decoded frame events to the distributor. It is registered once with the distributor and
+ * only enabled while the distributor has receivers.
+ */
+@interface DUXBetaSnapshotFrameProcessor : NSObject <VideoFrameProcessor>
+
+@property (nonatomic, weak) DUXBetaSnapshotDistributor *distributor;
+
+@end
+
+@implementation DUXBetaSnapshotFrameProcessor
+
+- (BOOL)videoProcessorEnabled {
+    return self.distributor.isActive;
+}
+
+- (void)videoProcessFrame:(VideoFrameYUV *)frame {
+    [self.distributor frameDidArrive];
+}
+
+@end
 
 @implementation  DJIVideoPreviewer (ImageHelper)
 
 - (void)addPersistentSnapshotPreview:(snapshotReceiverBlock)persistentBlock {
-    validate_processing_queue;
-
-    NSMutableDictionary *workDict = self.DUXBetaSnapshottersDict;
-    dispatch_async(_DUXBetaSnapshotterHelperQueue, ^(){
-        NSMutableArray *snapshotters = workDict[@"persistent"];
-        if (snapshotters == nil) {
-            snapshotters = [NSMutableArray arrayWithObject:persistentBlock];
-            workDict[@"persistent"] = snapshotters;
-        } else {
-            if ([snapshotters indexOfObject:persistentBlock] == NSNotFound) {
-                [snapshotters addObject:persistentBlock];
-            }
-        }
-        [self installMySnapshotter];
+    [self addPersistentSnapshotPreview:persistentBlock maximumRate:DUXBetaDefaultSnapshotRate];
+}
 
-    });
+- (void)addPersistentSnapshotPreview:(snapshotReceiverBlock)persistentBlock maximumRate:(double)framesPerSecond {
+    [self.DUXBetaSnapshotDistributor addReceiver:persistentBlock maximumRate:framesPerSecond];
 }
 
 - (void)removePersistentSnapshotPreview:(snapshotReceiverBlock)persisentBlock {
-    validate_processing_queue;
-
-    NSMutableDictionary *workDict = self.DUXBetaSnapshottersDict;
-    dispatch_async(_DUXBetaSnapshotterHelperQueue, ^(){
-        NSMutableArray *snapshotters = workDict[@"persistent"];
-        if (snapshotters) {
-            [snapshotters removeObjectsInArray:@[persisentBlock]];
-        }
-    });
+    [self.DUXBetaSnapshotDistributor removeReceiver:persisentBlock];
 }
 
 - (void)addOneshotSnapshotPreview:(snapshotReceiverBlock)persistentBlock {
-    validate_processing_queue;
-
-    NSMutableDictionary *workDict = self.DUXBetaSnapshottersDict;
-        dispatch_async(_DUXBetaSnapshotterHelperQueue, ^(){
-        NSMutableArray *snapshotters = workDict[@"transient"];
-        if (snapshotters == nil) {
-            snapshotters = [NSMutableArray arrayWithObject:persistentBlock];
-            workDict[@"transient"] = snapshotters;
-        } else {
-            [snapshotters addObject:persistentBlock];
-        }
-        [self installMySnapshotter];
-    });
+    [self.DUXBetaSnapshotDistributor addOneshotReceiver:persistentBlock];
 }
 
-- (void)installMySnapshotter {
-    [self snapshotPreview:^(UIImage *image) {
-        // Distribute to the snapshot requests here
-        // First, make a safe copy of the UIImage ourside the normal snapshot flow, then distribute. Do not thread due to
-        if (image == nil) {
-            // Nothing was prepped in the decoder on the install. It gave an immediate callback and didn't save the block. Try
-            // again in 0.01666 seconds.
-            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.01666 * NSEC_PER_SEC)), _DUXBetaSnapshotterHelperQueue, ^{
-                [self installMySnapshotter];
-            });
-            return;
-        } else {
-        }
-        UIImage *safeImage = [image copy];
-        NSMutableDictionary *workDict = self.DUXBetaSnapshottersDict;
-
-        dispatch_async(_DUXBetaSnapshotterHelperQueue, ^(){
-            NSMutableArray *persistent = workDict[@"persistent"];
-            NSMutableArray *transient = workDict[@"transient"];
-            
-            NSMutableArray *nextPersistent = [NSMutableArray new];
-            for (NSUInteger index = 0; index < persistent.count; index++) {
-                __weak snapshotReceiverBlock callback = persistent[index];
-
-                persistent[index] = [NSNull null];  // Allow any dangling handler to release. Now callback will also be nil
-                if (callback != nil) {
-                    [nextPersistent addObject:callback];    // Save the persistent callback for next time
-                    dispatch_async(dispatch_get_main_queue(), ^(){
-                        callback(safeImage);
-                    });
+- (DUXBetaSnapshotDistributor *)DUXBetaSnapshotDistributor {
+    @synchronized (self) {
+        DUXBetaSnapshotDistributor *distributor = objc_getAssociatedObject(self, DUXBetaSnapshotDistributorKey);
+        if (distributor == nil) {
+            __weak typeof(self) weakSelf = self;
+            distributor = [[DUXBetaSnapshotDistributor alloc] initWithSnapshotProvider:^(void (^completion)(UIImage *)) {
+                DJIVideoPreviewer *previewer = weakSelf;
+                if (previewer == nil) {
+                    completion(nil);
+                    return;
                 }
-            }
-            workDict[@"persistent"] = nextPersistent;       // Now any surviving persistent callback can be preserved for the next snapshot
+                [previewer snapshotPreview:completion];
+            }];
             
-            if (transient) {
-                // Now work through the transient list if it exists, but we don't need to save any of them off for next time.
-                for (NSUInteger index = 0; index < transient.count; index++) {
-                    __weak snapshotReceiverBlock callback = transient[index];
-                    if (callback != nil) {
-                        callback(image);
-                    }
-                }
-                workDict[@"transient"] = nil;   // Remove all transient image callbacks
-            }
-        });
-        // The 0.1666 seconds should support framerates up to 60fps (.0166666 seconds per frame)
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.01666 * NSEC_PER_SEC)), _DUXBetaSnapshotterHelperQueue, ^{
-            NSMutableDictionary *workDict = self.DUXBetaSnapshottersDict;
-            NSMutableArray *persistent = workDict[@"persistent"];
-            NSMutableArray *transient = workDict[@"transient"];
-            if ((persistent.count > 0 || (transient.count > 0))) {
-                [self installMySnapshotter];
-            }
-        });
-    }];
-}
-
-- (NSMutableDictionary*)DUXBetaSnapshottersDict {
-    NSMutableDictionary *outDict = objc_getAssociatedObject(self, DUXBetaSnapshottersDictKey);
-    if (outDict == nil) {
-        outDict = [NSMutableDictionary new];
-        self.DUXBetaSnapshottersDict = outDict;
+            DUXBetaSnapshotFrameProcessor *processor = [[DUXBetaSnapshotFrameProcessor alloc] init];
+            processor.distributor = distributor;
+            objc_setAssociatedObject(self, DUXBetaSnapshotFrameProcessorKey, processor, OBJC_ASSOCIATION_RETAIN);
+            objc_setAssociatedObject(self, DUXBetaSnapshotDistributorKey, distributor, OBJC_ASSOCIATION_RETAIN);
+            
+            // The previewer's processor list is not thread safe, it is only changed from the main queue.
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [weakSelf registFrameProcessor:processor];
+            });
+        }
+        return distributor;
     }
-    return outDict;
 }
 
-- (void)setDUXBetaSnapshottersDict:(NSMutableDictionary*)snapshottersDict {
-    objc_setAssociatedObject(self, DUXBetaSnapshottersDictKey, snapshottersDict, OBJC_ASSOCIATION_RETAIN);  // Specifically atomic access
-}
 @end
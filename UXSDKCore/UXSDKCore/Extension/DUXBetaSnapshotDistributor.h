@@ -0,0 +1,90 @@
+//
+//  DUXBetaSnapshotDistributor.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void (^DUXBetaSnapshotReceiver)(UIImage *snapshot);
+
+/**
+ * Renders one snapshot of the current frame and calls the completion with it, or with nil when no frame is ready.
+ */
+typedef void (^DUXBetaSnapshotProvider)(void (^completion)(UIImage * _Nullable snapshot));
+
+/**
+ * Hands snapshots out to receivers as frames arrive. A frame is only rendered when at least one receiver is due,
+ * every receiver due for it gets the same image, and all of them are called in a single block on the delivery queue.
+ * Persistent receivers are limited to their own maximum rate, oneshot receivers get the next frame.
+ */
+@interface DUXBetaSnapshotDistributor : NSObject
+
+- (instancetype)initWithSnapshotProvider:(DUXBetaSnapshotProvider)provider NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * The queue receivers are called on, the main queue by default.
+ */
+@property (nonatomic, strong) dispatch_queue_t deliveryQueue;
+
+/**
+ * Called with YES when the first receiver is added and with NO when the last one is gone, so the frame source
+ * only needs to run while someone is listening.
+ */
+@property (nonatomic, copy, nullable) void (^activityHandler)(BOOL active);
+
+@property (nonatomic, assign, readonly, getter=isActive) BOOL active;
+
+/**
+ * How long a requested snapshot may take before it is given up on and the next frame renders a new one, 1 second
+ * by default. A completion arriving after that is ignored.
+ */
+@property (nonatomic, assign) NSTimeInterval snapshotTimeout;
+
+- (void)addReceiver:(DUXBetaSnapshotReceiver)receiver maximumRate:(double)framesPerSecond;
+- (void)removeReceiver:(DUXBetaSnapshotReceiver)receiver;
+- (void)addOneshotReceiver:(DUXBetaSnapshotReceiver)receiver;
+
+/**
+ * Called by the frame source for every decoded frame. Cheap when no receiver is due.
+ */
+- (void)frameDidArrive;
+- (void)frameDidArriveAtTime:(uint64_t)time;
+
+/**
+ * Counters since the last reset: wakeups are frames that rendered a snapshot plus delivery blocks,
+ * snapshots are rendered images and deliveries are receiver calls.
+ */
+@property (nonatomic, assign, readonly) uint64_t wakeupCount;
+@property (nonatomic, assign, readonly) uint64_t snapshotCount;
+@property (nonatomic, assign, readonly) uint64_t deliveryCount;
+
+- (void)resetCounters;
+
+@end
+
+NS_ASSUME_NONNULL_END
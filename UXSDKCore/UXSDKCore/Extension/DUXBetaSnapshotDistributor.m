@@ -0,0 +1,252 @@
+//
+//  DUXBetaSnapshotDistributor.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaSnapshotDistributor.h"
+#import <pthread/pthread.h>
+#import <stdatomic.h>
+
+@interface DUXBetaSnapshotReceiverEntry : NSObject
+
+@property (nonatomic, copy) DUXBetaSnapshotReceiver receiver;
+@property (nonatomic, assign) uint64_t minimumInterval;
+@property (nonatomic, assign) uint64_t lastDeliveryTime;
+@property (nonatomic, assign) BOOL oneshot;
+
+@end
+
+@implementation DUXBetaSnapshotReceiverEntry
+@end
+
+@interface DUXBetaSnapshotDistributor ()
+{
+    pthread_mutex_t _mutex;
+    atomic_ullong _wakeupCount;
+    atomic_ullong _snapshotCount;
+    atomic_ullong _deliveryCount;
+}
+
+@property (nonatomic, copy) DUXBetaSnapshotProvider provider;
+
+// Guarded by _mutex.
+@property (nonatomic, strong) NSMutableArray<DUXBetaSnapshotReceiverEntry *> *entries;
+@property (nonatomic, assign) uint64_t nextDueTime;
+@property (nonatomic, assign) BOOL snapshotInFlight;
+@property (nonatomic, assign) uint64_t snapshotRequestTime;
+// Identifies the snapshot in flight, a completion for an earlier one is stale.
+@property (nonatomic, assign) uint64_t snapshotGeneration;
+
+@end
+
+@implementation DUXBetaSnapshotDistributor
+
+- (instancetype)initWithSnapshotProvider:(DUXBetaSnapshotProvider)provider {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        _provider = [provider copy];
+        _entries = [[NSMutableArray alloc] init];
+        _deliveryQueue = dispatch_get_main_queue();
+        _snapshotTimeout = 1.0;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (BOOL)isActive {
+    pthread_mutex_lock(&_mutex);
+    BOOL active = self.entries.count > 0;
+    pthread_mutex_unlock(&_mutex);
+    return active;
+}
+
+#pragma mark - Receivers
+
+- (void)addReceiver:(DUXBetaSnapshotReceiver)receiver maximumRate:(double)framesPerSecond {
+    DUXBetaSnapshotReceiverEntry *entry = [[DUXBetaSnapshotReceiverEntry alloc] init];
+    entry.receiver = receiver;
+    entry.minimumInterval = framesPerSecond > 0 ? (uint64_t)(NSEC_PER_SEC / framesPerSecond) : 0;
+    
+    pthread_mutex_lock(&_mutex);
+    for (DUXBetaSnapshotReceiverEntry *existing in self.entries) {
+        if (!existing.oneshot && existing.receiver == receiver) {
+            pthread_mutex_unlock(&_mutex);
+            return;
+        }
+    }
+    [self addEntry:entry];
+}
+
+- (void)addOneshotReceiver:(DUXBetaSnapshotReceiver)receiver {
+    DUXBetaSnapshotReceiverEntry *entry = [[DUXBetaSnapshotReceiverEntry alloc] init];
+    entry.receiver = receiver;
+    entry.oneshot = YES;
+    
+    pthread_mutex_lock(&_mutex);
+    [self addEntry:entry];
+}
+
+// Called with the mutex held, releases it.
+- (void)addEntry:(DUXBetaSnapshotReceiverEntry *)entry {
+    BOOL activated = self.entries.count == 0;
+    [self.entries addObject:entry];
+    // A new receiver is due on the next frame.
+    self.nextDueTime = 0;
+    pthread_mutex_unlock(&_mutex);
+    
+    if (activated && self.activityHandler) {
+        self.activityHandler(YES);
+    }
+}
+
+- (void)removeReceiver:(DUXBetaSnapshotReceiver)receiver {
+    pthread_mutex_lock(&_mutex);
+    NSUInteger countBefore = self.entries.count;
+    NSIndexSet *matches = [self.entries indexesOfObjectsPassingTest:^BOOL(DUXBetaSnapshotReceiverEntry *entry, NSUInteger index, BOOL *stop) {
+        return !entry.oneshot && entry.receiver == receiver;
+    }];
+    [self.entries removeObjectsAtIndexes:matches];
+    [self updateNextDueTime];
+    BOOL deactivated = countBefore > 0 && self.entries.count == 0;
+    pthread_mutex_unlock(&_mutex);
+    
+    if (deactivated && self.activityHandler) {
+        self.activityHandler(NO);
+    }
+}
+
+// Called with the mutex held.
+- (void)updateNextDueTime {
+    uint64_t nextDueTime = UINT64_MAX;
+    for (DUXBetaSnapshotReceiverEntry *entry in self.entries) {
+        nextDueTime = MIN(nextDueTime, [self dueTimeForEntry:entry]);
+    }
+    self.nextDueTime = nextDueTime;
+}
+
+- (uint64_t)dueTimeForEntry:(DUXBetaSnapshotReceiverEntry *)entry {
+    if (entry.oneshot || entry.lastDeliveryTime == 0) {
+        return 0;
+    }
+    // Allow an eighth of the interval early, so a receiver at the frame rate does not skip frames on jitter.
+    return entry.lastDeliveryTime + entry.minimumInterval - entry.minimumInterval / 8;
+}
+
+#pragma mark - Frames
+
+- (void)frameDidArrive {
+    [self frameDidArriveAtTime:clock_gettime_nsec_np(CLOCK_UPTIME_RAW)];
+}
+
+- (void)frameDidArriveAtTime:(uint64_t)time {
+    uint64_t timeout = (uint64_t)(self.snapshotTimeout * NSEC_PER_SEC);
+    pthread_mutex_lock(&_mutex);
+    BOOL waiting = self.snapshotInFlight && time < self.snapshotRequestTime + timeout;
+    if (self.entries.count == 0 || waiting || time < self.nextDueTime) {
+        pthread_mutex_unlock(&_mutex);
+        return;
+    }
+    self.snapshotInFlight = YES;
+    self.snapshotRequestTime = time;
+    uint64_t generation = ++self.snapshotGeneration;
+    pthread_mutex_unlock(&_mutex);
+    
+    atomic_fetch_add_explicit(&_wakeupCount, 1, memory_order_relaxed);
+    __weak typeof(self) weakSelf = self;
+    self.provider(^(UIImage *snapshot) {
+        [weakSelf distributeSnapshot:snapshot atTime:time generation:generation];
+    });
+}
+
+- (void)distributeSnapshot:(UIImage *)snapshot atTime:(uint64_t)time generation:(uint64_t)generation {
+    NSMutableArray<DUXBetaSnapshotReceiver> *due = [[NSMutableArray alloc] init];
+    BOOL deactivated = NO;
+    
+    pthread_mutex_lock(&_mutex);
+    if (generation != self.snapshotGeneration) {
+        pthread_mutex_unlock(&_mutex);
+        return;
+    }
+    self.snapshotInFlight = NO;
+    if (snapshot != nil) {
+        NSMutableIndexSet *finished = [[NSMutableIndexSet alloc] init];
+        [self.entries enumerateObjectsUsingBlock:^(DUXBetaSnapshotReceiverEntry *entry, NSUInteger index, BOOL *stop) {
+            if (time < [self dueTimeForEntry:entry]) {
+                return;
+            }
+            [due addObject:entry.receiver];
+            entry.lastDeliveryTime = time;
+            if (entry.oneshot) {
+                [finished addIndex:index];
+            }
+        }];
+        [self.entries removeObjectsAtIndexes:finished];
+        [self updateNextDueTime];
+        deactivated = finished.count > 0 && self.entries.count == 0;
+    }
+    pthread_mutex_unlock(&_mutex);
+    
+    if (snapshot != nil) {
+        atomic_fetch_add_explicit(&_snapshotCount, 1, memory_order_relaxed);
+    }
+    if (due.count > 0) {
+        atomic_fetch_add_explicit(&_wakeupCount, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&_deliveryCount, due.count, memory_order_relaxed);
+        dispatch_async(self.deliveryQueue, ^{
+            for (DUXBetaSnapshotReceiver receiver in due) {
+                receiver(snapshot);
+            }
+        });
+    }
+    if (deactivated && self.activityHandler) {
+        self.activityHandler(NO);
+    }
+}
+
+#pragma mark - Counters
+
+- (uint64_t)wakeupCount {
+    return atomic_load_explicit(&_wakeupCount, memory_order_relaxed);
+}
+
+- (uint64_t)snapshotCount {
+    return atomic_load_explicit(&_snapshotCount, memory_order_relaxed);
+}
+
+- (uint64_t)deliveryCount {
+    return atomic_load_explicit(&_deliveryCount, memory_order_relaxed);
+}
+
+- (void)resetCounters {
+    atomic_store_explicit(&_wakeupCount, 0, memory_order_relaxed);
+    atomic_store_explicit(&_snapshotCount, 0, memory_order_relaxed);
+    atomic_store_explicit(&_deliveryCount, 0, memory_order_relaxed);
+}
+
+@end
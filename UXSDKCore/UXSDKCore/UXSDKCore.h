@@ -40,6 +40,8 @@ FOUNDATION_EXPORT const unsigned char UXSDKCoreVersionString[];
 /*********************************************************************************/
 #import <UXSDKCore/DUXBetaSingleton.h>
 #import <UXSDKCore/DUXBetaKeyManager.h>
+#import <UXSDKCore/DUXBetaTelemetryLog.h>
+#import <UXSDKCore/DUXBetaTelemetryRecordingKeyHandler.h>
 #import <UXSDKCore/DUXBetaWarningMessage.h>
 
 /*********************************************************************************/
@@ -66,6 +68,7 @@ FOUNDATION_EXPORT const unsigned char UXSDKCoreVersionString[];
 #import <UXSDKCore/UIFont+DUXBetaFonts.h>
 #import <UXSDKCore/NSBundle+DUXBetaAssets.h>
 #import <UXSDKCore/NSData+DUXBetaAssets.h>
+#import <UXSDKCore/DUXBetaSnapshotDistributor.h>
 #import <UXSDKCore/DJIVideoPreviewer+DUXBetaImageHelper.h>
 
 /*********************************************************************************/
@@ -141,6 +144,8 @@ FOUNDATION_EXPORT const unsigned char UXSDKCoreVersionString[];
 /*****************************************************************************/
 #import <UXSDKCore/DUXBetaFPVDecodeAdapter.h>
 #import <UXSDKCore/DUXBetaFPVDecodeModel.h>
+#import <UXSDKCore/DUXBetaFPVCameraCapabilityTable.h>
+#import <UXSDKCore/DUXBetaFPVDecodeHealthAggregator.h>
 
 /*********************************************************************************/
 // GPS Signal Widget
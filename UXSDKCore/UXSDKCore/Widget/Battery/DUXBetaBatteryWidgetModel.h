@@ -32,6 +32,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface DUXBetaBatteryWidgetModel : DUXBetaBaseWidgetModel
 
+/**
+ *  Recomputed once per turn of the main run loop however many battery keys changed, so it is set on the main queue
+ *  after the key updates rather than within them. Call duxbeta_flushCoalescedRKVO to apply pending updates right away.
+ */
 @property (strong, nonatomic, readonly) DUXBetaBatteryState *batteryState;
 
 @end
@@ -76,7 +76,7 @@ static const NSInteger kDUXBetaBattery2Index = 1;
     BindSDKKey([DJIBatteryKey keyWithIndex:kDUXBetaBattery2Index andParam:DJIBatteryParamLatestWarningRecord], warningRecordBattery2);
     BindSDKKey([DJIBatteryKey keyWithAggregationParam:DJIBatteryParamAggregationState], batteryAggregationState);
 
-    BindRKVOModel(self, @selector(updateStates), isProductConnected, battery1Percentage, battery2Percentage, batteryPercentageNeededToGoHome, overallBatterySystemStatus, battery1Voltages, battery2Voltages, warningRecordBattery1, warningRecordBattery2, batteryAggregationState);
+    BindRKVOModelCoalesced(self, @selector(updateStates), isProductConnected, battery1Percentage, battery2Percentage, batteryPercentageNeededToGoHome, overallBatterySystemStatus, battery1Voltages, battery2Voltages, warningRecordBattery1, warningRecordBattery2, batteryAggregationState);
 }
 
 - (void)inCleanup {
@@ -400,10 +400,13 @@
  * Key: encodeTypeUpdated               Type: NSNumber - Sends the encode type as an NSNumber
  *                                      when encoding type is updated.
  *
- * Key: decodingDidSucceedWithTimestamp     Type: NSNumber - Sends the timestamp as an NSNumber
- *                                          when decoding is successful for a given timestamp.
+ * Key: decodingDidSucceedWithTimestamp     Type: NSNumber - Sends the timestamp of the last decoded frame as an NSNumber
+ *                                          once per decoder health summary period while decoding succeeds.
  *
- * Key: decodingDidFail                 Type: NSNumber - Sends 0 as an NSNumber when decoding fails.
+ * Key: decodingDidFail                 Type: NSNumber - Sends 0 as an NSNumber when the decoder becomes unhealthy.
+ *
+ * Key: decoderHealthUpdated            Type: DUXBetaFPVDecodeHealthSummary - Sends the decoder health summary
+ *                                      once per summary period and right away when the decoder health changes.
  *
  * Key: physicalSourceUpdated           Type: NSNumber - Sends the video physical value as an NSNumber
  *                                      when the physical source is updated.
@@ -428,11 +431,15 @@
     }
     
     @objc public static func decodingDidSucceedWithTimestamp(_ timestamp: UInt32) -> FPVModelState {
-        return FPVModelState(key: "decodingDidSucceedWithTimestamp", number: NSNumber(value: timestamp))
+        return FPVModelState(key: "decodingDidSucceedWithTimestamp", integer: Int64(timestamp))
     }
     
     @objc public static func decodingDidFail() -> FPVModelState {
-        return FPVModelState(key: "decodingDidFail", number: NSNumber(value: 0))
+        return FPVModelState(key: "decodingDidFail", integer: 0)
+    }
+    
+    @objc public static func decoderHealthUpdated(_ summary: DUXBetaFPVDecodeHealthSummary) -> FPVModelState {
+        return FPVModelState(key: "decoderHealthUpdated", object: summary)
     }
     
     @objc public static func physicalSourceUpdated(_ physicalSource: DJIVideoFeedPhysicalSource) -> FPVModelState {
@@ -43,8 +43,10 @@ import DJISDK
     /// The current camera index displayed in the fpv widget.
     dynamic public var preferredCameraIndex = 0 {
         didSet {
-            cleanup()
-            setup()
+            guard preferredCameraIndex != oldValue else { return }
+            if vmState == .setUp {
+                rebindCameraKeys(from: oldValue)
+            }
             updateBandwidthSettings()
         }
     }
@@ -93,20 +95,16 @@ import DJISDK
         if let key = DJIProductKey(param: DJIProductParamModelName) {
             bindSDKKey(key, (\DUXBetaFPVWidgetModel.aircraftModel).toString)
         }
-        if let key = DJICameraKey(index: preferredCameraIndex, andParam: DJICameraParamDisplayName) {
-            bindSDKKey(key, (\DUXBetaFPVWidgetModel.cameraName).toString)
-        }
         if let key = DJIAirLinkKey(index: 0,
                                    subComponent: DJIAirLinkLightbridgeLinkSubComponent,
                                    subComponentIndex: 0,
                                    andParam: DJILightbridgeLinkParamBandwidthAllocationForLeftCamera) {
             bindSDKKey(key, (\DUXBetaFPVWidgetModel.bandwidthAllocationForLeftCamera).toString)
         }
-        if let key = DJICameraKey(index: preferredCameraIndex, andParam: DJICameraParamPhotoAspectRatio) {
-            bindSDKKey(key, (\DUXBetaFPVWidgetModel.photoAspectRatio).toString)
-        }
-        if let key = DJICameraKey(index: preferredCameraIndex, andParam: DJICameraParamVideoResolutionAndFrameRate) {
-            bindSDKKey(key, (\DUXBetaFPVWidgetModel.videoResolutionAndFrameRate).toString)
+        for (param, property) in cameraKeyBindings {
+            if let key = DJICameraKey(index: preferredCameraIndex, andParam: param) {
+                bindSDKKey(key, property)
+            }
         }
         
         bindRKVOModel(self, #selector(updateDisplayedValues), (\DUXBetaFPVWidgetModel.aircraftModel).toString)
@@ -118,6 +116,26 @@ import DJISDK
         unbindRKVOModel(self)
     }
     
+    /// The camera keys bound for the preferred camera index, with the properties they are bound to.
+    fileprivate let cameraKeyBindings: [(String, String)] = [
+        (DJICameraParamDisplayName, (\DUXBetaFPVWidgetModel.cameraName).toString),
+        (DJICameraParamPhotoAspectRatio, (\DUXBetaFPVWidgetModel.photoAspectRatio).toString),
+        (DJICameraParamVideoResolutionAndFrameRate, (\DUXBetaFPVWidgetModel.videoResolutionAndFrameRate).toString)
+    ]
+    
+    /// Swaps only the camera key bindings over to the preferred camera index, the other bindings stay in place.
+    /// The new index's values are read asynchronously, pushes arriving first win over the read.
+    fileprivate func rebindCameraKeys(from oldIndex: Int) {
+        for (param, property) in cameraKeyBindings {
+            if let key = DJICameraKey(index: oldIndex, andParam: param) {
+                unbindSDKKey(key, property)
+            }
+            if let key = DJICameraKey(index: preferredCameraIndex, andParam: param) {
+                bindSDKKey(key, property, mode: .asynchronous)
+            }
+        }
+    }
+    
     @objc public func updateDisplayedValues() {
         guard let displayName0Key = DJICameraKey(index: 0, andParam: DJICameraParamDisplayName) else { return }
         guard let displayName1Key = DJICameraKey(index: 1, andParam: DJICameraParamDisplayName) else { return }
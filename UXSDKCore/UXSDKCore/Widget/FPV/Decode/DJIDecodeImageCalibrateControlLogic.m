@@ -30,12 +30,13 @@
 #import <DJIWidget/DJIDecodeImageCalibrateHelper.h>
 #import <DJIWidget/DJIMavic2ProCameraImageCalibrateFilterDataSource.h>
 #import "DJIDecodeImageCalibrateControlLogic.h"
+#import "DUXBetaFPVCameraCapabilityTable.h"
 
 @interface DJIDecodeImageCalibrateControlLogic(){
     BOOL _calibrateNeeded;
     BOOL _calibrateStandAlone;
-    //data source info
-    NSDictionary* _dataSourceInfo;
+    //data source class of the current camera
+    Class _dataSourceClass;
     //helper for calibration
     DJIImageCalibrateHelper* _helper;
     //calibrate datasource
@@ -54,10 +55,6 @@
 - (instancetype)init{
     if (self = [super init]){
         [self initData];
-        _dataSourceInfo = @{
-                            DJICameraDisplayNameMavic2ZoomCamera:[DJIMavic2ZoomCameraImageCalibrateFilterDataSource class],
-                            DJICameraDisplayNameMavic2ProCamera:[DJIMavic2ProCameraImageCalibrateFilterDataSource class],
-                            };
     }
     return self;
 }
@@ -75,10 +72,8 @@
         return;
     }
     _cameraName = cameraName;
-    BOOL cameraSupported = ([_cameraName isEqualToString:DJICameraDisplayNameMavic2ZoomCamera] ||
-                            [_cameraName isEqualToString:DJICameraDisplayNameMavic2ProCamera]
-                            );
-    _calibrateNeeded = cameraSupported;
+    _dataSourceClass = [[DUXBetaFPVCameraCapabilityTable defaultTable] capabilityForCameraName:cameraName].calibrationDataSourceClass;
+    _calibrateNeeded = (_dataSourceClass != nil);
     _calibrateStandAlone = NO;
 }
 
@@ -124,7 +119,7 @@
 }
 
 -(DJIImageCalibrateFilterDataSource*)calibrateDataSource{
-    Class targetClass = [_dataSourceInfo objectForKey:self.cameraName];
+    Class targetClass = _dataSourceClass;
     if (!targetClass
         || ![targetClass isSubclassOfClass:[DJIImageCalibrateFilterDataSource class]]){
         targetClass = [DJIImageCalibrateFilterDataSource class];
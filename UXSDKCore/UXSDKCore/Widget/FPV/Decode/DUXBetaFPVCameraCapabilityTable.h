@@ -0,0 +1,103 @@
+//
+//  DUXBetaFPVCameraCapabilityTable.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <DJIWidget/DJIWidget.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The stream conditions some cameras pick a different encode type for.
+*/
+typedef NS_OPTIONS(NSUInteger, DUXBetaFPVCameraStreamMode) {
+    DUXBetaFPVCameraStreamModeDefault   = 0,
+    // Handheld product with a camera supporting digital zoom.
+    DUXBetaFPVCameraStreamModeHandheld  = 1 << 0,
+    // Video is streamed over the WiFi link.
+    DUXBetaFPVCameraStreamModeWiFiLink  = 1 << 1
+};
+
+/**
+ * Dictionary keys of a capability entry, the encode types are H264EncoderType raw values.
+*/
+FOUNDATION_EXPORT NSString * const DUXBetaFPVCameraCapabilityEncodeTypeKey;
+FOUNDATION_EXPORT NSString * const DUXBetaFPVCameraCapabilityHandheldEncodeTypeKey;
+FOUNDATION_EXPORT NSString * const DUXBetaFPVCameraCapabilityWiFiLinkEncodeTypeKey;
+FOUNDATION_EXPORT NSString * const DUXBetaFPVCameraCapabilityFitsPhotoAspectRatioKey;
+FOUNDATION_EXPORT NSString * const DUXBetaFPVCameraCapabilityCalibrationDataSourceKey;
+
+/**
+ * What the video previewer needs to know about a camera to display its feed.
+*/
+@interface DUXBetaFPVCameraCapability : NSObject
+
+/**
+ * Creates a capability from a dictionary with the DUXBetaFPVCameraCapability keys. Missing encode types are
+ * H264EncoderType_unknown, the calibration data source is a DJIImageCalibrateFilterDataSource class name.
+*/
+- (instancetype)initWithDictionary:(NSDictionary<NSString *, id> *)dictionary;
+
+@property (nonatomic, assign, readonly) H264EncoderType encodeType;
+
+/**
+ * YES when the photo mode content rect is fitted to the photo aspect ratio.
+*/
+@property (nonatomic, assign, readonly) BOOL fitsPhotoAspectRatio;
+
+/**
+ * The calibration data source class, nil when the camera feed needs no calibration.
+*/
+@property (nonatomic, strong, readonly, nullable) Class calibrationDataSourceClass;
+
+- (H264EncoderType)encodeTypeForMode:(DUXBetaFPVCameraStreamMode)mode;
+
+@end
+
+/**
+ * Camera capabilities keyed by camera display name. The default table covers the cameras known to the SDK and can
+ * be extended or overridden at runtime, for example from a property list shipped with the app.
+*/
+@interface DUXBetaFPVCameraCapabilityTable : NSObject
+
++ (instancetype)defaultTable;
+
+- (nullable DUXBetaFPVCameraCapability *)capabilityForCameraName:(nullable NSString *)cameraName;
+
+/**
+ * The encode type for the camera in the given mode, H264EncoderType_unknown for cameras not in the table.
+*/
+- (H264EncoderType)encodeTypeForCameraName:(nullable NSString *)cameraName mode:(DUXBetaFPVCameraStreamMode)mode;
+
+- (void)registerCapability:(DUXBetaFPVCameraCapability *)capability forCameraName:(NSString *)cameraName;
+
+/**
+ * Registers one capability per camera name from a dictionary of capability dictionaries.
+*/
+- (void)registerCapabilitiesFromDictionary:(NSDictionary<NSString *, NSDictionary<NSString *, id> *> *)dictionary;
+
+@end
+
+NS_ASSUME_NONNULL_END
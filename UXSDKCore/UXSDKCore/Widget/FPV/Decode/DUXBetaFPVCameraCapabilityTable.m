@@ -0,0 +1,188 @@
+//
+//  DUXBetaFPVCameraCapabilityTable.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaFPVCameraCapabilityTable.h"
+#import <DJISDK/DJISDK.h>
+#import <pthread/pthread.h>
+
+NSString * const DUXBetaFPVCameraCapabilityEncodeTypeKey = @"encodeType";
+NSString * const DUXBetaFPVCameraCapabilityHandheldEncodeTypeKey = @"handheldEncodeType";
+NSString * const DUXBetaFPVCameraCapabilityWiFiLinkEncodeTypeKey = @"wifiLinkEncodeType";
+NSString * const DUXBetaFPVCameraCapabilityFitsPhotoAspectRatioKey = @"fitsPhotoAspectRatio";
+NSString * const DUXBetaFPVCameraCapabilityCalibrationDataSourceKey = @"calibrationDataSource";
+
+// One resolved encode type per combination of the two stream mode flags.
+static const NSUInteger kDUXBetaFPVCameraStreamModeCount = 4;
+
+@interface DUXBetaFPVCameraCapability ()
+{
+    H264EncoderType _encodeTypes[kDUXBetaFPVCameraStreamModeCount];
+}
+
+@end
+
+@implementation DUXBetaFPVCameraCapability
+
+- (instancetype)initWithDictionary:(NSDictionary<NSString *, id> *)dictionary {
+    self = [super init];
+    if (self) {
+        H264EncoderType encodeType = [dictionary[DUXBetaFPVCameraCapabilityEncodeTypeKey] intValue];
+        NSNumber *handheld = dictionary[DUXBetaFPVCameraCapabilityHandheldEncodeTypeKey];
+        NSNumber *wifiLink = dictionary[DUXBetaFPVCameraCapabilityWiFiLinkEncodeTypeKey];
+        
+        _encodeType = encodeType;
+        for (NSUInteger mode = 0; mode < kDUXBetaFPVCameraStreamModeCount; mode++) {
+            H264EncoderType resolved = encodeType;
+            if ((mode & DUXBetaFPVCameraStreamModeWiFiLink) && wifiLink != nil) {
+                resolved = [wifiLink intValue];
+            }
+            if ((mode & DUXBetaFPVCameraStreamModeHandheld) && handheld != nil) {
+                resolved = [handheld intValue];
+            }
+            _encodeTypes[mode] = resolved;
+        }
+        
+        _fitsPhotoAspectRatio = [dictionary[DUXBetaFPVCameraCapabilityFitsPhotoAspectRatioKey] boolValue];
+        NSString *dataSourceName = dictionary[DUXBetaFPVCameraCapabilityCalibrationDataSourceKey];
+        if (dataSourceName != nil) {
+            _calibrationDataSourceClass = NSClassFromString(dataSourceName);
+        }
+    }
+    return self;
+}
+
+- (H264EncoderType)encodeTypeForMode:(DUXBetaFPVCameraStreamMode)mode {
+    return _encodeTypes[mode & (kDUXBetaFPVCameraStreamModeCount - 1)];
+}
+
+@end
+
+@interface DUXBetaFPVCameraCapabilityTable ()
+{
+    pthread_mutex_t _mutex;
+}
+
+// Replaced as a whole on registration, so lookups only need the atomic getter.
+@property (atomic, copy) NSDictionary<NSString *, DUXBetaFPVCameraCapability *> *capabilities;
+
+@end
+
+@implementation DUXBetaFPVCameraCapabilityTable
+
++ (instancetype)defaultTable {
+    static DUXBetaFPVCameraCapabilityTable *table = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        table = [[DUXBetaFPVCameraCapabilityTable alloc] init];
+        [table registerCapabilitiesFromDictionary:[self defaultCapabilities]];
+    });
+    return table;
+}
+
++ (NSDictionary<NSString *, NSDictionary<NSString *, id> *> *)defaultCapabilities {
+    NSString *encodeType = DUXBetaFPVCameraCapabilityEncodeTypeKey;
+    NSString *fitsRatio = DUXBetaFPVCameraCapabilityFitsPhotoAspectRatioKey;
+    NSString *calibration = DUXBetaFPVCameraCapabilityCalibrationDataSourceKey;
+    
+    return @{
+        DJICameraDisplayNameX3 : @{encodeType : @(H264EncoderType_DM368_inspire),
+                                   DUXBetaFPVCameraCapabilityHandheldEncodeTypeKey : @(H264EncoderType_A9_OSMO_NO_368),
+                                   fitsRatio : @YES},
+        DJICameraDisplayNameZ3 : @{encodeType : @(H264EncoderType_A9_OSMO_NO_368)},
+        DJICameraDisplayNameX5 : @{encodeType : @(H264EncoderType_DM368_inspire), fitsRatio : @YES},
+        DJICameraDisplayNameX5R : @{encodeType : @(H264EncoderType_DM368_inspire), fitsRatio : @YES},
+        DJICameraDisplayNamePhantom3ProfessionalCamera : @{encodeType : @(H264EncoderType_DM365_phamtom3x), fitsRatio : @YES},
+        DJICameraDisplayNamePhantom3AdvancedCamera : @{encodeType : @(H264EncoderType_A9_phantom3s)},
+        DJICameraDisplayNamePhantom3StandardCamera : @{encodeType : @(H264EncoderType_A9_phantom3c)},
+        DJICameraDisplayNamePhantom4Camera : @{encodeType : @(H264EncoderType_1860_phantom4x)},
+        DJICameraDisplayNameMavicProCamera : @{encodeType : @(H264EncoderType_unknown),
+                                               DUXBetaFPVCameraCapabilityWiFiLinkEncodeTypeKey : @(H264EncoderType_1860_phantom4x),
+                                               fitsRatio : @YES},
+        DJICameraDisplayNameSparkCamera : @{encodeType : @(H264EncoderType_1860_phantom4x)},
+        DJICameraDisplayNameZ30 : @{encodeType : @(H264EncoderType_GD600)},
+        DJICameraDisplayNamePhantom4ProCamera : @{encodeType : @(H264EncoderType_H1_Inspire2)},
+        DJICameraDisplayNamePhantom4AdvancedCamera : @{encodeType : @(H264EncoderType_H1_Inspire2)},
+        DJICameraDisplayNameX5S : @{encodeType : @(H264EncoderType_H1_Inspire2)},
+        DJICameraDisplayNameX4S : @{encodeType : @(H264EncoderType_H1_Inspire2)},
+        DJICameraDisplayNameX7 : @{encodeType : @(H264EncoderType_H1_Inspire2)},
+        DJICameraDisplayNamePayload : @{encodeType : @(H264EncoderType_H1_Inspire2)},
+        DJICameraDisplayNameMavicAirCamera : @{encodeType : @(H264EncoderType_MavicAir)},
+        DJICameraDisplayNameMavicMiniCamera : @{encodeType : @(H264EncoderType_MavicMini)},
+        DJICameraDisplayNameMavic2ZoomCamera : @{calibration : @"DJIMavic2ZoomCameraImageCalibrateFilterDataSource"},
+        DJICameraDisplayNameMavic2ProCamera : @{calibration : @"DJIMavic2ProCameraImageCalibrateFilterDataSource"},
+    };
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        _capabilities = @{};
+    }
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (nullable DUXBetaFPVCameraCapability *)capabilityForCameraName:(nullable NSString *)cameraName {
+    if (cameraName == nil) {
+        return nil;
+    }
+    return self.capabilities[cameraName];
+}
+
+- (H264EncoderType)encodeTypeForCameraName:(nullable NSString *)cameraName mode:(DUXBetaFPVCameraStreamMode)mode {
+    DUXBetaFPVCameraCapability *capability = [self capabilityForCameraName:cameraName];
+    if (capability == nil) {
+        return H264EncoderType_unknown;
+    }
+    return [capability encodeTypeForMode:mode];
+}
+
+- (void)registerCapability:(DUXBetaFPVCameraCapability *)capability forCameraName:(NSString *)cameraName {
+    [self registerCapabilities:@{cameraName : capability}];
+}
+
+- (void)registerCapabilitiesFromDictionary:(NSDictionary<NSString *, NSDictionary<NSString *, id> *> *)dictionary {
+    NSMutableDictionary<NSString *, DUXBetaFPVCameraCapability *> *capabilities = [[NSMutableDictionary alloc] initWithCapacity:dictionary.count];
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(NSString *cameraName, NSDictionary<NSString *, id> *entry, BOOL *stop) {
+        capabilities[cameraName] = [[DUXBetaFPVCameraCapability alloc] initWithDictionary:entry];
+    }];
+    [self registerCapabilities:capabilities];
+}
+
+- (void)registerCapabilities:(NSDictionary<NSString *, DUXBetaFPVCameraCapability *> *)capabilities {
+    pthread_mutex_lock(&_mutex);
+    NSMutableDictionary *merged = [self.capabilities mutableCopy];
+    [merged addEntriesFromDictionary:capabilities];
+    self.capabilities = merged;
+    pthread_mutex_unlock(&_mutex);
+}
+
+@end
@@ -26,6 +26,8 @@
 //
 
 #import <DJIWidget/DJIVideoPreviewer.h>
+#import <UXSDKCore/DUXBetaFPVIngestRingBuffer.h>
+#import <UXSDKCore/DUXBetaFPVDecodeHealthAggregator.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -40,6 +42,16 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, weak) DJIVideoFeed *videoFeed;
 @property (nonatomic) BOOL enableHardwareDecode;
 
+/**
+ *  Buffer between the video feed callback and the video previewer, exposed for its overflow policy and counters.
+*/
+@property (nonatomic, strong, readonly) DUXBetaFPVIngestRingBuffer *ingestBuffer;
+
+/**
+ *  Aggregates the decoder results, which are forwarded once per summary period and right away on health changes.
+*/
+@property (nonatomic, strong, readonly) DUXBetaFPVDecodeHealthAggregator *decodeHealth;
+
 - (void)startWithVideoFeed:(DJIVideoFeed *)videoFeed;
 - (void)stop;
 
@@ -33,6 +33,9 @@
 
 #define IS_FLOAT_EQUAL(a, b) (fabs(a - b) < 0.0005)
 
+static const size_t kDUXBetaFPVIngestBufferCapacity = 4 * 1024 * 1024;
+static const NSTimeInterval kDUXBetaFPVDecodeHealthPublishInterval = 1.0;
+
 @interface DUXBetaFPVDecodeAdapter ()
 
 @property (nonatomic, weak) DJIVideoPreviewer *videoPreviewer;
@@ -41,6 +44,10 @@
 
 @property (nonatomic) DJIDecodeImageCalibrateControlLogic *calibrateLogic;
 
+@property (nonatomic, strong, readwrite) DUXBetaFPVIngestRingBuffer *ingestBuffer;
+
+@property (nonatomic, strong, readwrite) DUXBetaFPVDecodeHealthAggregator *decodeHealth;
+
 @end
 
 @implementation DUXBetaFPVDecodeAdapter
@@ -50,6 +57,22 @@
     if (self) {
         _videoPreviewer = [DJIVideoPreviewer instance];
         _calibrateLogic = [[DJIDecodeImageCalibrateControlLogic alloc] init];
+        
+        // The previewer copies pushed data into its own queue, so chunks are pushed straight from the buffer.
+        __weak DJIVideoPreviewer *weakPreviewer = _videoPreviewer;
+        _ingestBuffer = [[DUXBetaFPVIngestRingBuffer alloc] initWithCapacity:kDUXBetaFPVIngestBufferCapacity consumer:^(const uint8_t *bytes, size_t length) {
+            [weakPreviewer push:(uint8_t *)bytes length:(int)length];
+        }];
+        
+        _decodeHealth = [[DUXBetaFPVDecodeHealthAggregator alloc] initWithPublishInterval:kDUXBetaFPVDecodeHealthPublishInterval handler:^(DUXBetaFPVDecodeHealthSummary *summary) {
+            //Forward the model change
+            [DUXBetaStateChangeBroadcaster send:[FPVModelState decoderHealthUpdated:summary]];
+            if (summary.health == DUXBetaFPVDecodeHealthHealthy && summary.framesDecoded > 0) {
+                [DUXBetaStateChangeBroadcaster send:[FPVModelState decodingDidSucceedWithTimestamp:summary.lastTimestamp]];
+            } else if (summary.health == DUXBetaFPVDecodeHealthUnhealthy && summary.healthChanged) {
+                [DUXBetaStateChangeBroadcaster send:[FPVModelState decodingDidFail]];
+            }
+        }];
     }
     return self;
 }
@@ -75,18 +98,23 @@
     [[DJISDKManager videoFeeder] addVideoFeedSourceListener:self];
     [self.videoFeed addListener:self withQueue:nil];
     self.videoPreviewer.frameControlHandler = self;
+    [self.decodeHealth start];
 }
 
 - (void)stop {
     [self modelCleanup];
     
+    // No chunk comes in once the feed listener is gone, and the buffered ones are dropped before the previewer closes.
+    [self.videoFeed removeListener:self];
+    [self.ingestBuffer discardBufferedBytes];
+    [self.decodeHealth stop];
+    
     [self.videoPreviewer unSetView];
     [self.videoPreviewer close];
     
     // Clean delegate
     [[DJISDKManager videoFeeder] removeVideoFeedSourceListener:self];
     self.videoPreviewer.frameControlHandler = nil;
-    [self.videoFeed removeListener:self];
 }
 
 - (void)setRenderingView:(UIView *)view {
@@ -106,6 +134,8 @@
     [self.videoFeed removeListener:self];
     
     _videoFeed = videoFeed;
+    // The new feed is only let through from its first keyframe on.
+    [self.ingestBuffer discardUntilKeyframe];
     
     [self.videoFeed addListener:self withQueue:nil];
     [self.videoPreviewer safeResume];
@@ -263,7 +293,7 @@
 #pragma mark - DJIVideoFeedListener Method
 
 - (void)videoFeed:(DJIVideoFeed *)videoFeed didUpdateVideoData:(NSData *)videoData {
-    [self.videoPreviewer push:(uint8_t *)[videoData bytes] length:(int)videoData.length];
+    [self.ingestBuffer writeBytes:(const uint8_t *)[videoData bytes] length:videoData.length];
 }
 
 #pragma mark - DJIVideoFeedSourceListener
@@ -302,16 +332,12 @@
 
 - (void)decodingDidSucceedWithTimestamp:(uint32_t)timestamp {
     [self.videoFeed decodingDidSucceedWithTimestamp:(NSUInteger)timestamp];
-    
-    //Forward the model change
-    [DUXBetaStateChangeBroadcaster send:[FPVModelState decodingDidSucceedWithTimestamp:timestamp]];
+    [self.decodeHealth recordDecodedFrameWithTimestamp:timestamp];
 }
 
 - (void)decodingDidFail {
     [self.videoFeed decodingDidFail];
-    
-    //Forward the model change
-    [DUXBetaStateChangeBroadcaster send:[FPVModelState decodingDidFail]];
+    [self.decodeHealth recordFailure];
 }
 
 @end
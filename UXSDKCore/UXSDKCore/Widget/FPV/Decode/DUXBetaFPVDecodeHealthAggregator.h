@@ -0,0 +1,102 @@
+//
+//  DUXBetaFPVDecodeHealthAggregator.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSUInteger, DUXBetaFPVDecodeHealth) {
+    DUXBetaFPVDecodeHealthUnknown,
+    DUXBetaFPVDecodeHealthHealthy,
+    DUXBetaFPVDecodeHealthUnhealthy
+};
+
+/**
+ * Decoder activity over one summary period.
+ */
+@interface DUXBetaFPVDecodeHealthSummary : NSObject
+
+@property (nonatomic, assign, readonly) DUXBetaFPVDecodeHealth health;
+
+/**
+ * YES when the summary was published right away because the health changed, before the period ended.
+ */
+@property (nonatomic, assign, readonly) BOOL healthChanged;
+
+@property (nonatomic, assign, readonly) NSUInteger framesDecoded;
+@property (nonatomic, assign, readonly) NSUInteger framesFailed;
+
+/**
+ * Inter-frame jitter, the change between consecutive frame intervals. Bucket 0 counts jitter under 1 ms,
+ * bucket i jitter in [2^(i-1), 2^i) ms, the last bucket everything above.
+ */
+@property (nonatomic, strong, readonly) NSArray<NSNumber *> *jitterHistogram;
+
+/**
+ * Timestamp of the last decoded frame, or 0 when no frame was decoded yet.
+ */
+@property (nonatomic, assign, readonly) uint32_t lastTimestamp;
+
+@end
+
+typedef void (^DUXBetaFPVDecodeHealthHandler)(DUXBetaFPVDecodeHealthSummary *summary);
+
+/**
+ * Aggregates per frame decoder results into periodic summaries. The decoder is unhealthy after failureThreshold
+ * failures in a row or when no frame was decoded for staleInterval, healthy again with the next decoded frame.
+ * Health changes are published right away, on the same private queue as the periodic summaries. Every method taking a time, in nanoseconds of CLOCK_UPTIME_RAW,
+ * can be driven with synthetic times.
+ */
+@interface DUXBetaFPVDecodeHealthAggregator : NSObject
+
+- (instancetype)initWithPublishInterval:(NSTimeInterval)publishInterval handler:(DUXBetaFPVDecodeHealthHandler)handler NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, assign, readonly) NSTimeInterval publishInterval;
+@property (nonatomic, assign) NSUInteger failureThreshold;
+@property (nonatomic, assign) NSTimeInterval staleInterval;
+
+/**
+ * Starts and stops publishing a summary every publish interval, the handler is called on a private queue. Both
+ * clear the counters, the health and the last frame time, so a new stream starts from an unknown health.
+ */
+- (void)start;
+- (void)stop;
+
+- (void)recordDecodedFrameWithTimestamp:(uint32_t)timestamp;
+- (void)recordDecodedFrameWithTimestamp:(uint32_t)timestamp atTime:(uint64_t)time;
+- (void)recordFailure;
+- (void)recordFailureAtTime:(uint64_t)time;
+
+/**
+ * Closes the current period and publishes its summary. Called by the timer, exposed to drive it by hand.
+ */
+- (DUXBetaFPVDecodeHealthSummary *)publishSummaryAtTime:(uint64_t)time;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,235 @@
+//
+//  DUXBetaFPVDecodeHealthAggregator.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaFPVDecodeHealthAggregator.h"
+#import <pthread/pthread.h>
+
+static const NSUInteger kDUXBetaFPVJitterBuckets = 8;
+
+@interface DUXBetaFPVDecodeHealthSummary ()
+
+@property (nonatomic, assign, readwrite) DUXBetaFPVDecodeHealth health;
+@property (nonatomic, assign, readwrite) BOOL healthChanged;
+@property (nonatomic, assign, readwrite) NSUInteger framesDecoded;
+@property (nonatomic, assign, readwrite) NSUInteger framesFailed;
+@property (nonatomic, strong, readwrite) NSArray<NSNumber *> *jitterHistogram;
+@property (nonatomic, assign, readwrite) uint32_t lastTimestamp;
+
+@end
+
+@implementation DUXBetaFPVDecodeHealthSummary
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"health %lu%@, decoded %lu, failed %lu, last timestamp %u, jitter %@", (unsigned long)self.health, self.healthChanged ? @" (changed)" : @"", (unsigned long)self.framesDecoded, (unsigned long)self.framesFailed, self.lastTimestamp, [self.jitterHistogram componentsJoinedByString:@"/"]];
+}
+
+@end
+
+@interface DUXBetaFPVDecodeHealthAggregator ()
+{
+    pthread_mutex_t _mutex;
+    DUXBetaFPVDecodeHealth _health;
+    NSUInteger _framesDecoded;
+    NSUInteger _framesFailed;
+    NSUInteger _consecutiveFailures;
+    NSUInteger _jitter[kDUXBetaFPVJitterBuckets];
+    uint32_t _lastTimestamp;
+    uint64_t _lastFrameTime;
+    uint64_t _lastFrameInterval;
+}
+
+@property (nonatomic, copy) DUXBetaFPVDecodeHealthHandler handler;
+@property (nonatomic, strong) dispatch_queue_t publishQueue;
+@property (nonatomic, strong) dispatch_source_t timer;
+
+@end
+
+@implementation DUXBetaFPVDecodeHealthAggregator
+
+- (instancetype)initWithPublishInterval:(NSTimeInterval)publishInterval handler:(DUXBetaFPVDecodeHealthHandler)handler {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        _publishInterval = publishInterval;
+        _handler = [handler copy];
+        _failureThreshold = 3;
+        _staleInterval = 1.0;
+        _publishQueue = dispatch_queue_create("com.dji.uxsdk.fpvDecodeHealth", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self stop];
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (void)start {
+    if (self.timer != nil || self.publishInterval <= 0) {
+        return;
+    }
+    [self reset];
+    uint64_t interval = (uint64_t)(self.publishInterval * NSEC_PER_SEC);
+    self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.publishQueue);
+    dispatch_source_set_timer(self.timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 10);
+    __weak typeof(self) weakSelf = self;
+    dispatch_source_set_event_handler(self.timer, ^{
+        [weakSelf publishSummaryAtTime:clock_gettime_nsec_np(CLOCK_UPTIME_RAW)];
+    });
+    dispatch_resume(self.timer);
+}
+
+- (void)stop {
+    if (self.timer != nil) {
+        dispatch_source_cancel(self.timer);
+        self.timer = nil;
+    }
+    [self reset];
+}
+
+// A stream started again is not compared against frames of the previous one.
+- (void)reset {
+    pthread_mutex_lock(&_mutex);
+    _health = DUXBetaFPVDecodeHealthUnknown;
+    _framesDecoded = 0;
+    _framesFailed = 0;
+    _consecutiveFailures = 0;
+    memset(_jitter, 0, sizeof(_jitter));
+    _lastTimestamp = 0;
+    _lastFrameTime = 0;
+    _lastFrameInterval = 0;
+    pthread_mutex_unlock(&_mutex);
+}
+
+#pragma mark - Recording
+
+- (void)recordDecodedFrameWithTimestamp:(uint32_t)timestamp {
+    [self recordDecodedFrameWithTimestamp:timestamp atTime:clock_gettime_nsec_np(CLOCK_UPTIME_RAW)];
+}
+
+- (void)recordDecodedFrameWithTimestamp:(uint32_t)timestamp atTime:(uint64_t)time {
+    DUXBetaFPVDecodeHealthSummary *summary = nil;
+    pthread_mutex_lock(&_mutex);
+    _framesDecoded++;
+    _consecutiveFailures = 0;
+    _lastTimestamp = timestamp;
+    if (_lastFrameTime != 0 && time > _lastFrameTime) {
+        uint64_t interval = time - _lastFrameTime;
+        if (_lastFrameInterval != 0) {
+            uint64_t jitter = interval > _lastFrameInterval ? interval - _lastFrameInterval : _lastFrameInterval - interval;
+            uint64_t milliseconds = jitter / NSEC_PER_MSEC;
+            NSUInteger bucket = 0;
+            while (milliseconds > 0 && bucket < kDUXBetaFPVJitterBuckets - 1) {
+                milliseconds >>= 1;
+                bucket++;
+            }
+            _jitter[bucket]++;
+        }
+        _lastFrameInterval = interval;
+    }
+    _lastFrameTime = time;
+    if (_health != DUXBetaFPVDecodeHealthHealthy) {
+        _health = DUXBetaFPVDecodeHealthHealthy;
+        summary = [self makeSummaryResetting:NO];
+        summary.healthChanged = YES;
+    }
+    pthread_mutex_unlock(&_mutex);
+    
+    if (summary) {
+        [self publishHealthChange:summary];
+    }
+}
+
+- (void)recordFailure {
+    [self recordFailureAtTime:clock_gettime_nsec_np(CLOCK_UPTIME_RAW)];
+}
+
+- (void)recordFailureAtTime:(uint64_t)time {
+    DUXBetaFPVDecodeHealthSummary *summary = nil;
+    pthread_mutex_lock(&_mutex);
+    _framesFailed++;
+    _consecutiveFailures++;
+    if (_consecutiveFailures >= MAX(self.failureThreshold, (NSUInteger)1) && _health != DUXBetaFPVDecodeHealthUnhealthy) {
+        _health = DUXBetaFPVDecodeHealthUnhealthy;
+        summary = [self makeSummaryResetting:NO];
+        summary.healthChanged = YES;
+    }
+    pthread_mutex_unlock(&_mutex);
+    
+    if (summary) {
+        [self publishHealthChange:summary];
+    }
+}
+
+#pragma mark - Publishing
+
+// Health changes are published on the queue of the periodic summaries, never on the decoder's thread.
+- (void)publishHealthChange:(DUXBetaFPVDecodeHealthSummary *)summary {
+    DUXBetaFPVDecodeHealthHandler handler = self.handler;
+    dispatch_async(self.publishQueue, ^{
+        handler(summary);
+    });
+}
+
+- (DUXBetaFPVDecodeHealthSummary *)publishSummaryAtTime:(uint64_t)time {
+    pthread_mutex_lock(&_mutex);
+    BOOL healthChanged = NO;
+    uint64_t staleInterval = (uint64_t)(self.staleInterval * NSEC_PER_SEC);
+    if (_health == DUXBetaFPVDecodeHealthHealthy && time > _lastFrameTime + staleInterval) {
+        _health = DUXBetaFPVDecodeHealthUnhealthy;
+        healthChanged = YES;
+    }
+    DUXBetaFPVDecodeHealthSummary *summary = [self makeSummaryResetting:YES];
+    summary.healthChanged = healthChanged;
+    pthread_mutex_unlock(&_mutex);
+    
+    self.handler(summary);
+    return summary;
+}
+
+// Called with the mutex held.
+- (DUXBetaFPVDecodeHealthSummary *)makeSummaryResetting:(BOOL)reset {
+    DUXBetaFPVDecodeHealthSummary *summary = [[DUXBetaFPVDecodeHealthSummary alloc] init];
+    summary.health = _health;
+    summary.framesDecoded = _framesDecoded;
+    summary.framesFailed = _framesFailed;
+    summary.lastTimestamp = _lastTimestamp;
+    NSMutableArray *histogram = [[NSMutableArray alloc] initWithCapacity:kDUXBetaFPVJitterBuckets];
+    for (NSUInteger i = 0; i < kDUXBetaFPVJitterBuckets; i++) {
+        [histogram addObject:@(_jitter[i])];
+    }
+    summary.jitterHistogram = histogram;
+    
+    if (reset) {
+        _framesDecoded = 0;
+        _framesFailed = 0;
+        memset(_jitter, 0, sizeof(_jitter));
+    }
+    return summary;
+}
+
+@end
@@ -26,6 +26,7 @@
 //
 
 #import "DUXBetaFPVDecodeModel.h"
+#import "DUXBetaFPVCameraCapabilityTable.h"
 #import <UXSDKCore/UXSDKCore-Swift.h>
 
 @interface DUXBetaFPVDecodeModel()
@@ -121,15 +122,8 @@
 
 - (CGRect)contentRectInPhotoMode {
     CGRect rect = self.defaultContentRect;
-    BOOL needFitToRate = NO;
+    BOOL needFitToRate = [[DUXBetaFPVCameraCapabilityTable defaultTable] capabilityForCameraName:self.cameraName].fitsPhotoAspectRatio;
     
-    if ([self.cameraName isEqualToString:DJICameraDisplayNameX3] ||
-        [self.cameraName isEqualToString:DJICameraDisplayNameX5] ||
-        [self.cameraName isEqualToString:DJICameraDisplayNameX5R] ||
-        [self.cameraName isEqualToString:DJICameraDisplayNamePhantom3ProfessionalCamera] ||
-        [self.cameraName isEqualToString:DJICameraDisplayNameMavicProCamera]) {
-        needFitToRate = YES;
-    }
     if (needFitToRate && self.photoRatio != DJICameraPhotoAspectRatioUnknown) {
         CGSize rateSize;
         
@@ -169,73 +163,15 @@
         return H264EncoderType_LightBridge2;
     }
     
-    if ([self.cameraName isEqualToString:DJICameraDisplayNameX3]) {
-        if (!isAircraft && [camera isDigitalZoomSupported]) {
-            return H264EncoderType_A9_OSMO_NO_368;
-        }
-        return H264EncoderType_DM368_inspire;
-    }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNameZ3]) {
-        return H264EncoderType_A9_OSMO_NO_368;
-    }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNameX5] ||
-        [self.cameraName isEqualToString:DJICameraDisplayNameX5R]) {
-        return H264EncoderType_DM368_inspire;
-    }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNamePhantom3ProfessionalCamera]) {
-        return H264EncoderType_DM365_phamtom3x;
-    }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNamePhantom3AdvancedCamera]) {
-        return H264EncoderType_A9_phantom3s;
+    DUXBetaFPVCameraStreamMode mode = DUXBetaFPVCameraStreamModeDefault;
+    if (!isAircraft && [camera isDigitalZoomSupported]) {
+        mode |= DUXBetaFPVCameraStreamModeHandheld;
     }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNamePhantom3StandardCamera]) {
-        return H264EncoderType_A9_phantom3c;
+    if (product.airLink.wifiLink) {
+        mode |= DUXBetaFPVCameraStreamModeWiFiLink;
     }
     
-    if ([self.cameraName isEqualToString:DJICameraDisplayNamePhantom4Camera]) {
-        return H264EncoderType_1860_phantom4x;
-    }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNameMavicProCamera]) {
-        DJIAircraft *product = (DJIAircraft *)[DJISDKManager product];
-        if (product.airLink.wifiLink) {
-            return H264EncoderType_1860_phantom4x;
-        }
-        return H264EncoderType_unknown;
-    }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNameSparkCamera]) {
-        return H264EncoderType_1860_phantom4x;
-    }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNameZ30]) {
-        return H264EncoderType_GD600;
-    }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNamePhantom4ProCamera] ||
-        [self.cameraName isEqualToString:DJICameraDisplayNamePhantom4AdvancedCamera] ||
-        [self.cameraName isEqualToString:DJICameraDisplayNameX5S] ||
-        [self.cameraName isEqualToString:DJICameraDisplayNameX4S] ||
-        [self.cameraName isEqualToString:DJICameraDisplayNameX7] ||
-        [self.cameraName isEqualToString:DJICameraDisplayNamePayload]) {
-        return H264EncoderType_H1_Inspire2;
-    }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNameMavicAirCamera]) {
-        return H264EncoderType_MavicAir;
-    }
-    
-    if ([self.cameraName isEqualToString:DJICameraDisplayNameMavicMiniCamera]) {
-        return H264EncoderType_MavicMini;
-    }
-
-    return H264EncoderType_unknown;
+    return [[DUXBetaFPVCameraCapabilityTable defaultTable] encodeTypeForCameraName:self.cameraName mode:mode];
 }
 
 @end
-
@@ -0,0 +1,90 @@
+//
+//  DUXBetaFPVIngestRingBuffer.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * What the ring buffer does with a chunk that does not fit.
+ */
+typedef NS_ENUM(NSUInteger, DUXBetaFPVIngestOverflowPolicy) {
+    /**
+     * Drop the chunk and everything after it until the next H.264 SPS or IDR slice, so the decoder
+     * resumes on a keyframe boundary.
+     */
+    DUXBetaFPVIngestOverflowPolicyDropToNextKeyframe,
+    /**
+     * Block the producer until the consumer made room, for up to 50 ms. A chunk still not fitting then is dropped
+     * and, as with the other policy, so is everything after it until the next keyframe.
+     */
+    DUXBetaFPVIngestOverflowPolicyBlock
+};
+
+typedef void (^DUXBetaFPVIngestConsumer)(const uint8_t *bytes, size_t length);
+
+/**
+ * Bounded, preallocated single producer single consumer buffer between the video feed callback and the decoder.
+ * Chunks are copied in once and handed to the consumer straight from the buffer memory on a private serial queue.
+ */
+@interface DUXBetaFPVIngestRingBuffer : NSObject
+
+- (instancetype)initWithCapacity:(size_t)capacity consumer:(DUXBetaFPVIngestConsumer)consumer NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, assign) DUXBetaFPVIngestOverflowPolicy overflowPolicy;
+
+/**
+ * Appends a chunk, only to be called from the producer thread. Returns NO when the chunk was dropped.
+ */
+- (BOOL)writeBytes:(const uint8_t *)bytes length:(size_t)length;
+
+/**
+ * Drops incoming chunks until the next keyframe, whatever the overflow policy. Used when the stream is switched,
+ * the chunks already buffered are still delivered. Callable from any thread.
+ */
+- (void)discardUntilKeyframe;
+
+/**
+ * Drops the chunks buffered but not yet handed to the consumer, and incoming chunks until the next keyframe. Returns
+ * once the consumer is no longer being called, so whatever it pushes to can be torn down. Not to be called from the
+ * consumer.
+ */
+- (void)discardBufferedBytes;
+
+/**
+ * Counters, readable from any thread.
+ */
+@property (nonatomic, assign, readonly) size_t capacity;
+@property (nonatomic, assign, readonly) uint64_t bytesIn;
+@property (nonatomic, assign, readonly) uint64_t bytesDropped;
+@property (nonatomic, assign, readonly) uint64_t highWaterMark;
+@property (nonatomic, assign, readonly) uint64_t usedBytes;
+
+@end
+
+NS_ASSUME_NONNULL_END
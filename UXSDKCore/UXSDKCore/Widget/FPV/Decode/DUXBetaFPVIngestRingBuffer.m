@@ -0,0 +1,257 @@
+//
+//  DUXBetaFPVIngestRingBuffer.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaFPVIngestRingBuffer.h"
+#import <stdatomic.h>
+
+static const uint32_t kDUXBetaFPVIngestWrapMarker = UINT32_MAX;
+static const size_t kDUXBetaFPVIngestHeaderSize = sizeof(uint32_t);
+static const int64_t kDUXBetaFPVIngestBlockTimeout = 50 * NSEC_PER_MSEC;
+
+/**
+ * Offset of the Annex-B start code in front of the first SPS or IDR slice NAL unit, or -1.
+ */
+static ssize_t DUXBetaFPVKeyframeOffset(const uint8_t *bytes, size_t length) {
+    for (size_t i = 0; i + 3 < length; i++) {
+        if (bytes[i] != 0 || bytes[i + 1] != 0 || bytes[i + 2] != 1) {
+            continue;
+        }
+        uint8_t nalType = bytes[i + 3] & 0x1F;
+        if (nalType == 7 || nalType == 5) {
+            return (i > 0 && bytes[i - 1] == 0) ? (ssize_t)i - 1 : (ssize_t)i;
+        }
+    }
+    return -1;
+}
+
+@interface DUXBetaFPVIngestRingBuffer ()
+{
+    uint8_t *_storage;
+    // Positions only ever grow, the offset in the storage is the position modulo the capacity.
+    _Atomic(uint64_t) _head;
+    _Atomic(uint64_t) _tail;
+    _Atomic(uint64_t) _bytesIn;
+    _Atomic(uint64_t) _bytesDropped;
+    _Atomic(uint64_t) _highWaterMark;
+    atomic_bool _discardRequested;
+    atomic_bool _discardBufferedRequested;
+    atomic_bool _drainScheduled;
+    atomic_bool _producerWaiting;
+    // Producer side only.
+    BOOL _droppingUntilKeyframe;
+}
+
+@property (nonatomic, copy) DUXBetaFPVIngestConsumer consumer;
+@property (nonatomic, strong) dispatch_queue_t drainQueue;
+@property (nonatomic, strong) dispatch_semaphore_t spaceSemaphore;
+
+@end
+
+@implementation DUXBetaFPVIngestRingBuffer
+
+- (instancetype)initWithCapacity:(size_t)capacity consumer:(DUXBetaFPVIngestConsumer)consumer {
+    self = [super init];
+    if (self) {
+        _capacity = MAX(capacity, (size_t)1024);
+        _storage = malloc(_capacity);
+        _consumer = [consumer copy];
+        _drainQueue = dispatch_queue_create("com.dji.uxsdk.fpvIngest", DISPATCH_QUEUE_SERIAL);
+        _spaceSemaphore = dispatch_semaphore_create(0);
+        _overflowPolicy = DUXBetaFPVIngestOverflowPolicyDropToNextKeyframe;
+        atomic_init(&_head, 0);
+        atomic_init(&_tail, 0);
+        atomic_init(&_bytesIn, 0);
+        atomic_init(&_bytesDropped, 0);
+        atomic_init(&_highWaterMark, 0);
+        atomic_init(&_discardRequested, false);
+        atomic_init(&_discardBufferedRequested, false);
+        atomic_init(&_drainScheduled, false);
+        atomic_init(&_producerWaiting, false);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_storage);
+}
+
+- (uint64_t)bytesIn {
+    return atomic_load(&_bytesIn);
+}
+
+- (uint64_t)bytesDropped {
+    return atomic_load(&_bytesDropped);
+}
+
+- (uint64_t)highWaterMark {
+    return atomic_load(&_highWaterMark);
+}
+
+- (uint64_t)usedBytes {
+    return atomic_load(&_head) - atomic_load(&_tail);
+}
+
+- (void)discardUntilKeyframe {
+    atomic_store(&_discardRequested, true);
+}
+
+- (void)discardBufferedBytes {
+    atomic_store(&_discardRequested, true);
+    atomic_store(&_discardBufferedRequested, true);
+    // Waits out a consumer call in progress, the drain stops handing out records once it sees the request.
+    dispatch_sync(self.drainQueue, ^{
+        uint64_t head = atomic_load_explicit(&self->_head, memory_order_acquire);
+        uint64_t tail = atomic_load_explicit(&self->_tail, memory_order_relaxed);
+        atomic_fetch_add(&self->_bytesDropped, head - tail);
+        atomic_store_explicit(&self->_tail, head, memory_order_release);
+        atomic_store(&self->_discardBufferedRequested, false);
+    });
+    if (atomic_exchange(&_producerWaiting, false)) {
+        dispatch_semaphore_signal(self.spaceSemaphore);
+    }
+}
+
+#pragma mark - Producer
+
+- (BOOL)writeBytes:(const uint8_t *)bytes length:(size_t)length {
+    atomic_fetch_add(&_bytesIn, length);
+    if (atomic_exchange(&_discardRequested, false)) {
+        _droppingUntilKeyframe = YES;
+    }
+    
+    if (_droppingUntilKeyframe) {
+        ssize_t keyframeOffset = DUXBetaFPVKeyframeOffset(bytes, length);
+        if (keyframeOffset < 0) {
+            atomic_fetch_add(&_bytesDropped, length);
+            return NO;
+        }
+        atomic_fetch_add(&_bytesDropped, (uint64_t)keyframeOffset);
+        bytes += keyframeOffset;
+        length -= (size_t)keyframeOffset;
+        _droppingUntilKeyframe = NO;
+    }
+    
+    if (![self reserveSpaceForLength:length]) {
+        // Whatever the policy, the chunks after a dropped one cannot be decoded until the next keyframe.
+        atomic_fetch_add(&_bytesDropped, length);
+        _droppingUntilKeyframe = YES;
+        return NO;
+    }
+    
+    uint64_t head = atomic_load_explicit(&_head, memory_order_relaxed);
+    size_t offset = (size_t)(head % _capacity);
+    size_t remainder = _capacity - offset;
+    if (remainder < kDUXBetaFPVIngestHeaderSize + length) {
+        // Not enough contiguous room before the end, the record starts over at the beginning of the storage.
+        if (remainder >= kDUXBetaFPVIngestHeaderSize) {
+            memcpy(_storage + offset, &kDUXBetaFPVIngestWrapMarker, kDUXBetaFPVIngestHeaderSize);
+        }
+        head += remainder;
+        offset = 0;
+    }
+    uint32_t recordLength = (uint32_t)length;
+    memcpy(_storage + offset, &recordLength, kDUXBetaFPVIngestHeaderSize);
+    memcpy(_storage + offset + kDUXBetaFPVIngestHeaderSize, bytes, length);
+    head += kDUXBetaFPVIngestHeaderSize + length;
+    atomic_store_explicit(&_head, head, memory_order_release);
+    
+    uint64_t used = head - atomic_load_explicit(&_tail, memory_order_acquire);
+    uint64_t highWaterMark = atomic_load_explicit(&_highWaterMark, memory_order_relaxed);
+    while (used > highWaterMark && !atomic_compare_exchange_weak(&_highWaterMark, &highWaterMark, used)) {}
+    
+    [self scheduleDrain];
+    return YES;
+}
+
+// Bytes a record of that length takes at the current head, including the skipped end of the storage if it wraps.
+- (uint64_t)requiredSpaceForLength:(size_t)length {
+    uint64_t head = atomic_load_explicit(&_head, memory_order_relaxed);
+    size_t remainder = _capacity - (size_t)(head % _capacity);
+    size_t record = kDUXBetaFPVIngestHeaderSize + length;
+    return remainder < record ? remainder + record : record;
+}
+
+- (BOOL)reserveSpaceForLength:(size_t)length {
+    if (kDUXBetaFPVIngestHeaderSize + length > _capacity || length >= kDUXBetaFPVIngestWrapMarker) {
+        return NO;
+    }
+    while (YES) {
+        uint64_t used = atomic_load_explicit(&_head, memory_order_relaxed) - atomic_load_explicit(&_tail, memory_order_acquire);
+        if (used + [self requiredSpaceForLength:length] <= _capacity) {
+            return YES;
+        }
+        if (self.overflowPolicy != DUXBetaFPVIngestOverflowPolicyBlock) {
+            return NO;
+        }
+        atomic_store(&_producerWaiting, true);
+        [self scheduleDrain];
+        if (dispatch_semaphore_wait(self.spaceSemaphore, dispatch_time(DISPATCH_TIME_NOW, kDUXBetaFPVIngestBlockTimeout)) != 0) {
+            atomic_store(&_producerWaiting, false);
+            return NO;
+        }
+    }
+}
+
+- (void)scheduleDrain {
+    if (!atomic_exchange(&_drainScheduled, true)) {
+        __weak typeof(self) weakSelf = self;
+        dispatch_async(self.drainQueue, ^{
+            [weakSelf drain];
+        });
+    }
+}
+
+#pragma mark - Consumer
+
+- (void)drain {
+    do {
+        uint64_t head = atomic_load_explicit(&_head, memory_order_acquire);
+        uint64_t tail = atomic_load_explicit(&_tail, memory_order_relaxed);
+        while (tail < head && !atomic_load(&_discardBufferedRequested)) {
+            size_t offset = (size_t)(tail % _capacity);
+            size_t remainder = _capacity - offset;
+            uint32_t recordLength = kDUXBetaFPVIngestWrapMarker;
+            if (remainder >= kDUXBetaFPVIngestHeaderSize) {
+                memcpy(&recordLength, _storage + offset, kDUXBetaFPVIngestHeaderSize);
+            }
+            if (recordLength == kDUXBetaFPVIngestWrapMarker) {
+                tail += remainder;
+            } else {
+                self.consumer(_storage + offset + kDUXBetaFPVIngestHeaderSize, recordLength);
+                tail += kDUXBetaFPVIngestHeaderSize + recordLength;
+            }
+            atomic_store_explicit(&_tail, tail, memory_order_release);
+            if (atomic_exchange(&_producerWaiting, false)) {
+                dispatch_semaphore_signal(self.spaceSemaphore);
+            }
+        }
+        atomic_store(&_drainScheduled, false);
+        // A chunk written after the head was read but before the flag was cleared would otherwise wait for the next one.
+    } while (atomic_load_explicit(&_head, memory_order_acquire) != atomic_load_explicit(&_tail, memory_order_relaxed) && !atomic_load(&_discardBufferedRequested) && !atomic_exchange(&_drainScheduled, true));
+}
+
+@end
@@ -0,0 +1,65 @@
+//
+//  DUXBetaBindingBenchmark.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString * const DUXBetaBindingBenchmarkSingleKeyUpdate;
+FOUNDATION_EXPORT NSString * const DUXBetaBindingBenchmarkBatteryBurst;
+FOUNDATION_EXPORT NSString * const DUXBetaBindingBenchmarkConcurrentWidgetModels;
+FOUNDATION_EXPORT NSString * const DUXBetaBindingBenchmarkBindUnbindChurn;
+FOUNDATION_EXPORT NSString * const DUXBetaBindingBenchmarkCameraIndexSwitch;
+
+/**
+ *  Measures the binding layer with a DUXBetaInMemoryKeyHandler installed in place of the SDK key manager, so it
+ *  runs without an aircraft. Each scenario installs its own handler and restores the previous one when done.
+ *  Scenario names are stable across releases so results can be compared. Run it on the main thread.
+ */
+@interface DUXBetaBindingBenchmark : NSObject
+
+- (instancetype)initWithIterations:(NSUInteger)iterations;
+
+@property (readonly, nonatomic) NSUInteger iterations;
+
++ (NSArray<NSString *> *)scenarioNames;
+
+/**
+ *  Runs one scenario and returns its result: name, iterations, totalNanoseconds and nanosecondsPerIteration.
+ */
+- (NSDictionary<NSString *, id> *)runScenario:(NSString *)name;
+
+- (NSArray<NSDictionary<NSString *, id> *> *)runAllScenarios;
+
+/**
+ *  Runs every scenario and returns the results as JSON.
+ */
+- (nullable NSData *)runAllScenariosJSON;
+
+@end
+
+NS_ASSUME_NONNULL_END
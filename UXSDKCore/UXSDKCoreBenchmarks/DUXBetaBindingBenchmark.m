@@ -0,0 +1,258 @@
+//
+//  DUXBetaBindingBenchmark.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaBindingBenchmark.h"
+#import "DUXBetaInMemoryKeyHandler.h"
+#import <UXSDKCore/DUXBetaRKVOHeaders.h>
+#import <UXSDKCore/DUXBetaBatteryWidgetModel.h>
+
+#import <UXSDKCore/UXSDKCore-Swift.h>
+
+NSString * const DUXBetaBindingBenchmarkSingleKeyUpdate = @"binding.singleKeyUpdate";
+NSString * const DUXBetaBindingBenchmarkBatteryBurst = @"binding.batteryBurst";
+NSString * const DUXBetaBindingBenchmarkConcurrentWidgetModels = @"binding.concurrentWidgetModels";
+NSString * const DUXBetaBindingBenchmarkBindUnbindChurn = @"binding.bindUnbindChurn";
+NSString * const DUXBetaBindingBenchmarkCameraIndexSwitch = @"binding.cameraIndexSwitch";
+
+static const NSUInteger kDUXBetaBindingBenchmarkVersion = 1;
+static const NSUInteger kDUXBetaBindingBenchmarkConcurrentModelCount = 50;
+
+/**
+ *  One SDK bound property with an RKVO selector, the smallest complete binding.
+ */
+@interface DUXBetaBindingBenchmarkModel : NSObject
+
+@property (assign, nonatomic) NSInteger value;
+@property (assign, nonatomic) NSUInteger updateCount;
+
+- (void)bindKey:(DJIKey *)key;
+- (void)unbind;
+
+@end
+
+@implementation DUXBetaBindingBenchmarkModel
+
+- (void)bindKey:(DJIKey *)key {
+    BindSDKKey(key, value);
+    BindRKVOModel(self, @selector(valueChanged), value);
+}
+
+- (void)valueChanged {
+    self.updateCount++;
+}
+
+- (void)unbind {
+    UnBindSDK;
+    UnBindRKVOModel(self);
+}
+
+@end
+
+@implementation DUXBetaBindingBenchmark
+
+- (instancetype)init {
+    return [self initWithIterations:1000];
+}
+
+- (instancetype)initWithIterations:(NSUInteger)iterations {
+    if (self = [super init]) {
+        _iterations = MAX(iterations, 1);
+    }
+    return self;
+}
+
++ (NSArray<NSString *> *)scenarioNames {
+    return @[DUXBetaBindingBenchmarkSingleKeyUpdate,
+             DUXBetaBindingBenchmarkBatteryBurst,
+             DUXBetaBindingBenchmarkConcurrentWidgetModels,
+             DUXBetaBindingBenchmarkBindUnbindChurn,
+             DUXBetaBindingBenchmarkCameraIndexSwitch];
+}
+
++ (NSArray<DJIKey *> *)batteryKeys {
+    return @[[DJIBatteryKey keyWithIndex:0 andParam:DJIBatteryParamChargeRemainingInPercent],
+             [DJIBatteryKey keyWithIndex:1 andParam:DJIBatteryParamChargeRemainingInPercent],
+             [DJIFlightControllerKey keyWithParam:DJIFlightControllerParamBatteryPercentageNeededToGoHome],
+             [DJIFlightControllerKey keyWithIndex:0 andParam:DJIFlightControllerParamBatteryThresholdBehavior],
+             [DJIBatteryKey keyWithIndex:0 andParam:DJIBatteryParamCellVoltages],
+             [DJIBatteryKey keyWithIndex:1 andParam:DJIBatteryParamCellVoltages],
+             [DJIBatteryKey keyWithIndex:0 andParam:DJIBatteryParamLatestWarningRecord],
+             [DJIBatteryKey keyWithIndex:1 andParam:DJIBatteryParamLatestWarningRecord],
+             [DJIBatteryKey keyWithAggregationParam:DJIBatteryParamAggregationState]];
+}
+
+// Warning records and the aggregation state can't be created outside the SDK, they are pushed as nil.
++ (nullable id)batteryValueForKeyAtIndex:(NSUInteger)keyIndex iteration:(NSUInteger)iteration {
+    switch (keyIndex) {
+        case 0:
+        case 1:
+        case 2:
+            return @(iteration % 100);
+        case 3:
+            return @(iteration % 3);
+        case 4:
+        case 5:
+            return @[@(3800 + iteration % 400), @(3810 + iteration % 400), @(3790 + iteration % 400)];
+        default:
+            return nil;
+    }
+}
+
+- (NSDictionary<NSString *, id> *)runScenario:(NSString *)name {
+    DUXBetaKeyInterfaceAdapter *adapter = [DUXBetaKeyInterfaceAdapter sharedInstance];
+    id<DUXBetaKeyInterfaces> previousHandler = [adapter getHandler];
+    DUXBetaInMemoryKeyHandler *handler = [[DUXBetaInMemoryKeyHandler alloc] init];
+    [handler updateValue:@(YES) forKey:[DJIFlightControllerKey keyWithParam:DJIParamConnection]];
+    [adapter setHandler:handler];
+    
+    uint64_t elapsed = 0;
+    if ([name isEqualToString:DUXBetaBindingBenchmarkSingleKeyUpdate]) {
+        elapsed = [self runSingleKeyUpdateWithHandler:handler];
+    } else if ([name isEqualToString:DUXBetaBindingBenchmarkBatteryBurst]) {
+        elapsed = [self runBatteryBurstWithHandler:handler];
+    } else if ([name isEqualToString:DUXBetaBindingBenchmarkConcurrentWidgetModels]) {
+        elapsed = [self runConcurrentWidgetModelsWithHandler:handler];
+    } else if ([name isEqualToString:DUXBetaBindingBenchmarkBindUnbindChurn]) {
+        elapsed = [self runBindUnbindChurnWithHandler:handler];
+    } else if ([name isEqualToString:DUXBetaBindingBenchmarkCameraIndexSwitch]) {
+        elapsed = [self runCameraIndexSwitchWithHandler:handler];
+    } else {
+        NSAssert(NO, @"Unknown benchmark scenario %@", name);
+    }
+    
+    [adapter setHandler:previousHandler];
+    return @{
+        @"name" : name,
+        @"version" : @(kDUXBetaBindingBenchmarkVersion),
+        @"iterations" : @(self.iterations),
+        @"totalNanoseconds" : @(elapsed),
+        @"nanosecondsPerIteration" : @((double)elapsed / self.iterations)
+    };
+}
+
+- (NSArray<NSDictionary<NSString *, id> *> *)runAllScenarios {
+    NSMutableArray *results = [[NSMutableArray alloc] init];
+    for (NSString *name in [DUXBetaBindingBenchmark scenarioNames]) {
+        [results addObject:[self runScenario:name]];
+    }
+    return results;
+}
+
+- (nullable NSData *)runAllScenariosJSON {
+    return [NSJSONSerialization dataWithJSONObject:[self runAllScenarios] options:NSJSONWritingPrettyPrinted error:nil];
+}
+
+#pragma mark - Scenarios
+
+- (uint64_t)runSingleKeyUpdateWithHandler:(DUXBetaInMemoryKeyHandler *)handler {
+    DJIKey *key = [DJIBatteryKey keyWithIndex:0 andParam:DJIBatteryParamChargeRemainingInPercent];
+    DUXBetaBindingBenchmarkModel *model = [[DUXBetaBindingBenchmarkModel alloc] init];
+    [model bindKey:key];
+    
+    uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    for (NSUInteger i = 0; i < self.iterations; i++) {
+        [handler updateValue:@(i + 1) forKey:key];
+    }
+    uint64_t elapsed = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+    
+    [model unbind];
+    return elapsed;
+}
+
+- (uint64_t)runBatteryBurstWithHandler:(DUXBetaInMemoryKeyHandler *)handler {
+    NSArray<DJIKey *> *keys = [DUXBetaBindingBenchmark batteryKeys];
+    DUXBetaBatteryWidgetModel *model = [[DUXBetaBatteryWidgetModel alloc] init];
+    [model setup];
+    
+    uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    for (NSUInteger i = 0; i < self.iterations; i++) {
+        [keys enumerateObjectsUsingBlock:^(DJIKey *key, NSUInteger keyIndex, BOOL *stop) {
+            [handler updateValue:[DUXBetaBindingBenchmark batteryValueForKeyAtIndex:keyIndex iteration:i] forKey:key];
+        }];
+        [model duxbeta_flushCoalescedRKVO];
+    }
+    uint64_t elapsed = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+    
+    [model cleanup];
+    return elapsed;
+}
+
+- (uint64_t)runConcurrentWidgetModelsWithHandler:(DUXBetaInMemoryKeyHandler *)handler {
+    NSArray<DJIKey *> *keys = [DUXBetaBindingBenchmark batteryKeys];
+    NSMutableArray<DUXBetaBatteryWidgetModel *> *models = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < kDUXBetaBindingBenchmarkConcurrentModelCount; i++) {
+        DUXBetaBatteryWidgetModel *model = [[DUXBetaBatteryWidgetModel alloc] init];
+        [model setup];
+        [models addObject:model];
+    }
+    
+    // Every key is pushed from its own thread, each push fans out to all models.
+    uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    dispatch_apply(keys.count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t keyIndex) {
+        for (NSUInteger i = 0; i < self.iterations; i++) {
+            [handler updateValue:[DUXBetaBindingBenchmark batteryValueForKeyAtIndex:keyIndex iteration:i] forKey:keys[keyIndex]];
+        }
+    });
+    for (DUXBetaBatteryWidgetModel *model in models) {
+        [model duxbeta_flushCoalescedRKVO];
+    }
+    uint64_t elapsed = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+    
+    for (DUXBetaBatteryWidgetModel *model in models) {
+        [model cleanup];
+    }
+    return elapsed;
+}
+
+- (uint64_t)runBindUnbindChurnWithHandler:(DUXBetaInMemoryKeyHandler *)handler {
+    uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    for (NSUInteger i = 0; i < self.iterations; i++) {
+        DUXBetaBatteryWidgetModel *model = [[DUXBetaBatteryWidgetModel alloc] init];
+        [model setup];
+        [model cleanup];
+    }
+    return clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+}
+
+- (uint64_t)runCameraIndexSwitchWithHandler:(DUXBetaInMemoryKeyHandler *)handler {
+    for (NSInteger index = 0; index < 2; index++) {
+        [handler updateValue:@"Zenmuse XT2" forKey:[DJICameraKey keyWithIndex:index andParam:DJICameraParamDisplayName]];
+    }
+    DUXBetaFPVWidgetModel *model = [[DUXBetaFPVWidgetModel alloc] init];
+    [model setup];
+    
+    uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    for (NSUInteger i = 0; i < self.iterations; i++) {
+        model.preferredCameraIndex = (i + 1) % 2;
+    }
+    uint64_t elapsed = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+    
+    [model cleanup];
+    return elapsed;
+}
+
+@end
@@ -0,0 +1,61 @@
+//
+//  DUXBetaInMemoryKeyHandler.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+#import <DJISDK/DJISDK.h>
+#import <UXSDKCore/DUXBetaKeyManager.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  A DUXBetaKeyInterfaces handler keeping key values in memory, for running bindings without an aircraft.
+ *  Install it with -[DUXBetaKeyInterfaceAdapter setHandler:]. Listeners are called synchronously on the thread
+ *  pushing the value.
+ */
+@interface DUXBetaInMemoryKeyHandler : NSObject <DUXBetaKeyInterfaces>
+
+/**
+ *  Stores the value and pushes it to every listener of the key. Passing nil removes the stored value.
+ */
+- (void)updateValue:(nullable id)value forKey:(DJIKey *)key;
+
+- (void)removeAllValues;
+
+/**
+ *  How long getValueForKey: takes, 0 by default. The value is taken when the read starts and returned once the
+ *  latency has passed, like a read still in flight while a newer value is pushed.
+ */
+@property (assign, atomic) NSTimeInterval readLatency;
+
+/**
+ *  Number of listener registrations over all keys.
+ */
+@property (readonly, nonatomic) NSUInteger listenerCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
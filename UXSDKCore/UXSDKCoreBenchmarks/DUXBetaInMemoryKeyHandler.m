@@ -0,0 +1,205 @@
+//
+//  DUXBetaInMemoryKeyHandler.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaInMemoryKeyHandler.h"
+#import <pthread/pthread.h>
+#import <unistd.h>
+
+/**
+ *  DJIKeyedValue has no public initializer, the stored value is returned by overriding the accessor.
+ */
+@interface DUXBetaInMemoryKeyedValue : DJIKeyedValue
+
+@property (strong, nonatomic) id storedValue;
+
+@end
+
+@implementation DUXBetaInMemoryKeyedValue
+
+- (id)value {
+    return self.storedValue;
+}
+
+@end
+
+@interface DUXBetaInMemoryKeyListener : NSObject
+
+@property (weak, nonatomic) id listener;
+@property (copy, nonatomic) DJIKeyedListenerUpdateBlock updateBlock;
+
+@end
+
+@implementation DUXBetaInMemoryKeyListener
+@end
+
+@interface DUXBetaInMemoryKeyHandler ()
+{
+    pthread_mutex_t _mutex;
+}
+
+@property (strong, nonatomic) NSMutableDictionary<NSString *, DJIKeyedValue *> *values;
+
+/**
+ *  Listeners by key. The arrays are immutable and replaced on every change, so a push can iterate its snapshot
+ *  outside the lock.
+ */
+@property (strong, nonatomic) NSMutableDictionary<NSString *, NSArray<DUXBetaInMemoryKeyListener *> *> *listeners;
+
+@end
+
+static NSString *DUXBetaInMemoryKeyIdentifier(DJIKey *key) {
+    return [NSString stringWithFormat:@"%@|%lu|%@|%lu|%@", NSStringFromClass([key class]), (unsigned long)key.index, key.subComponent ?: @"", (unsigned long)key.subComponentIndex, key.param];
+}
+
+@implementation DUXBetaInMemoryKeyHandler
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_mutex);
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        pthread_mutex_init(&_mutex, NULL);
+        _values = [[NSMutableDictionary alloc] init];
+        _listeners = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (void)updateValue:(nullable id)value forKey:(DJIKey *)key {
+    NSString *identifier = DUXBetaInMemoryKeyIdentifier(key);
+    DUXBetaInMemoryKeyedValue *keyedValue = nil;
+    if (value != nil) {
+        keyedValue = [[DUXBetaInMemoryKeyedValue alloc] init];
+        keyedValue.storedValue = value;
+    }
+    
+    pthread_mutex_lock(&_mutex);
+    DJIKeyedValue *oldValue = self.values[identifier];
+    self.values[identifier] = keyedValue;
+    NSArray<DUXBetaInMemoryKeyListener *> *listeners = self.listeners[identifier];
+    pthread_mutex_unlock(&_mutex);
+    
+    for (DUXBetaInMemoryKeyListener *listener in listeners) {
+        if (listener.listener == nil) continue;
+        listener.updateBlock(oldValue, keyedValue);
+    }
+}
+
+- (void)removeAllValues {
+    pthread_mutex_lock(&_mutex);
+    [self.values removeAllObjects];
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (NSUInteger)listenerCount {
+    NSUInteger count = 0;
+    pthread_mutex_lock(&_mutex);
+    for (NSArray *listeners in self.listeners.allValues) {
+        count += listeners.count;
+    }
+    pthread_mutex_unlock(&_mutex);
+    return count;
+}
+
+#pragma mark - DUXBetaKeyInterfaces
+
+- (nullable DJIKeyedValue *)getValueForKey:(DJIKey *)key {
+    NSString *identifier = DUXBetaInMemoryKeyIdentifier(key);
+    pthread_mutex_lock(&_mutex);
+    DJIKeyedValue *value = self.values[identifier];
+    pthread_mutex_unlock(&_mutex);
+    NSTimeInterval latency = self.readLatency;
+    if (latency > 0) {
+        usleep((useconds_t)(latency * USEC_PER_SEC));
+    }
+    return value;
+}
+
+- (void)getValueForKey:(DJIKey *)key
+        withCompletion:(DJIKeyedGetCompletionBlock)completion {
+    completion([self getValueForKey:key], nil);
+}
+
+- (void)setValue:(id)value
+          forKey:(DJIKey *)key
+  withCompletion:(DJIKeyedSetCompletionBlock)completion {
+    [self updateValue:value forKey:key];
+    if (completion) {
+        completion(nil);
+    }
+}
+
+- (void)performActionForKey:(DJIKey *)key
+              withArguments:(nullable NSArray *)arguments
+              andCompletion:(DJIKeyedActionCompletionBlock)completion {
+    if (completion) {
+        completion(YES, nil, nil);
+    }
+}
+
+- (void)startListeningForChangesOnKey:(DJIKey *)key
+                         withListener:(id)listener
+                       andUpdateBlock:(DJIKeyedListenerUpdateBlock)updateBlock {
+    DUXBetaInMemoryKeyListener *entry = [[DUXBetaInMemoryKeyListener alloc] init];
+    entry.listener = listener;
+    entry.updateBlock = updateBlock;
+    
+    NSString *identifier = DUXBetaInMemoryKeyIdentifier(key);
+    pthread_mutex_lock(&_mutex);
+    NSArray *listeners = self.listeners[identifier] ?: @[];
+    self.listeners[identifier] = [listeners arrayByAddingObject:entry];
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)stopListeningOnKey:(DJIKey *)key
+                ofListener:(id)listener {
+    NSString *identifier = DUXBetaInMemoryKeyIdentifier(key);
+    pthread_mutex_lock(&_mutex);
+    NSArray *listeners = [self.listeners[identifier] filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(DUXBetaInMemoryKeyListener *entry, NSDictionary *bindings) {
+        return entry.listener != nil && entry.listener != listener;
+    }]];
+    self.listeners[identifier] = listeners.count > 0 ? listeners : nil;
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)stopAllListeningOfListeners:(id)listener {
+    pthread_mutex_lock(&_mutex);
+    for (NSString *identifier in self.listeners.allKeys) {
+        NSArray *listeners = [self.listeners[identifier] filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(DUXBetaInMemoryKeyListener *entry, NSDictionary *bindings) {
+            return entry.listener != nil && entry.listener != listener;
+        }]];
+        self.listeners[identifier] = listeners.count > 0 ? listeners : nil;
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (BOOL)isKeySupported:(DJIKey *)key {
+    return YES;
+}
+
+@end
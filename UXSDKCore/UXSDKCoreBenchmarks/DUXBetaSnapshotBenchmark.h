@@ -0,0 +1,56 @@
+//
+//  DUXBetaSnapshotBenchmark.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Measures snapshot distribution with a synthetic 60 fps frame source in place of the video previewer, so it runs
+ *  without an aircraft. The frame source only runs while the distributor is active, like the previewer frame processor.
+ *  Every run blocks the calling thread for its duration, so do not run it on the main thread.
+ */
+@interface DUXBetaSnapshotBenchmark : NSObject
+
+- (instancetype)initWithDuration:(NSTimeInterval)duration;
+
+@property (readonly, nonatomic) NSTimeInterval duration;
+
+/**
+ *  Runs with the given number of persistent receivers, each limited to framesPerSecond, and returns: consumers,
+ *  seconds, frameWakeupsPerSecond, wakeupsPerSecond, imageCopiesPerSecond and deliveriesPerSecond.
+ */
+- (NSDictionary<NSString *, id> *)runWithConsumers:(NSUInteger)consumers maximumRate:(double)framesPerSecond;
+
+/**
+ *  Runs with 0, 1 and 5 receivers at 30 fps and returns the results as JSON.
+ */
+- (nullable NSData *)runDefaultScenariosJSON;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,155 @@
+//
+//  DUXBetaSnapshotBenchmark.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaSnapshotBenchmark.h"
+#import <UXSDKCore/DUXBetaSnapshotDistributor.h>
+#import <stdatomic.h>
+
+static const double kDUXBetaSnapshotBenchmarkFrameRate = 60.0;
+
+@interface DUXBetaSnapshotBenchmark ()
+{
+    atomic_ullong _frameWakeups;
+    atomic_ullong _imageCopies;
+}
+
+@property (nonatomic, strong) dispatch_queue_t frameQueue;
+@property (nonatomic, strong) dispatch_source_t frameTimer;
+
+@end
+
+@implementation DUXBetaSnapshotBenchmark
+
+- (instancetype)init {
+    return [self initWithDuration:2.0];
+}
+
+- (instancetype)initWithDuration:(NSTimeInterval)duration {
+    self = [super init];
+    if (self) {
+        _duration = duration;
+        _frameQueue = dispatch_queue_create("com.dji.uxsdk.snapshotBenchmark.frames", DISPATCH_QUEUE_SERIAL);
+        // Oneshot receivers deactivate the distributor from the frame queue.
+        dispatch_queue_set_specific(_frameQueue, (__bridge void *)self, (__bridge void *)self, NULL);
+    }
+    return self;
+}
+
+- (NSDictionary<NSString *, id> *)runWithConsumers:(NSUInteger)consumers maximumRate:(double)framesPerSecond {
+    atomic_store(&_frameWakeups, 0);
+    atomic_store(&_imageCopies, 0);
+    
+    // Stands in for the previewer render, every call is one image the old path copied.
+    UIGraphicsBeginImageContext(CGSizeMake(1, 1));
+    UIImage *frameImage = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    __weak typeof(self) weakSelf = self;
+    DUXBetaSnapshotDistributor *distributor = [[DUXBetaSnapshotDistributor alloc] initWithSnapshotProvider:^(void (^completion)(UIImage *)) {
+        typeof(self) strongSelf = weakSelf;
+        if (strongSelf) {
+            atomic_fetch_add(&strongSelf->_imageCopies, 1);
+        }
+        completion(frameImage);
+    }];
+    distributor.deliveryQueue = dispatch_queue_create("com.dji.uxsdk.snapshotBenchmark.delivery", DISPATCH_QUEUE_SERIAL);
+    __weak DUXBetaSnapshotDistributor *weakDistributor = distributor;
+    distributor.activityHandler = ^(BOOL active) {
+        if (active) {
+            [weakSelf startFramesForDistributor:weakDistributor];
+        } else {
+            [weakSelf stopFrames];
+        }
+    };
+    
+    NSMutableArray<DUXBetaSnapshotReceiver> *receivers = [[NSMutableArray alloc] init];
+    for (NSUInteger index = 0; index < consumers; index++) {
+        DUXBetaSnapshotReceiver receiver = ^(UIImage *snapshot) {};
+        [receivers addObject:receiver];
+        [distributor addReceiver:receiver maximumRate:framesPerSecond];
+    }
+    
+    uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    [NSThread sleepForTimeInterval:self.duration];
+    for (DUXBetaSnapshotReceiver receiver in receivers) {
+        [distributor removeReceiver:receiver];
+    }
+    [self stopFrames];
+    double seconds = (double)(clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start) / NSEC_PER_SEC;
+    
+    return @{
+        @"consumers" : @(consumers),
+        @"seconds" : @(seconds),
+        @"frameWakeupsPerSecond" : @(atomic_load(&_frameWakeups) / seconds),
+        @"wakeupsPerSecond" : @(distributor.wakeupCount / seconds),
+        @"imageCopiesPerSecond" : @(atomic_load(&_imageCopies) / seconds),
+        @"deliveriesPerSecond" : @(distributor.deliveryCount / seconds)
+    };
+}
+
+- (nullable NSData *)runDefaultScenariosJSON {
+    NSMutableArray *results = [[NSMutableArray alloc] init];
+    for (NSNumber *consumers in @[@0, @1, @5]) {
+        [results addObject:[self runWithConsumers:consumers.unsignedIntegerValue maximumRate:30.0]];
+    }
+    return [NSJSONSerialization dataWithJSONObject:results options:NSJSONWritingPrettyPrinted error:nil];
+}
+
+#pragma mark - Frame Source
+
+- (void)startFramesForDistributor:(DUXBetaSnapshotDistributor *)distributor {
+    dispatch_sync(self.frameQueue, ^{
+        if (self.frameTimer != nil) {
+            return;
+        }
+        uint64_t interval = (uint64_t)(NSEC_PER_SEC / kDUXBetaSnapshotBenchmarkFrameRate);
+        self.frameTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.frameQueue);
+        dispatch_source_set_timer(self.frameTimer, DISPATCH_TIME_NOW, interval, 0);
+        __weak DUXBetaSnapshotDistributor *weakDistributor = distributor;
+        dispatch_source_set_event_handler(self.frameTimer, ^{
+            atomic_fetch_add(&self->_frameWakeups, 1);
+            [weakDistributor frameDidArrive];
+        });
+        dispatch_resume(self.frameTimer);
+    });
+}
+
+- (void)stopFrames {
+    void (^stop)(void) = ^{
+        if (self.frameTimer != nil) {
+            dispatch_source_cancel(self.frameTimer);
+            self.frameTimer = nil;
+        }
+    };
+    if (dispatch_get_specific((__bridge void *)self) != NULL) {
+        stop();
+    } else {
+        dispatch_sync(self.frameQueue, stop);
+    }
+}
+
+@end
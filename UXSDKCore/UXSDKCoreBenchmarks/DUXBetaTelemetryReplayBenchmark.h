@@ -0,0 +1,57 @@
+//
+//  DUXBetaTelemetryReplayBenchmark.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Times recording and replaying telemetry logs. Ordering and round trip correctness are covered by the sample
+ * app tests.
+ */
+@interface DUXBetaTelemetryReplayBenchmark : NSObject
+
+/**
+ * Replays the log at the speed through DUXBetaTelemetryReplayKeyHandler with a listener on every key, on a
+ * background callback queue. The completion gets: events, eventsPerSecond, maximumBacklog and lateEvents.
+ */
++ (void)runReplayOfLog:(NSData *)log speed:(double)speed completion:(void (^)(NSDictionary<NSString *, NSNumber *> *results))completion;
+
+/**
+ * Replays a synthetic log of 1,000,000 events at unlimited speed.
+ */
++ (void)runOneMillionEventsWithCompletion:(void (^)(NSDictionary<NSString *, NSNumber *> *results))completion;
+
+/**
+ * Pushes the log's events through DUXBetaTelemetryRecordingKeyHandler with the given number of listeners on every
+ * key. Returns: events, recordedEvents and nanosecondsPerEvent.
+ */
++ (NSDictionary<NSString *, NSNumber *> *)runRecordingOfLog:(NSData *)log listenersPerKey:(NSUInteger)listenersPerKey;
+
+@end
+
+NS_ASSUME_NONNULL_END
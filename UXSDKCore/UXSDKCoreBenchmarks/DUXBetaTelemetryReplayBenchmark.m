@@ -0,0 +1,121 @@
+//
+//  DUXBetaTelemetryReplayBenchmark.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaTelemetryReplayBenchmark.h"
+#import <UXSDKCore/DUXBetaTelemetryLog.h>
+#import <UXSDKCore/DUXBetaTelemetryRecordingKeyHandler.h>
+#import <UXSDKCoreBenchmarks/DUXBetaTelemetryReplayKeyHandler.h>
+
+static NSString *DUXBetaTelemetryBenchmarkKeyIdentifier(DJIKey *key) {
+    return [NSString stringWithFormat:@"%@|%lu|%@|%lu|%@", NSStringFromClass([key class]), (unsigned long)key.index, key.subComponent ?: @"", (unsigned long)key.subComponentIndex, key.param];
+}
+
+@implementation DUXBetaTelemetryReplayBenchmark
+
++ (void)runOneMillionEventsWithCompletion:(void (^)(NSDictionary<NSString *, NSNumber *> *results))completion {
+    NSData *log = [DUXBetaTelemetryLogWriter syntheticLogWithEventCount:1000000 interval:0.001];
+    [self runReplayOfLog:log speed:DUXBetaTelemetryReplaySpeedUnlimited completion:completion];
+}
+
+/**
+ * Reads the whole log. keys gets every key once, in order of first appearance, and events every key and value
+ * pair, nil values are stored as NSNull.
+ */
++ (void)readLog:(NSData *)log keys:(NSMutableArray<DJIKey *> *)keys events:(nullable NSMutableArray<NSArray *> *)events {
+    DUXBetaTelemetryLogReader *reader = [[DUXBetaTelemetryLogReader alloc] initWithData:log error:nil];
+    NSMutableSet<NSString *> *identifiers = [[NSMutableSet alloc] init];
+    uint64_t timestamp = 0;
+    DJIKey *key = nil;
+    id value = nil;
+    while ([reader readEventWithTimestamp:&timestamp key:&key value:&value error:nil]) {
+        NSString *identifier = DUXBetaTelemetryBenchmarkKeyIdentifier(key);
+        if (![identifiers containsObject:identifier]) {
+            [identifiers addObject:identifier];
+            [keys addObject:key];
+        }
+        [events addObject:@[key, value ?: [NSNull null]]];
+    }
+}
+
++ (void)runReplayOfLog:(NSData *)log speed:(double)speed completion:(void (^)(NSDictionary<NSString *, NSNumber *> *results))completion {
+    NSMutableArray<DJIKey *> *keys = [[NSMutableArray alloc] init];
+    [self readLog:log keys:keys events:nil];
+    
+    DUXBetaTelemetryReplayKeyHandler *handler = [[DUXBetaTelemetryReplayKeyHandler alloc] initWithLog:log error:nil];
+    handler.callbackQueue = dispatch_queue_create("com.dji.uxsdk.telemetryReplayBenchmark", DISPATCH_QUEUE_SERIAL);
+    
+    NSObject *listener = [[NSObject alloc] init];
+    for (DJIKey *key in keys) {
+        [handler startListeningForChangesOnKey:key withListener:listener andUpdateBlock:^(DJIKeyedValue * _Nullable oldValue, DJIKeyedValue * _Nullable newValue) {}];
+    }
+    
+    [handler replayAtSpeed:speed completion:^(DUXBetaTelemetryReplayReport *report) {
+        [handler stopAllListeningOfListeners:listener];
+        completion(@{
+            @"events" : @(report.eventCount),
+            @"eventsPerSecond" : @(report.eventsPerSecond),
+            @"maximumBacklog" : @(report.maximumBacklog),
+            @"lateEvents" : @(report.lateEventCount)
+        });
+    }];
+}
+
++ (NSDictionary<NSString *, NSNumber *> *)runRecordingOfLog:(NSData *)log listenersPerKey:(NSUInteger)listenersPerKey {
+    NSMutableArray<DJIKey *> *keys = [[NSMutableArray alloc] init];
+    NSMutableArray<NSArray *> *events = [[NSMutableArray alloc] init];
+    [self readLog:log keys:keys events:events];
+    
+    DUXBetaInMemoryKeyHandler *source = [[DUXBetaInMemoryKeyHandler alloc] init];
+    DUXBetaTelemetryRecordingKeyHandler *recorder = [[DUXBetaTelemetryRecordingKeyHandler alloc] initWithHandler:source];
+    NSMutableArray *listeners = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < listenersPerKey; i++) {
+        NSObject *listener = [[NSObject alloc] init];
+        [listeners addObject:listener];
+        for (DJIKey *key in keys) {
+            [recorder startListeningForChangesOnKey:key withListener:listener andUpdateBlock:^(DJIKeyedValue * _Nullable oldValue, DJIKeyedValue * _Nullable newValue) {}];
+        }
+    }
+    
+    uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    for (NSArray *event in events) {
+        id value = event[1];
+        [source updateValue:value == [NSNull null] ? nil : value forKey:event[0]];
+    }
+    uint64_t elapsed = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+    
+    for (NSObject *listener in listeners) {
+        [recorder stopAllListeningOfListeners:listener];
+    }
+    
+    return @{
+        @"events" : @(events.count),
+        @"recordedEvents" : @(recorder.writer.eventCount),
+        @"nanosecondsPerEvent" : @(events.count > 0 ? elapsed / events.count : 0)
+    };
+}
+
+@end
@@ -0,0 +1,92 @@
+//
+//  DUXBetaTelemetryReplayKeyHandler.h
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+#import <UXSDKCoreBenchmarks/DUXBetaInMemoryKeyHandler.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Replays the log as fast as events can be pushed, ignoring the recorded timing.
+ */
+FOUNDATION_EXPORT const double DUXBetaTelemetryReplaySpeedUnlimited;
+
+@interface DUXBetaTelemetryReplayReport : NSObject
+
+@property (readonly, nonatomic) NSUInteger eventCount;
+@property (readonly, nonatomic) uint64_t elapsedNanoseconds;
+@property (readonly, nonatomic) double eventsPerSecond;
+
+/**
+ *  The most events waiting on the callback queue at once.
+ */
+@property (readonly, nonatomic) NSUInteger maximumBacklog;
+
+/**
+ *  The furthest behind its recorded time an event was pushed, and how many events were pushed more than a
+ *  millisecond late. Always 0 for an unlimited speed replay.
+ */
+@property (readonly, nonatomic) uint64_t maximumLagNanoseconds;
+@property (readonly, nonatomic) NSUInteger lateEventCount;
+
+@property (readonly, nonatomic) BOOL cancelled;
+@property (readonly, nonatomic, nullable) NSError *error;
+
+@end
+
+/**
+ *  A DUXBetaInMemoryKeyHandler fed from a log written by DUXBetaTelemetryRecordingKeyHandler or
+ *  DUXBetaTelemetryLogWriter. Events are read on a background queue and pushed to the listeners on the callback
+ *  queue in log order, so the order of updates per key is the recorded one.
+ */
+@interface DUXBetaTelemetryReplayKeyHandler : DUXBetaInMemoryKeyHandler
+
+- (nullable instancetype)initWithLog:(NSData *)log error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ *  Serial queue the listeners are called on, the main queue by default.
+ */
+@property (strong, nonatomic) dispatch_queue_t callbackQueue;
+
+/**
+ *  Reading stops while this many events are waiting on the callback queue. 1024 by default.
+ */
+@property (assign, nonatomic) NSUInteger backlogLimit;
+
+@property (readonly, nonatomic, getter=isReplaying) BOOL replaying;
+
+/**
+ *  Replays the log from the start. A speed of 1 keeps the recorded timing, 10 runs ten times as fast. The
+ *  completion is called on the callback queue once the last event was delivered.
+ */
+- (void)replayAtSpeed:(double)speed completion:(nullable void (^)(DUXBetaTelemetryReplayReport *report))completion;
+
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,162 @@
+//
+//  DUXBetaTelemetryReplayKeyHandler.m
+//  UXSDKCore
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaTelemetryReplayKeyHandler.h"
+#import <UXSDKCore/DUXBetaTelemetryLog.h>
+#import <stdatomic.h>
+
+const double DUXBetaTelemetryReplaySpeedUnlimited = 0;
+
+static const uint64_t kDUXBetaTelemetryLateThreshold = NSEC_PER_MSEC;
+
+@interface DUXBetaTelemetryReplayReport ()
+
+@property (assign, nonatomic) NSUInteger eventCount;
+@property (assign, nonatomic) uint64_t elapsedNanoseconds;
+@property (assign, nonatomic) NSUInteger maximumBacklog;
+@property (assign, nonatomic) uint64_t maximumLagNanoseconds;
+@property (assign, nonatomic) NSUInteger lateEventCount;
+@property (assign, nonatomic) BOOL cancelled;
+@property (strong, nonatomic, nullable) NSError *error;
+
+@end
+
+@implementation DUXBetaTelemetryReplayReport
+
+- (double)eventsPerSecond {
+    return self.elapsedNanoseconds > 0 ? (double)self.eventCount * NSEC_PER_SEC / self.elapsedNanoseconds : 0;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%lu events in %.3fs (%.0f/s), max backlog %lu, max lag %.3fms, %lu late%@", (unsigned long)self.eventCount, (double)self.elapsedNanoseconds / NSEC_PER_SEC, self.eventsPerSecond, (unsigned long)self.maximumBacklog, (double)self.maximumLagNanoseconds / NSEC_PER_MSEC, (unsigned long)self.lateEventCount, self.cancelled ? @", cancelled" : @""];
+}
+
+@end
+
+@interface DUXBetaTelemetryReplayKeyHandler ()
+{
+    atomic_bool _replaying;
+    atomic_bool _cancelled;
+    atomic_ulong _backlog;
+}
+
+@property (strong, nonatomic) DUXBetaTelemetryLogReader *reader;
+@property (strong, nonatomic) dispatch_queue_t replayQueue;
+
+@end
+
+@implementation DUXBetaTelemetryReplayKeyHandler
+
+- (nullable instancetype)initWithLog:(NSData *)log error:(NSError * _Nullable * _Nullable)error {
+    DUXBetaTelemetryLogReader *reader = [[DUXBetaTelemetryLogReader alloc] initWithData:log error:error];
+    if (reader == nil) {
+        return nil;
+    }
+    if (self = [super init]) {
+        _reader = reader;
+        _callbackQueue = dispatch_get_main_queue();
+        _backlogLimit = 1024;
+        _replayQueue = dispatch_queue_create("com.dji.uxsdk.telemetryReplay", DISPATCH_QUEUE_SERIAL);
+        atomic_init(&_replaying, false);
+        atomic_init(&_cancelled, false);
+        atomic_init(&_backlog, 0);
+    }
+    return self;
+}
+
+- (BOOL)isReplaying {
+    return atomic_load(&_replaying);
+}
+
+- (void)cancel {
+    atomic_store(&_cancelled, true);
+}
+
+- (void)replayAtSpeed:(double)speed completion:(nullable void (^)(DUXBetaTelemetryReplayReport *report))completion {
+    bool expected = false;
+    if (!atomic_compare_exchange_strong(&_replaying, &expected, true)) {
+        NSAssert(NO, @"The log is already being replayed.");
+        return;
+    }
+    atomic_store(&_cancelled, false);
+    
+    dispatch_queue_t callbackQueue = self.callbackQueue;
+    NSUInteger backlogLimit = MAX(self.backlogLimit, 1);
+    dispatch_async(self.replayQueue, ^{
+        DUXBetaTelemetryReplayReport *report = [[DUXBetaTelemetryReplayReport alloc] init];
+        dispatch_semaphore_t backlogSemaphore = dispatch_semaphore_create(backlogLimit);
+        
+        [self.reader rewind];
+        uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+        uint64_t timestamp = 0;
+        DJIKey *key = nil;
+        id value = nil;
+        NSError *error = nil;
+        while ([self.reader readEventWithTimestamp:&timestamp key:&key value:&value error:&error]) {
+            if (atomic_load(&self->_cancelled)) {
+                report.cancelled = YES;
+                break;
+            }
+            if (speed > 0) {
+                uint64_t due = start + (uint64_t)(timestamp / speed);
+                uint64_t now = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+                if (now < due) {
+                    usleep((useconds_t)((due - now) / NSEC_PER_USEC));
+                } else {
+                    uint64_t lag = now - due;
+                    report.maximumLagNanoseconds = MAX(report.maximumLagNanoseconds, lag);
+                    if (lag > kDUXBetaTelemetryLateThreshold) {
+                        report.lateEventCount++;
+                    }
+                }
+            }
+            
+            dispatch_semaphore_wait(backlogSemaphore, DISPATCH_TIME_FOREVER);
+            unsigned long waiting = atomic_fetch_add(&self->_backlog, 1) + 1;
+            report.maximumBacklog = MAX(report.maximumBacklog, waiting);
+            report.eventCount++;
+            DJIKey *eventKey = key;
+            id eventValue = value;
+            dispatch_async(callbackQueue, ^{
+                [self updateValue:eventValue forKey:eventKey];
+                atomic_fetch_sub(&self->_backlog, 1);
+                dispatch_semaphore_signal(backlogSemaphore);
+            });
+        }
+        report.error = error;
+        
+        dispatch_async(callbackQueue, ^{
+            report.elapsedNanoseconds = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+            atomic_store(&self->_replaying, false);
+            if (completion) {
+                completion(report);
+            }
+        });
+    });
+}
+
+@end
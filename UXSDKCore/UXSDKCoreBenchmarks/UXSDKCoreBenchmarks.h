@@ -0,0 +1,42 @@
+//
+//  UXSDKCoreBenchmarks.h
+//  UXSDKCoreBenchmarks
+//
+//  MIT License
+//
+//  Copyright © 2018-2020 DJI
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+//! Project version number for UXSDKCoreBenchmarks.
+FOUNDATION_EXPORT double UXSDKCoreBenchmarksVersionNumber;
+
+//! Project version string for UXSDKCoreBenchmarks.
+FOUNDATION_EXPORT const unsigned char UXSDKCoreBenchmarksVersionString[];
+
+// Benchmarks and mock handlers for UXSDKCore. They are built as their own framework and are not part of the SDK.
+
+#import <UXSDKCoreBenchmarks/DUXBetaInMemoryKeyHandler.h>
+#import <UXSDKCoreBenchmarks/DUXBetaTelemetryReplayKeyHandler.h>
+#import <UXSDKCoreBenchmarks/DUXBetaBindingBenchmark.h>
+#import <UXSDKCoreBenchmarks/DUXBetaTelemetryReplayBenchmark.h>
+#import <UXSDKCoreBenchmarks/DUXBetaSnapshotBenchmark.h>
@@ -56,5 +56,9 @@ FOUNDATION_EXPORT const unsigned char UXSDKMapVersionString[];
 #import <UXSDKMap/DUXBetaFlyZoneDataProviderModel.h>
 #import <UXSDKMap/DUXBetaMapFlyZoneCircleOverlay.h>
 #import <UXSDKMap/DUXBetaMapPolylineOverlay.h>
+#import <UXSDKMap/DUXBetaMapFlightPath.h>
+#import <UXSDKMap/DUXBetaMapOverlayReconciler.h>
+#import <UXSDKMap/DUXBetaMapFlyZoneDiffer.h>
+#import <UXSDKMap/DUXBetaFlyZoneSpatialIndex.h>
 #import <UXSDKMap/DUXBetaMapSubFlyZonePolygonOverlay.h>
 #import <UXSDKMap/DUXBetaMapView.h>
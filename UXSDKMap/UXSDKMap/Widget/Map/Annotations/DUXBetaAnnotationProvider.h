@@ -27,6 +27,8 @@
 
 #import <Foundation/Foundation.h>
 #import <DJISDK/DJISDK.h>
+#import <MapKit/MapKit.h>
+#import "DUXBetaMapFlyZoneDiffer.h"
 
 @class DUXBetaMapWidget;
 @class DUXBetaMapSubFlyZoneAnnotation;
@@ -34,11 +36,16 @@
 
 @interface DUXBetaAnnotationProvider : NSObject
 
+// Inserted and deleted by the last commit
 @property (nonatomic, strong, readonly) NSArray <id <MKAnnotation>> *addedAnnotations;
 @property (nonatomic, strong, readonly) NSArray <id <MKAnnotation>> *removedAnnotations;
 
+// Annotations as of the last commit
 @property (nonatomic, strong, readonly) NSArray <id <MKAnnotation>> *allAnnotations;
 
+// The annotations that should be on the map given the updates so far, keyed by fly zone identifier
+@property (nonatomic, strong, readonly) NSDictionary <NSString *, id <MKAnnotation>> *desiredAnnotations;
+
 @property (nonatomic, weak) DUXBetaMapWidget *mapWidget;
 
 - (void)beginLockedFlyZoneUpdates;
@@ -50,6 +57,9 @@
 - (void)beginCustomUnlockedFlyZoneUpdates;
 - (void)endCustomUnlockedFlyZoneUpdates;
 
+// Diffs the desired annotations against the last commit and makes them current
+- (DUXBetaMapFlyZoneDiff<id<MKAnnotation>> *)commitChanges;
+
 - (void)addAnnotationForLockedFlyZone:(DJIFlyZoneInformation *)flyZone;
 - (void)addAnnotationForUnlockedFlyZone:(DJIFlyZoneInformation *)flyZone;
 
@@ -35,20 +35,13 @@
 
 @interface DUXBetaAnnotationProvider ()
 
-@property (nonatomic, strong) NSMutableDictionary *mutableAddedLockedAnnotations;
-@property (nonatomic, strong) NSMutableDictionary *mutableRemovedLockedAnnotations;
+// Annotations added since the matching begin call, by fly zone identifier
+@property (nonatomic, strong) NSMutableDictionary *mutableLockedAnnotations;
+@property (nonatomic, strong) NSMutableDictionary *mutableUnlockedAnnotations;
+@property (nonatomic, strong) NSMutableDictionary *mutableCustomUnlockedAnnotations;
 
-@property (nonatomic, strong) NSMutableDictionary *mutableAllLockedAnnotations;
-
-@property (nonatomic, strong) NSMutableDictionary *mutableAddedUnlockedAnnotations;
-@property (nonatomic, strong) NSMutableDictionary *mutableRemovedUnlockedAnnotations;
-
-@property (nonatomic, strong) NSMutableDictionary *mutableAllUnlockedAnnotations;
-
-@property (nonatomic, strong) NSMutableDictionary *mutableAddedCustomUnlockedAnnotations;
-@property (nonatomic, strong) NSMutableDictionary *mutableRemovedCustomUnlockedAnnotations;
-
-@property (nonatomic, strong) NSMutableDictionary *mutableAllCustomUnlockedAnnotations;
+@property (nonatomic, strong) DUXBetaMapFlyZoneDiffer<id<MKAnnotation>> *differ;
+@property (nonatomic, strong) DUXBetaMapFlyZoneDiff<id<MKAnnotation>> *lastDiff;
 
 @end
 
@@ -59,17 +52,10 @@
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _mutableAddedLockedAnnotations = [NSMutableDictionary dictionary];
-        _mutableRemovedLockedAnnotations = [NSMutableDictionary dictionary];
-        _mutableAllLockedAnnotations = [NSMutableDictionary dictionary];
-        
-        _mutableAddedUnlockedAnnotations = [NSMutableDictionary dictionary];
-        _mutableRemovedUnlockedAnnotations = [NSMutableDictionary dictionary];
-        _mutableAllUnlockedAnnotations = [NSMutableDictionary dictionary];
-        
-        _mutableAddedCustomUnlockedAnnotations = [NSMutableDictionary dictionary];
-        _mutableRemovedCustomUnlockedAnnotations = [NSMutableDictionary dictionary];
-        _mutableAllCustomUnlockedAnnotations = [NSMutableDictionary dictionary];
+        _mutableLockedAnnotations = [NSMutableDictionary dictionary];
+        _mutableUnlockedAnnotations = [NSMutableDictionary dictionary];
+        _mutableCustomUnlockedAnnotations = [NSMutableDictionary dictionary];
+        _differ = [[DUXBetaMapFlyZoneDiffer alloc] init];
     }
     return self;
 }
@@ -77,120 +63,30 @@
 #pragma mark - Update Methods
 
 - (void)beginLockedFlyZoneUpdates {
-    self.mutableAddedLockedAnnotations = [NSMutableDictionary dictionary];
+    self.mutableLockedAnnotations = [NSMutableDictionary dictionary];
 }
 
 - (void)endLockedFlyZoneUpdates {
-    NSArray *allAddedLockedAnnotationsKeys = self.mutableAddedLockedAnnotations.allKeys;
-    for (NSString *flyZoneIdentifier in allAddedLockedAnnotationsKeys) {
-        if (self.mutableAddedUnlockedAnnotations[flyZoneIdentifier] != nil) {
-            [self.mutableAddedLockedAnnotations removeObjectForKey:flyZoneIdentifier];
-        }
-    }
-
-    for (NSString *flyZoneIdentifier in self.mutableAllLockedAnnotations.allKeys) {
-        if (self.mutableAddedLockedAnnotations[flyZoneIdentifier] == nil) {
-            self.mutableRemovedLockedAnnotations[flyZoneIdentifier] = self.mutableAllLockedAnnotations[flyZoneIdentifier];
-        }
-    }
-    
-    for (NSString *flyZoneIdentifier in self.mutableRemovedLockedAnnotations.allKeys) {
-        [self.mutableAllLockedAnnotations removeObjectForKey:flyZoneIdentifier];
-    }
-    
-    [self recomputeAllLockedFlyZones];
+    // Filtering and unlocked zones replacing locked ones are resolved by desiredAnnotations
 }
 
 - (void)beginUnlockedFlyZoneUpdates {
-    self.mutableAddedUnlockedAnnotations = [NSMutableDictionary dictionary];
+    self.mutableUnlockedAnnotations = [NSMutableDictionary dictionary];
 }
 
 - (void)endUnlockedFlyZoneUpdates {
-    for (NSString *flyZoneIdentifier in self.mutableAllUnlockedAnnotations.allKeys) {
-        if (self.mutableAddedUnlockedAnnotations[flyZoneIdentifier] == nil) {
-            self.mutableRemovedUnlockedAnnotations[flyZoneIdentifier] = self.mutableAllUnlockedAnnotations[flyZoneIdentifier];
-        } else {
-            if (self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier]) {
-                DJIFlyZoneInformation *flyZone = self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier];
-                if ([self filterWithCategory:flyZone.category]) {
-                    self.mutableRemovedUnlockedAnnotations[flyZoneIdentifier] = self.mutableAllUnlockedAnnotations[flyZoneIdentifier];
-                }
-            } else if (self.mapWidget.unlockedFlyZones[flyZoneIdentifier]) {
-                DJIFlyZoneInformation *flyZone = self.mapWidget.unlockedFlyZones[flyZoneIdentifier];
-                if ([self filterWithCategory:flyZone.category]) {
-                    self.mutableRemovedUnlockedAnnotations[flyZoneIdentifier] = self.mutableAllUnlockedAnnotations[flyZoneIdentifier];
-                }
-            }
-        }
-    }
-    
-    for (NSString *flyZoneIdentifier in self.mutableRemovedUnlockedAnnotations) {
-        [self.mutableAllUnlockedAnnotations removeObjectForKey:flyZoneIdentifier];
-    }
-    
-    [self recomputeAllUnlockedFlyZones];
 }
 
 - (void)beginCustomUnlockedFlyZoneUpdates {
-    self.mutableAddedCustomUnlockedAnnotations = [NSMutableDictionary dictionary];
+    self.mutableCustomUnlockedAnnotations = [NSMutableDictionary dictionary];
 }
 
 - (void)endCustomUnlockedFlyZoneUpdates {
-    NSArray *allCustomUnlockedAnnotationsKeys = [self.mutableAllCustomUnlockedAnnotations.allKeys copy];
-    
-    for (NSString *flyZoneIdentifier in allCustomUnlockedAnnotationsKeys) {
-        if (![self.mutableAddedCustomUnlockedAnnotations.allKeys containsObject:flyZoneIdentifier]) {
-            self.mutableRemovedCustomUnlockedAnnotations[flyZoneIdentifier] = self.mutableAllCustomUnlockedAnnotations[flyZoneIdentifier];
-        }
-    }
-    
-    [self recomputeAllCustomUnlockedFlyZones];
-}
-
-- (void)recomputeAllLockedFlyZones {
-    NSArray *allMutableAddedLockedAnnotationsKeys = self.mutableAddedLockedAnnotations.allKeys;
-    for (NSString *flyZoneIdentifier in allMutableAddedLockedAnnotationsKeys) {
-        if (![self.mutableAllLockedAnnotations.allKeys containsObject:flyZoneIdentifier]) {
-            self.mutableAllLockedAnnotations[flyZoneIdentifier] = self.mutableAddedLockedAnnotations[flyZoneIdentifier];
-        }
-    }
-    
-    NSArray *allMutableAllLockedAnnotationsKeys = self.mutableAllLockedAnnotations.allKeys;
-    for (NSString *flyZoneIdentifier in allMutableAllLockedAnnotationsKeys) {
-        if (![self.mutableAddedLockedAnnotations.allKeys containsObject:flyZoneIdentifier]) {
-            self.mutableRemovedLockedAnnotations[flyZoneIdentifier] = self.mutableAllLockedAnnotations[flyZoneIdentifier];
-        }
-    }
-}
-
-- (void)recomputeAllUnlockedFlyZones {
-    NSArray *allMutableAddedUnlockedAnnotationsKeys = self.mutableAddedUnlockedAnnotations.allKeys;
-    for (NSString *flyZoneIdentifier in allMutableAddedUnlockedAnnotationsKeys) {
-        if (![self.mutableAllUnlockedAnnotations.allKeys containsObject:flyZoneIdentifier]) {
-            self.mutableAllUnlockedAnnotations[flyZoneIdentifier] = self.mutableAddedUnlockedAnnotations[flyZoneIdentifier];
-        }
-    }
-    
-    NSArray *allMutableAllUnlockedAnnotationsKeys = self.mutableAllUnlockedAnnotations.allKeys;
-    for (NSString *flyZoneIdentifier in allMutableAllUnlockedAnnotationsKeys) {
-        if (![self.mutableAddedUnlockedAnnotations.allKeys containsObject:flyZoneIdentifier]) {
-            self.mutableRemovedUnlockedAnnotations[flyZoneIdentifier] = self.mutableAllUnlockedAnnotations[flyZoneIdentifier];
-        }
-    }
 }
 
-- (void)recomputeAllCustomUnlockedFlyZones {
-    self.mutableAllCustomUnlockedAnnotations = [self.mutableAddedCustomUnlockedAnnotations mutableCopy];
-    
-    if (self.mapWidget.showCustomUnlockZones) {
-        for (NSString *flyZoneIdentifier in self.mutableAddedCustomUnlockedAnnotations) {
-            if (![self.mutableAllCustomUnlockedAnnotations.allKeys containsObject:flyZoneIdentifier]) {
-                self.mutableAllCustomUnlockedAnnotations[flyZoneIdentifier] = self.mutableAddedCustomUnlockedAnnotations[flyZoneIdentifier];
-            }
-        }
-    } else {
-        [self.mutableRemovedCustomUnlockedAnnotations addEntriesFromDictionary:self.mutableAllCustomUnlockedAnnotations];
-    }
+- (DUXBetaMapFlyZoneDiff<id<MKAnnotation>> *)commitChanges {
+    self.lastDiff = [self.differ applyObjects:self.desiredAnnotations];
+    return self.lastDiff;
 }
 
 #pragma mark - Annotation Handling
@@ -198,17 +94,17 @@
 - (void)addAnnotationForSubFlyZone:(DJISubFlyZoneInformation *)subFlyZone
                      withinFlyZone:(DJIFlyZoneInformation *)flyZone {
     DUXBetaMapSubFlyZoneAnnotation *subFlyZoneAnnotation = [self subFlyZoneAnnotationForSubFlyZone:subFlyZone];
-    self.mutableAddedLockedAnnotations[[NSString duxbeta_subFlyZoneProviderAccessKeyWithFlyZone:flyZone subFlyZone:subFlyZone]] = subFlyZoneAnnotation;
+    self.mutableLockedAnnotations[[NSString duxbeta_subFlyZoneProviderAccessKeyWithFlyZone:flyZone subFlyZone:subFlyZone]] = subFlyZoneAnnotation;
 }
 
 - (void)addAnnotationForLockedFlyZone:(DJIFlyZoneInformation *)flyZone {
     DUXBetaMapNoFlyZoneAnnotation *flyZoneAnnotation = [self flyZoneAnnotationForFlyZone:flyZone];
-    self.mutableAddedLockedAnnotations[[NSString duxbeta_flyZoneProviderAccessKeyWithFlyZone:flyZone]] = flyZoneAnnotation;
+    self.mutableLockedAnnotations[[NSString duxbeta_flyZoneProviderAccessKeyWithFlyZone:flyZone]] = flyZoneAnnotation;
 }
 
 - (void)addAnnotationForUnlockedFlyZone:(DJIFlyZoneInformation *)flyZone {
     DUXBetaMapNoFlyZoneAnnotation *flyZoneAnnotation = [self flyZoneAnnotationForFlyZone:flyZone];
-    self.mutableAddedUnlockedAnnotations[[NSString duxbeta_flyZoneProviderAccessKeyWithFlyZone:flyZone]] = flyZoneAnnotation;
+    self.mutableUnlockedAnnotations[[NSString duxbeta_flyZoneProviderAccessKeyWithFlyZone:flyZone]] = flyZoneAnnotation;
 }
 
 - (void)addAnnotationForCustomUnlockZone:(DJICustomUnlockZone *)flyZone
@@ -217,7 +113,7 @@
     DUXBetaMapNoFlyZoneAnnotation *flyZoneAnnotation = [self flyZoneAnnotationForCustomUnlockZone:flyZone
                                                                                sentToAircraft:sentToAircraft
                                                                             enabledOnAircraft:enabledOnAircraft];
-    self.mutableAddedCustomUnlockedAnnotations[[NSString duxbeta_customUnlockZoneProviderAccessKeyWithFlyZone:flyZone]] = flyZoneAnnotation;
+    self.mutableCustomUnlockedAnnotations[[NSString duxbeta_customUnlockZoneProviderAccessKeyWithFlyZone:flyZone]] = flyZoneAnnotation;
 }
 
 - (BOOL)filterWithCategory:(DJIFlyZoneCategory)category {
@@ -236,84 +132,47 @@
 
 #pragma mark - Public Properties
 
-- (NSArray <id <MKOverlay>> *)allAnnotations {
-    // Combine locked and unlocked Annotations together, unlocked Annotations will replace locked ones
-    NSMutableArray *allAnnotations = [NSMutableArray array];
+- (NSDictionary<NSString *, id<MKAnnotation>> *)desiredAnnotations {
+    NSMutableDictionary *desiredAnnotations = [NSMutableDictionary dictionaryWithCapacity:self.mutableLockedAnnotations.count + self.mutableUnlockedAnnotations.count];
     
-    for (NSString *flyZoneIdentifier in self.mutableAllLockedAnnotations.allKeys) {
-        if (self.mapWidget.flyZones[flyZoneIdentifier] != nil) {
-            DJIFlyZoneInformation *flyZone = (DJIFlyZoneInformation *)self.mapWidget.flyZones[flyZoneIdentifier];
-            if ([self filterWithCategory:flyZone.category]) {
-                if (self.mutableAllUnlockedAnnotations[flyZoneIdentifier] == nil) {
-                    [allAnnotations addObject:self.mutableAllLockedAnnotations[flyZoneIdentifier]];
-                } else {
-                    [allAnnotations addObject:self.mutableAllUnlockedAnnotations[flyZoneIdentifier]];
-                }
-            } else {
-                // Do nothing, zone's filtered out
-            }
-        } else {
-            // Sub fly zones cannot be unlocked for now, just check for parent zone category
-            DJIFlyZoneInformation *parentFlyZone = self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier];
-            if ([self filterWithCategory:parentFlyZone.category]) {
-                [allAnnotations addObject:self.mutableAllLockedAnnotations[flyZoneIdentifier]];
-            }
+    [self.mutableLockedAnnotations enumerateKeysAndObjectsUsingBlock:^(NSString *flyZoneIdentifier, id<MKAnnotation> annotation, BOOL *stop) {
+        // Unlocked annotations replace locked ones
+        if (self.mutableUnlockedAnnotations[flyZoneIdentifier] != nil) {
+            return;
         }
-    }
-    
-    return [NSArray arrayWithArray:allAnnotations];
-}
-
-- (NSArray<id<MKOverlay>> *)addedAnnotations {
-    NSMutableArray *addedAnnotations = [NSMutableArray array];
-    
-    for (NSString *flyZoneIdentifier in self.mutableAddedLockedAnnotations.allKeys) {
-        //If added fly zone not already in all Annotations and not filtered out, then add it to added
-        if (self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier]) {
-            DJIFlyZoneInformation *flyZone = self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier];
-            if (![self filterWithCategory:flyZone.category]) {
-                [addedAnnotations addObject:self.mutableAddedLockedAnnotations[flyZoneIdentifier]];
-            }
-        } else if (self.mapWidget.flyZones[flyZoneIdentifier]) {
-            DJIFlyZoneInformation *flyZone = self.mapWidget.flyZones[flyZoneIdentifier];
-            if (![self filterWithCategory:flyZone.category]) {
-                [addedAnnotations addObject:self.mutableAddedLockedAnnotations[flyZoneIdentifier]];
-            }
+        DJIFlyZoneInformation *flyZone = self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier] ?: self.mapWidget.flyZones[flyZoneIdentifier];
+        if (flyZone != nil && ![self filterWithCategory:flyZone.category]) {
+            desiredAnnotations[flyZoneIdentifier] = annotation;
         }
-    }
+    }];
     
-    for (NSString *flyZoneIdentifier in self.mutableAddedUnlockedAnnotations.allKeys) {
+    [self.mutableUnlockedAnnotations enumerateKeysAndObjectsUsingBlock:^(NSString *flyZoneIdentifier, id<MKAnnotation> annotation, BOOL *stop) {
         DJIFlyZoneInformation *flyZone = self.mapWidget.unlockedFlyZones[flyZoneIdentifier];
         if (![self filterWithCategory:flyZone.category]) {
-            [addedAnnotations addObject:self.mutableAddedUnlockedAnnotations[flyZoneIdentifier]];
+            desiredAnnotations[flyZoneIdentifier] = annotation;
         }
-    }
+    }];
     
     if (self.mapWidget.showCustomUnlockZones) {
-        for (NSString *flyZoneIdentifier in self.mutableAddedCustomUnlockedAnnotations.allKeys) {
-            [addedAnnotations addObject:self.mutableAddedCustomUnlockedAnnotations[flyZoneIdentifier]];
-        }
+        // Custom unlock zone IDs are not fly zone IDs, keep them apart
+        [self.mutableCustomUnlockedAnnotations enumerateKeysAndObjectsUsingBlock:^(NSString *flyZoneIdentifier, id<MKAnnotation> annotation, BOOL *stop) {
+            desiredAnnotations[[@"custom-" stringByAppendingString:flyZoneIdentifier]] = annotation;
+        }];
     }
 
-    return addedAnnotations;
+    return desiredAnnotations;
 }
 
-- (NSArray<id<MKOverlay>> *)removedAnnotations {
-    NSMutableArray *removedAnnotations = [NSMutableArray array];
-    
-    for (NSString *flyZoneIdentifier in self.mutableRemovedLockedAnnotations.allKeys) {
-        [removedAnnotations addObject:self.mutableRemovedLockedAnnotations[flyZoneIdentifier]];
-    }
-    
-    for (NSString *flyZoneIdentifier in self.mutableRemovedUnlockedAnnotations.allKeys) {
-        [removedAnnotations addObject:self.mutableRemovedUnlockedAnnotations[flyZoneIdentifier]];
-    }
-    
-    for (NSString *flyZoneIdentifier in self.mutableRemovedCustomUnlockedAnnotations.allKeys) {
-        [removedAnnotations addObject:self.mutableRemovedCustomUnlockedAnnotations[flyZoneIdentifier]];
-    }
-    
-    return removedAnnotations;
+- (NSArray<id<MKAnnotation>> *)allAnnotations {
+    return self.differ.currentObjects.allValues;
+}
+
+- (NSArray<id<MKAnnotation>> *)addedAnnotations {
+    return self.lastDiff.insertedObjects ?: @[];
+}
+
+- (NSArray<id<MKAnnotation>> *)removedAnnotations {
+    return self.lastDiff.deletedObjects ?: @[];
 }
 
 #pragma mark - Generating Annotations
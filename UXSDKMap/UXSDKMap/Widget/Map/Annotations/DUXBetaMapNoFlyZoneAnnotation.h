@@ -27,8 +27,9 @@
 
 #import <Foundation/Foundation.h>
 #import <MapKit/MapKit.h>
+#import "DUXBetaMapFlyZoneDiffer.h"
 
-@interface DUXBetaMapNoFlyZoneAnnotation : NSObject <MKAnnotation>
+@interface DUXBetaMapNoFlyZoneAnnotation : NSObject <MKAnnotation, DUXBetaMapFlyZoneDiffable>
 
 - (instancetype)initWithCoordinate:(CLLocationCoordinate2D)coordinate;
 
@@ -46,4 +46,21 @@
     _coordinate = newCoordinate;
 }
 
+- (BOOL)isEquivalentToFlyZoneObject:(id)object {
+    if (![object isMemberOfClass:[self class]]) {
+        return NO;
+    }
+    DUXBetaMapNoFlyZoneAnnotation *annotation = (DUXBetaMapNoFlyZoneAnnotation *)object;
+    return self.coordinate.latitude == annotation.coordinate.latitude &&
+        self.coordinate.longitude == annotation.coordinate.longitude &&
+        (self.title == annotation.title || [self.title isEqualToString:annotation.title]) &&
+        (self.subtitle == annotation.subtitle || [self.subtitle isEqualToString:annotation.subtitle]) &&
+        (self.noFlyZoneID == annotation.noFlyZoneID || [self.noFlyZoneID isEqualToNumber:annotation.noFlyZoneID]) &&
+        self.isUnlockable == annotation.isUnlockable &&
+        self.isUnlocked == annotation.isUnlocked &&
+        self.isCustomUnlockZone == annotation.isCustomUnlockZone &&
+        self.isCustomUnlockZoneSentToAircraft == annotation.isCustomUnlockZoneSentToAircraft &&
+        self.isCustomUnlockZoneEnabled == annotation.isCustomUnlockZoneEnabled;
+}
+
 @end
@@ -27,8 +27,9 @@
 
 #import <Foundation/Foundation.h>
 #import <MapKit/MapKit.h>
+#import "DUXBetaMapFlyZoneDiffer.h"
 
-@interface DUXBetaMapSubFlyZoneAnnotation : NSObject <MKAnnotation>
+@interface DUXBetaMapSubFlyZoneAnnotation : NSObject <MKAnnotation, DUXBetaMapFlyZoneDiffable>
 
 - (instancetype)initWithCoordinate:(CLLocationCoordinate2D)coordinate;
 
@@ -41,4 +41,16 @@
     _coordinate = newCoordinate;
 }
 
+- (BOOL)isEquivalentToFlyZoneObject:(id)object {
+    if (![object isMemberOfClass:[self class]]) {
+        return NO;
+    }
+    DUXBetaMapSubFlyZoneAnnotation *annotation = (DUXBetaMapSubFlyZoneAnnotation *)object;
+    return self.coordinate.latitude == annotation.coordinate.latitude &&
+        self.coordinate.longitude == annotation.coordinate.longitude &&
+        self.height == annotation.height &&
+        (self.title == annotation.title || [self.title isEqualToString:annotation.title]) &&
+        (self.subtitle == annotation.subtitle || [self.subtitle isEqualToString:annotation.subtitle]);
+}
+
 @end
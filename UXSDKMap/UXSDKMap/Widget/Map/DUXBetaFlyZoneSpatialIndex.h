@@ -0,0 +1,82 @@
+//
+//  DUXBetaFlyZoneSpatialIndex.h
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+#import <MapKit/MapKit.h>
+#import <DJISDK/DJISDK.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Whether two map rects overlap or touch. Unlike MKMapRectIntersectsRect, rects of zero width or height
+ * (a single point) can intersect.
+ */
+FOUNDATION_EXPORT BOOL DUXBetaFlyZoneSpatialIndexRectsIntersect(MKMapRect first, MKMapRect second);
+
+/**
+ * A fly zone, or a sub fly zone of a polygon fly zone, as stored in the spatial index.
+ */
+@interface DUXBetaFlyZoneSpatialIndexEntry : NSObject
+
+// The provider access key of the fly zone or sub fly zone
+@property (nonatomic, copy, readonly) NSString *identifier;
+@property (nonatomic, strong, readonly) DJIFlyZoneInformation *flyZone;
+@property (nonatomic, strong, readonly, nullable) DJISubFlyZoneInformation *subFlyZone;
+@property (nonatomic, assign, readonly) MKMapRect mapRect;
+
++ (instancetype)entryWithFlyZone:(DJIFlyZoneInformation *)flyZone;
++ (instancetype)entryWithSubFlyZone:(DJISubFlyZoneInformation *)subFlyZone withinFlyZone:(DJIFlyZoneInformation *)flyZone;
+
+@end
+
+/**
+ * An immutable R-tree over map rects, bulk loaded with sort-tile-recursive packing. Building takes
+ * O(n log n) and a query visits O(log n) nodes plus the ones holding results. Thread safe once built.
+ */
+@interface DUXBetaFlyZoneSpatialIndex<ObjectType> : NSObject
+
+/**
+ * Indexes the circle fly zones and the sub fly zones of polygon fly zones in flyZones.
+ */
++ (DUXBetaFlyZoneSpatialIndex<DUXBetaFlyZoneSpatialIndexEntry *> *)indexWithFlyZones:(NSArray<DJIFlyZoneInformation *> *)flyZones;
+
+- (instancetype)initWithObjects:(NSArray<ObjectType> *)objects
+                        mapRect:(MKMapRect (^)(ObjectType object))mapRectForObject NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ * Queries wrap around the antimeridian like the map does: a rect reaching past either edge of the world, such as a
+ * visible map rect across the date line, also matches the objects on the other side.
+ */
+- (NSArray<ObjectType> *)objectsIntersectingMapRect:(MKMapRect)mapRect;
+- (void)enumerateObjectsIntersectingMapRect:(MKMapRect)mapRect usingBlock:(void (^)(ObjectType object))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
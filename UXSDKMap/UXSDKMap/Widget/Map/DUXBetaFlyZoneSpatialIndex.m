@@ -0,0 +1,324 @@
+//
+//  DUXBetaFlyZoneSpatialIndex.m
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaFlyZoneSpatialIndex.h"
+#import "NSString+DUXBetaStrings.h"
+
+static const NSUInteger kDUXBetaFlyZoneSpatialIndexNodeCapacity = 16;
+
+typedef struct {
+    MKMapRect rect;
+    NSUInteger first;
+    NSUInteger count;
+} DUXBetaFlyZoneSpatialIndexNode;
+
+typedef struct {
+    MKMapRect rect;
+    NSUInteger index;
+} DUXBetaFlyZoneSpatialIndexItem;
+
+BOOL DUXBetaFlyZoneSpatialIndexRectsIntersect(MKMapRect first, MKMapRect second) {
+    return first.origin.x <= second.origin.x + second.size.width &&
+        second.origin.x <= first.origin.x + first.size.width &&
+        first.origin.y <= second.origin.y + second.size.height &&
+        second.origin.y <= first.origin.y + first.size.height;
+}
+
+// MKMapRectUnion may drop rects of zero size, which points are.
+static MKMapRect DUXBetaFlyZoneSpatialIndexRectUnion(MKMapRect first, MKMapRect second) {
+    double minX = MIN(first.origin.x, second.origin.x);
+    double minY = MIN(first.origin.y, second.origin.y);
+    double maxX = MAX(first.origin.x + first.size.width, second.origin.x + second.size.width);
+    double maxY = MAX(first.origin.y + first.size.height, second.origin.y + second.size.height);
+    return MKMapRectMake(minX, minY, maxX - minX, maxY - minY);
+}
+
+static MKMapRect DUXBetaFlyZoneSpatialIndexCircleRect(CLLocationCoordinate2D center, double radius) {
+    MKMapPoint point = MKMapPointForCoordinate(center);
+    double mapRadius = MAX(radius, 0) * MKMapPointsPerMeterAtLatitude(center.latitude);
+    return MKMapRectMake(point.x - mapRadius, point.y - mapRadius, 2 * mapRadius, 2 * mapRadius);
+}
+
+static int DUXBetaFlyZoneSpatialIndexCompareCenterX(const void *first, const void *second) {
+    MKMapRect a = ((const DUXBetaFlyZoneSpatialIndexItem *)first)->rect;
+    MKMapRect b = ((const DUXBetaFlyZoneSpatialIndexItem *)second)->rect;
+    double delta = MKMapRectGetMidX(a) - MKMapRectGetMidX(b);
+    return delta < 0 ? -1 : (delta > 0 ? 1 : 0);
+}
+
+static int DUXBetaFlyZoneSpatialIndexCompareCenterY(const void *first, const void *second) {
+    MKMapRect a = ((const DUXBetaFlyZoneSpatialIndexItem *)first)->rect;
+    MKMapRect b = ((const DUXBetaFlyZoneSpatialIndexItem *)second)->rect;
+    double delta = MKMapRectGetMidY(a) - MKMapRectGetMidY(b);
+    return delta < 0 ? -1 : (delta > 0 ? 1 : 0);
+}
+
+/**
+ * Sort-tile-recursive ordering: sorts items by x, cuts them into vertical slices of whole nodes and sorts
+ * each slice by y, so consecutive runs of node capacity items are spatially close.
+ */
+static void DUXBetaFlyZoneSpatialIndexSortTiles(DUXBetaFlyZoneSpatialIndexItem *items, NSUInteger count) {
+    if (count == 0) {
+        return;
+    }
+    NSUInteger capacity = kDUXBetaFlyZoneSpatialIndexNodeCapacity;
+    NSUInteger nodes = (count + capacity - 1) / capacity;
+    NSUInteger slices = (NSUInteger)ceil(sqrt((double)nodes));
+    NSUInteger sliceSize = MAX((NSUInteger)1, (nodes + slices - 1) / slices) * capacity;
+    
+    qsort(items, count, sizeof(DUXBetaFlyZoneSpatialIndexItem), DUXBetaFlyZoneSpatialIndexCompareCenterX);
+    for (NSUInteger start = 0; start < count; start += sliceSize) {
+        qsort(items + start, MIN(sliceSize, count - start), sizeof(DUXBetaFlyZoneSpatialIndexItem), DUXBetaFlyZoneSpatialIndexCompareCenterY);
+    }
+}
+
+static NSMutableData *DUXBetaFlyZoneSpatialIndexPackNodes(const DUXBetaFlyZoneSpatialIndexItem *items, NSUInteger count) {
+    NSUInteger capacity = kDUXBetaFlyZoneSpatialIndexNodeCapacity;
+    NSUInteger nodeCount = (count + capacity - 1) / capacity;
+    NSMutableData *nodeData = [NSMutableData dataWithLength:nodeCount * sizeof(DUXBetaFlyZoneSpatialIndexNode)];
+    DUXBetaFlyZoneSpatialIndexNode *nodes = nodeData.mutableBytes;
+    for (NSUInteger i = 0; i < nodeCount; i++) {
+        NSUInteger first = i * capacity;
+        NSUInteger nodeSize = MIN(capacity, count - first);
+        MKMapRect rect = items[first].rect;
+        for (NSUInteger j = first + 1; j < first + nodeSize; j++) {
+            rect = DUXBetaFlyZoneSpatialIndexRectUnion(rect, items[j].rect);
+        }
+        nodes[i] = (DUXBetaFlyZoneSpatialIndexNode){rect, first, nodeSize};
+    }
+    return nodeData;
+}
+
+@interface DUXBetaFlyZoneSpatialIndexEntry ()
+
+@property (nonatomic, copy, readwrite) NSString *identifier;
+@property (nonatomic, strong, readwrite) DJIFlyZoneInformation *flyZone;
+@property (nonatomic, strong, readwrite) DJISubFlyZoneInformation *subFlyZone;
+@property (nonatomic, assign, readwrite) MKMapRect mapRect;
+
+@end
+
+@implementation DUXBetaFlyZoneSpatialIndexEntry
+
++ (instancetype)entryWithFlyZone:(DJIFlyZoneInformation *)flyZone {
+    DUXBetaFlyZoneSpatialIndexEntry *entry = [[self alloc] init];
+    entry.identifier = [NSString duxbeta_flyZoneProviderAccessKeyWithFlyZone:flyZone];
+    entry.flyZone = flyZone;
+    entry.mapRect = DUXBetaFlyZoneSpatialIndexCircleRect(flyZone.center, flyZone.radius);
+    return entry;
+}
+
++ (instancetype)entryWithSubFlyZone:(DJISubFlyZoneInformation *)subFlyZone withinFlyZone:(DJIFlyZoneInformation *)flyZone {
+    DUXBetaFlyZoneSpatialIndexEntry *entry = [[self alloc] init];
+    entry.identifier = [NSString duxbeta_subFlyZoneProviderAccessKeyWithFlyZone:flyZone subFlyZone:subFlyZone];
+    entry.flyZone = flyZone;
+    entry.subFlyZone = subFlyZone;
+    
+    if (subFlyZone.shape == DJISubFlyZoneShapePolygon && subFlyZone.vertices.count > 0) {
+        MKMapRect rect = MKMapRectNull;
+        for (NSValue *value in subFlyZone.vertices) {
+            CLLocationCoordinate2D coordinate;
+            [value getValue:&coordinate];
+            MKMapPoint point = MKMapPointForCoordinate(coordinate);
+            MKMapRect pointRect = MKMapRectMake(point.x, point.y, 0, 0);
+            rect = MKMapRectIsNull(rect) ? pointRect : DUXBetaFlyZoneSpatialIndexRectUnion(rect, pointRect);
+        }
+        entry.mapRect = rect;
+    } else {
+        entry.mapRect = DUXBetaFlyZoneSpatialIndexCircleRect(subFlyZone.center, subFlyZone.radius);
+    }
+    return entry;
+}
+
+@end
+
+@interface DUXBetaFlyZoneSpatialIndex ()
+
+// Objects and their rects in leaf order
+@property (nonatomic, strong) NSArray *objects;
+@property (nonatomic, strong) NSData *objectRects;
+
+// Node levels from the leaves up, the last level holds the root
+@property (nonatomic, strong) NSArray<NSData *> *levels;
+
+@end
+
+@implementation DUXBetaFlyZoneSpatialIndex
+
++ (DUXBetaFlyZoneSpatialIndex<DUXBetaFlyZoneSpatialIndexEntry *> *)indexWithFlyZones:(NSArray<DJIFlyZoneInformation *> *)flyZones {
+    NSMutableArray<DUXBetaFlyZoneSpatialIndexEntry *> *entries = [NSMutableArray arrayWithCapacity:flyZones.count];
+    for (DJIFlyZoneInformation *flyZone in flyZones) {
+        if (flyZone.type == DJIFlyZoneTypeCircle) {
+            [entries addObject:[DUXBetaFlyZoneSpatialIndexEntry entryWithFlyZone:flyZone]];
+        } else if (flyZone.type == DJIFlyZoneTypePoly) {
+            for (DJISubFlyZoneInformation *subFlyZone in flyZone.subFlyZones) {
+                [entries addObject:[DUXBetaFlyZoneSpatialIndexEntry entryWithSubFlyZone:subFlyZone withinFlyZone:flyZone]];
+            }
+        }
+    }
+    return [[DUXBetaFlyZoneSpatialIndex alloc] initWithObjects:entries
+                                                       mapRect:^MKMapRect(DUXBetaFlyZoneSpatialIndexEntry *entry) {
+        return entry.mapRect;
+    }];
+}
+
+- (instancetype)initWithObjects:(NSArray *)objects mapRect:(MKMapRect (^)(id object))mapRectForObject {
+    self = [super init];
+    if (self) {
+        NSUInteger count = objects.count;
+        NSMutableData *itemData = [NSMutableData dataWithLength:count * sizeof(DUXBetaFlyZoneSpatialIndexItem)];
+        DUXBetaFlyZoneSpatialIndexItem *items = itemData.mutableBytes;
+        for (NSUInteger i = 0; i < count; i++) {
+            items[i] = (DUXBetaFlyZoneSpatialIndexItem){mapRectForObject(objects[i]), i};
+        }
+        DUXBetaFlyZoneSpatialIndexSortTiles(items, count);
+        
+        NSMutableArray *sortedObjects = [NSMutableArray arrayWithCapacity:count];
+        NSMutableData *objectRects = [NSMutableData dataWithLength:count * sizeof(MKMapRect)];
+        MKMapRect *rects = objectRects.mutableBytes;
+        for (NSUInteger i = 0; i < count; i++) {
+            [sortedObjects addObject:objects[items[i].index]];
+            rects[i] = items[i].rect;
+        }
+        _objects = sortedObjects;
+        _objectRects = objectRects;
+        
+        NSMutableArray<NSData *> *levels = [NSMutableArray array];
+        NSMutableData *level = count > 0 ? DUXBetaFlyZoneSpatialIndexPackNodes(items, count) : nil;
+        while (level != nil) {
+            NSUInteger nodeCount = level.length / sizeof(DUXBetaFlyZoneSpatialIndexNode);
+            if (nodeCount == 1) {
+                [levels addObject:level];
+                break;
+            }
+            
+            // Reorder this level's nodes into tiles and pack them under parents
+            DUXBetaFlyZoneSpatialIndexNode *nodes = level.mutableBytes;
+            NSMutableData *nodeItemData = [NSMutableData dataWithLength:nodeCount * sizeof(DUXBetaFlyZoneSpatialIndexItem)];
+            DUXBetaFlyZoneSpatialIndexItem *nodeItems = nodeItemData.mutableBytes;
+            for (NSUInteger i = 0; i < nodeCount; i++) {
+                nodeItems[i] = (DUXBetaFlyZoneSpatialIndexItem){nodes[i].rect, i};
+            }
+            DUXBetaFlyZoneSpatialIndexSortTiles(nodeItems, nodeCount);
+            
+            NSMutableData *sortedLevel = [NSMutableData dataWithLength:level.length];
+            DUXBetaFlyZoneSpatialIndexNode *sortedNodes = sortedLevel.mutableBytes;
+            for (NSUInteger i = 0; i < nodeCount; i++) {
+                sortedNodes[i] = nodes[nodeItems[i].index];
+            }
+            [levels addObject:sortedLevel];
+            level = DUXBetaFlyZoneSpatialIndexPackNodes(nodeItems, nodeCount);
+        }
+        _levels = levels;
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return self.objects.count;
+}
+
+- (NSArray *)objectsIntersectingMapRect:(MKMapRect)mapRect {
+    NSMutableArray *objects = [NSMutableArray array];
+    [self enumerateObjectsIntersectingMapRect:mapRect usingBlock:^(id object) {
+        [objects addObject:object];
+    }];
+    return objects;
+}
+
+- (void)enumerateObjectsIntersectingMapRect:(MKMapRect)mapRect usingBlock:(void (^)(id object))block {
+    if (self.levels.count == 0 || MKMapRectIsNull(mapRect)) {
+        return;
+    }
+    
+    // The map wraps around at the antimeridian. A rect crossing it, or a zone overhanging it, is matched by the
+    // copy of the rect one world width to the side, so the rect is queried at every copy overlapping the index.
+    double worldWidth = MKMapSizeWorld.width;
+    if (mapRect.size.width >= worldWidth) {
+        mapRect.origin.x = -worldWidth;
+        mapRect.size.width = 3 * worldWidth;
+    } else {
+        mapRect.origin.x = fmod(mapRect.origin.x, worldWidth);
+        if (mapRect.origin.x < 0) {
+            mapRect.origin.x += worldWidth;
+        }
+    }
+    
+    MKMapRect bounds = ((const DUXBetaFlyZoneSpatialIndexNode *)self.levels.lastObject.bytes)[0].rect;
+    MKMapRect queries[3];
+    NSUInteger queryCount = 0;
+    for (int shift = -1; shift <= 1; shift++) {
+        MKMapRect query = mapRect;
+        query.origin.x += shift * worldWidth;
+        if (DUXBetaFlyZoneSpatialIndexRectsIntersect(query, bounds)) {
+            queries[queryCount++] = query;
+        }
+    }
+    
+    NSArray *objects = self.objects;
+    if (queryCount == 1) {
+        [self visitLevel:self.levels.count - 1 first:0 count:1 mapRect:queries[0] block:^(NSUInteger index) {
+            block(objects[index]);
+        }];
+        return;
+    }
+    // An object reached through two copies is only reported once.
+    NSMutableIndexSet *found = [NSMutableIndexSet indexSet];
+    for (NSUInteger i = 0; i < queryCount; i++) {
+        [self visitLevel:self.levels.count - 1 first:0 count:1 mapRect:queries[i] block:^(NSUInteger index) {
+            if (![found containsIndex:index]) {
+                [found addIndex:index];
+                block(objects[index]);
+            }
+        }];
+    }
+}
+
+- (void)visitLevel:(NSUInteger)level
+             first:(NSUInteger)first
+             count:(NSUInteger)count
+           mapRect:(MKMapRect)mapRect
+             block:(void (^)(NSUInteger index))block {
+    const DUXBetaFlyZoneSpatialIndexNode *nodes = self.levels[level].bytes;
+    for (NSUInteger i = first; i < first + count; i++) {
+        if (!DUXBetaFlyZoneSpatialIndexRectsIntersect(nodes[i].rect, mapRect)) {
+            continue;
+        }
+        if (level > 0) {
+            [self visitLevel:level - 1 first:nodes[i].first count:nodes[i].count mapRect:mapRect block:block];
+        } else {
+            const MKMapRect *rects = self.objectRects.bytes;
+            for (NSUInteger j = nodes[i].first; j < nodes[i].first + nodes[i].count; j++) {
+                if (DUXBetaFlyZoneSpatialIndexRectsIntersect(rects[j], mapRect)) {
+                    block(j);
+                }
+            }
+        }
+    }
+}
+
+@end
@@ -0,0 +1,89 @@
+//
+//  DUXBetaMapFlyZoneDiffer.h
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Implemented by map objects that are rebuilt on every fly zone refresh, so a rebuilt object that draws the
+ * same thing as the one already on the map is not reported as changed.
+ */
+@protocol DUXBetaMapFlyZoneDiffable <NSObject>
+
+- (BOOL)isEquivalentToFlyZoneObject:(id)object;
+
+@end
+
+/**
+ * The difference between two keyed sets of map objects.
+ */
+@interface DUXBetaMapFlyZoneDiff<ObjectType> : NSObject
+
+// Keys only in the new set, with their new objects
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, ObjectType> *addedObjects;
+
+// Keys only in the old set, with their old objects
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, ObjectType> *removedObjects;
+
+// Keys in both sets whose objects are not equivalent, with their new and old objects
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, ObjectType> *changedObjects;
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, ObjectType> *replacedObjects;
+
+// What to add to and remove from a map showing the old set for it to show the new one
+@property (nonatomic, strong, readonly) NSArray<ObjectType> *insertedObjects;
+@property (nonatomic, strong, readonly) NSArray<ObjectType> *deletedObjects;
+
+@property (nonatomic, assign, readonly, getter=isEmpty) BOOL empty;
+
+@end
+
+/**
+ * Tracks a keyed set of map objects and diffs each new set against it in time linear in the size of both
+ * sets. Objects are equivalent when they are the same object or, for objects conforming to
+ * DUXBetaMapFlyZoneDiffable, when they say so. For a key whose object is equivalent the tracked object is
+ * kept, so the objects on the map are never swapped for identical copies. Not thread safe.
+ */
+@interface DUXBetaMapFlyZoneDiffer<ObjectType> : NSObject
+
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, ObjectType> *currentObjects;
+
+/**
+ * Diffs objects against the current set without changing it.
+ */
+- (DUXBetaMapFlyZoneDiff<ObjectType> *)diffWithObjects:(NSDictionary<NSString *, ObjectType> *)objects;
+
+/**
+ * Diffs objects against the current set and makes them the current set.
+ */
+- (DUXBetaMapFlyZoneDiff<ObjectType> *)applyObjects:(NSDictionary<NSString *, ObjectType> *)objects;
+
+- (void)removeAllObjects;
+
+@end
+
+NS_ASSUME_NONNULL_END
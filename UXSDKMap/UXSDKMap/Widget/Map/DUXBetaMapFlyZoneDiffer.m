@@ -0,0 +1,130 @@
+//
+//  DUXBetaMapFlyZoneDiffer.m
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaMapFlyZoneDiffer.h"
+
+@interface DUXBetaMapFlyZoneDiff ()
+
+@property (nonatomic, strong, readwrite) NSDictionary *addedObjects;
+@property (nonatomic, strong, readwrite) NSDictionary *removedObjects;
+@property (nonatomic, strong, readwrite) NSDictionary *changedObjects;
+@property (nonatomic, strong, readwrite) NSDictionary *replacedObjects;
+@property (nonatomic, strong) NSDictionary *resultingObjects;
+
+@end
+
+@implementation DUXBetaMapFlyZoneDiff
+
+- (NSArray *)insertedObjects {
+    return [self.addedObjects.allValues arrayByAddingObjectsFromArray:self.changedObjects.allValues];
+}
+
+- (NSArray *)deletedObjects {
+    return [self.removedObjects.allValues arrayByAddingObjectsFromArray:self.replacedObjects.allValues];
+}
+
+- (BOOL)isEmpty {
+    return self.addedObjects.count == 0 && self.removedObjects.count == 0 && self.changedObjects.count == 0;
+}
+
+@end
+
+@interface DUXBetaMapFlyZoneDiffer ()
+
+@property (nonatomic, strong, readwrite) NSDictionary *currentObjects;
+
+@end
+
+@implementation DUXBetaMapFlyZoneDiffer
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _currentObjects = @{};
+    }
+    return self;
+}
+
+- (DUXBetaMapFlyZoneDiff *)diffWithObjects:(NSDictionary<NSString *, id> *)objects {
+    NSDictionary *currentObjects = self.currentObjects;
+    NSMutableDictionary *added = [NSMutableDictionary dictionary];
+    NSMutableDictionary *removed = [NSMutableDictionary dictionary];
+    NSMutableDictionary *changed = [NSMutableDictionary dictionary];
+    NSMutableDictionary *replaced = [NSMutableDictionary dictionary];
+    NSMutableDictionary *resulting = [NSMutableDictionary dictionaryWithCapacity:objects.count];
+    
+    [currentObjects enumerateKeysAndObjectsUsingBlock:^(NSString *key, id object, BOOL *stop) {
+        if (objects[key] == nil) {
+            removed[key] = object;
+        }
+    }];
+    
+    [objects enumerateKeysAndObjectsUsingBlock:^(NSString *key, id object, BOOL *stop) {
+        id currentObject = currentObjects[key];
+        if (currentObject == nil) {
+            added[key] = object;
+            resulting[key] = object;
+        } else if ([self isObject:currentObject equivalentToObject:object]) {
+            resulting[key] = currentObject;
+        } else {
+            changed[key] = object;
+            replaced[key] = currentObject;
+            resulting[key] = object;
+        }
+    }];
+    
+    DUXBetaMapFlyZoneDiff *diff = [[DUXBetaMapFlyZoneDiff alloc] init];
+    diff.addedObjects = added;
+    diff.removedObjects = removed;
+    diff.changedObjects = changed;
+    diff.replacedObjects = replaced;
+    diff.resultingObjects = resulting;
+    return diff;
+}
+
+- (DUXBetaMapFlyZoneDiff *)applyObjects:(NSDictionary<NSString *, id> *)objects {
+    DUXBetaMapFlyZoneDiff *diff = [self diffWithObjects:objects];
+    self.currentObjects = diff.resultingObjects;
+    diff.resultingObjects = nil;
+    return diff;
+}
+
+- (void)removeAllObjects {
+    self.currentObjects = @{};
+}
+
+- (BOOL)isObject:(id)currentObject equivalentToObject:(id)object {
+    if (currentObject == object) {
+        return YES;
+    }
+    if ([currentObject conformsToProtocol:@protocol(DUXBetaMapFlyZoneDiffable)]) {
+        return [(id<DUXBetaMapFlyZoneDiffable>)currentObject isEquivalentToFlyZoneObject:object];
+    }
+    return NO;
+}
+
+@end
@@ -28,8 +28,11 @@
 #import "DUXBetaMapWidget.h"
 #import "DUXBetaMapWidgetModel.h"
 #import "DUXBetaMapView.h"
+#import "DUXBetaMapFlightPath.h"
+#import "DUXBetaMapOverlayReconciler.h"
 #import "DUXBetaMapWidget_Protected.h"
 #import "DUXBetaFlyZoneDataProvider.h"
+#import "DUXBetaFlyZoneSpatialIndex.h"
 #import "DUXBetaOverlayProvider.h"
 #import "DUXBetaAnnotationProvider.h"
 #import "DUXBetaMapViewLegendViewController.h"
@@ -37,10 +40,19 @@
 #import "NSString+DUXBetaStrings.h"
 
 static CGSize const kDesignSize = {200.0, 200.0};
+// Fly zones are loaded this many visible widths and heights beyond each edge of the map
+static const double kFlyZoneCullingMargin = 0.5;
+// Fly zones are reloaded once the visible width is this many times smaller than the loaded area
+static const double kFlyZoneCullingZoomInFactor = 4.0;
+
 @interface DUXBetaMapWidget () <DUXBetaFlyZoneDataProviderDelegate>
 
 @property (nonatomic, strong) DUXBetaMapState *mapState;
 @property (nonatomic, strong) DUXBetaMapView *underlyingMapView;
+@property (nonatomic, strong) DUXBetaMapOverlayReconciler *flyZoneOverlayReconciler;
+@property (nonatomic, strong) DUXBetaFlyZoneSpatialIndex<DUXBetaFlyZoneSpatialIndexEntry *> *lockedFlyZoneIndex;
+@property (nonatomic, strong) DUXBetaFlyZoneSpatialIndex<DUXBetaFlyZoneSpatialIndexEntry *> *unlockedFlyZoneIndex;
+@property (nonatomic, assign) MKMapRect flyZoneCullingRect;
 @property (nonatomic, strong) DJICustomUnlockZone *currentlyEnabledCustomUnlockZone;
 
 @property (nonatomic, strong) DUXBetaMapViewLegendViewController *mapViewLegendViewController;
@@ -284,6 +296,8 @@ static CGSize const kDesignSize = {200.0, 200.0};
         self.flyZones = [NSMutableDictionary dictionary];
         self.unlockedFlyZones = [NSMutableDictionary dictionary];
         self.subFlyZonesParentFlyZones = [NSMutableDictionary dictionary];
+        self.lockedFlyZoneIndex = nil;
+        self.unlockedFlyZoneIndex = nil;
         [self updateMapView];
     }
 }
@@ -315,6 +329,9 @@ static CGSize const kDesignSize = {200.0, 200.0};
     // Create Map
     self.underlyingMapView = [[DUXBetaMapView alloc] initWithFrame:frame];
     self.underlyingMapView.mapWidget = self;
+    self.flyZoneOverlayReconciler = [[DUXBetaMapOverlayReconciler alloc] initWithMapView:self.underlyingMapView];
+    // Nothing is culled until the map has a region
+    self.flyZoneCullingRect = MKMapRectWorld;
     // Add Map to self
     [self.view addSubview:self.underlyingMapView];
     
@@ -388,9 +405,7 @@ static CGSize const kDesignSize = {200.0, 200.0};
 }
 
 - (void)clearCurrentFlightPath {
-    [self.underlyingMapView removeOverlays:self.underlyingMapView.flightPathOverlays];
-    [self.underlyingMapView.flightPathOverlays removeAllObjects];
-    [self.underlyingMapView.flightPathCoordinates removeAllObjects];
+    [self.underlyingMapView removeOverlays:[self.underlyingMapView.flightPath removeAllCoordinates]];
 }
 
 - (void)syncCustomUnlockZones {
@@ -408,27 +423,23 @@ static CGSize const kDesignSize = {200.0, 200.0};
 }
 
 - (void)updateMapView {
-    if ([NSThread isMainThread]) {
-        @synchronized (self) {
-            [self.underlyingMapView removeOverlays:self.underlyingMapView.overlays];
-            //[self.underlyingMapView removeOverlays:self.overlayProvider.removedOverlays];
-            [self.underlyingMapView addOverlays:self.overlayProvider.addedOverlays
-                                          level:MKOverlayLevelAboveRoads];
-            [self.underlyingMapView removeAnnotations:self.annotationProvider.removedAnnotations];
-            [self.underlyingMapView addAnnotations:self.annotationProvider.addedAnnotations];
-        }
-    } else {
+    if (![NSThread isMainThread]) {
         dispatch_sync(dispatch_get_main_queue(), ^{
-            @synchronized (self) {
-                [self.underlyingMapView removeOverlays:self.underlyingMapView.overlays];
-
-                //[self.underlyingMapView removeOverlays:self.overlayProvider.removedOverlays];
-                [self.underlyingMapView addOverlays:self.overlayProvider.addedOverlays
-                                              level:MKOverlayLevelAboveRoads];
-                [self.underlyingMapView removeAnnotations:self.annotationProvider.removedAnnotations];
-                [self.underlyingMapView addAnnotations:self.annotationProvider.addedAnnotations];
-            }
+            [self updateMapView];
         });
+        return;
+    }
+    
+    @synchronized (self) {
+        // Fly zone overlays are diffed against what is already on the map and applied on the next frame
+        [self.overlayProvider commitChanges];
+        [self.flyZoneOverlayReconciler setDesiredOverlays:self.overlayProvider.committedOverlays];
+        
+        DUXBetaMapFlyZoneDiff<id<MKAnnotation>> *annotationDiff = [self.annotationProvider commitChanges];
+        if (!annotationDiff.isEmpty) {
+            [self.underlyingMapView removeAnnotations:annotationDiff.deletedObjects];
+            [self.underlyingMapView addAnnotations:annotationDiff.insertedObjects];
+        }
     }
 }
 
@@ -835,65 +846,107 @@ static CGSize const kDesignSize = {200.0, 200.0};
 }
 
 /*********************************************************************************/
-#pragma mark - DUXBetaFlyZoneDataProviderDelegate
+#pragma mark - Fly Zone Culling
 /*********************************************************************************/
 
-- (void)flyZoneDataProvider:(nonnull DUXBetaFlyZoneDataProvider *)flyZoneDataProvider didUpdateFlyZones:(nonnull NSDictionary <NSString *, DJIFlyZoneInformation *> *)flyZones {
+- (void)updateFlyZoneCulling {
+    MKMapRect visibleMapRect = self.underlyingMapView.visibleMapRect;
+    if (MKMapRectIsNull(visibleMapRect) || MKMapRectIsEmpty(visibleMapRect)) {
+        return;
+    }
+    
+    // Only reload once the map leaves the loaded area or zooms well into it, so small pans and
+    // zooms don't churn the overlays
+    BOOL movedOutside = !MKMapRectContainsRect(self.flyZoneCullingRect, visibleMapRect);
+    BOOL zoomedIn = visibleMapRect.size.width * kFlyZoneCullingZoomInFactor < self.flyZoneCullingRect.size.width;
+    if (!movedOutside && !zoomedIn) {
+        return;
+    }
+    
+    self.flyZoneCullingRect = MKMapRectInset(visibleMapRect,
+                                             -visibleMapRect.size.width * kFlyZoneCullingMargin,
+                                             -visibleMapRect.size.height * kFlyZoneCullingMargin);
+    if (self.lockedFlyZoneIndex == nil && self.unlockedFlyZoneIndex == nil) {
+        return;
+    }
+    // Same order as the fly zone data provider delivers them
+    [self reloadUnlockedFlyZones];
+    [self reloadLockedFlyZones];
+    [self updateMapView];
+}
+
+- (void)reloadLockedFlyZones {
     [self.annotationProvider beginLockedFlyZoneUpdates];
     [self.overlayProvider beginLockedFlyZoneUpdates];
-    self.subFlyZonesParentFlyZones = [NSMutableDictionary dictionary];
-    for (DJIFlyZoneInformation *flyZone in flyZones.allValues) {
-        if (flyZone.type == DJIFlyZoneTypeCircle) {
+    [self.lockedFlyZoneIndex enumerateObjectsIntersectingMapRect:self.flyZoneCullingRect usingBlock:^(DUXBetaFlyZoneSpatialIndexEntry *entry) {
+        DJIFlyZoneInformation *flyZone = entry.flyZone;
+        DJISubFlyZoneInformation *subFlyZone = entry.subFlyZone;
+        if (subFlyZone == nil) {
             [self.overlayProvider addLockedOverlayForFlyZone:flyZone];
             if (self.tapToUnlockEnabled && (flyZone.category == DJIFlyZoneCategoryAuthorization || flyZone.category == DJIFlyZoneCategoryEnhancedWarning)) {
                 [self.annotationProvider addAnnotationForLockedFlyZone:flyZone];
             }
-        } else if (flyZone.type == DJIFlyZoneTypePoly) {
-            for (DJISubFlyZoneInformation *subFlyZone in flyZone.subFlyZones) {
-                if (subFlyZone.shape == DJISubFlyZoneShapeCylinder) {
-                    [self.overlayProvider addOverlayForCylinderSubFlyZone:subFlyZone
-                                                            withinFlyZone:flyZone];
-                } else if (subFlyZone.shape == DJISubFlyZoneShapePolygon) {
-                    [self.overlayProvider addOverlayForPolygonSubFlyZone:subFlyZone
-                                                           withinFlyZone:flyZone];
-                }
-                self.subFlyZonesParentFlyZones[[NSString duxbeta_subFlyZoneProviderAccessKeyWithFlyZone:flyZone subFlyZone:subFlyZone]] = flyZone;
-            }
+        } else if (subFlyZone.shape == DJISubFlyZoneShapeCylinder) {
+            [self.overlayProvider addOverlayForCylinderSubFlyZone:subFlyZone
+                                                    withinFlyZone:flyZone];
+        } else if (subFlyZone.shape == DJISubFlyZoneShapePolygon) {
+            [self.overlayProvider addOverlayForPolygonSubFlyZone:subFlyZone
+                                                   withinFlyZone:flyZone];
         }
-    }
+    }];
     [self.annotationProvider endLockedFlyZoneUpdates];
     [self.overlayProvider endLockedFlyZoneUpdates];
-    
-    self.flyZones = [flyZones mutableCopy];
-    
-    [self updateMapView];
 }
 
-- (void)flyZoneDataProvider:(nonnull DUXBetaFlyZoneDataProvider *)flyZoneDataProvider didUpdateUnlockedFlyZones:(nonnull NSDictionary <NSString *, DJIFlyZoneInformation *> *)flyZones {
+- (void)reloadUnlockedFlyZones {
     [self.annotationProvider beginUnlockedFlyZoneUpdates];
     [self.overlayProvider beginUnlockedFlyZoneUpdates];
-    for (DJIFlyZoneInformation *flyZone in flyZones.allValues) {
-        if (flyZone.type == DJIFlyZoneTypeCircle) {
+    [self.unlockedFlyZoneIndex enumerateObjectsIntersectingMapRect:self.flyZoneCullingRect usingBlock:^(DUXBetaFlyZoneSpatialIndexEntry *entry) {
+        DJIFlyZoneInformation *flyZone = entry.flyZone;
+        DJISubFlyZoneInformation *subFlyZone = entry.subFlyZone;
+        if (subFlyZone == nil) {
             [self.overlayProvider addUnlockedOverlayForFlyZone:flyZone];
             if (self.tapToUnlockEnabled && (flyZone.category == DJIFlyZoneCategoryAuthorization || flyZone.category == DJIFlyZoneCategoryEnhancedWarning)) {
                 [self.annotationProvider addAnnotationForUnlockedFlyZone:flyZone];
             }
-        } else if (flyZone.type == DJIFlyZoneTypePoly) {
+        } else if (subFlyZone.shape == DJISubFlyZoneShapeCylinder) {
+            [self.overlayProvider addOverlayForCylinderSubFlyZone:subFlyZone
+                                                    withinFlyZone:flyZone];
+            [self.annotationProvider addAnnotationForSubFlyZone:subFlyZone
+                                                  withinFlyZone:flyZone];
+        } else if (subFlyZone.shape == DJISubFlyZoneShapePolygon) {
+            [self.overlayProvider addOverlayForPolygonSubFlyZone:subFlyZone
+                                                   withinFlyZone:flyZone];
+        }
+    }];
+    [self.annotationProvider endUnlockedFlyZoneUpdates];
+    [self.overlayProvider endUnlockedFlyZoneUpdates];
+}
+
+/*********************************************************************************/
+#pragma mark - DUXBetaFlyZoneDataProviderDelegate
+/*********************************************************************************/
+
+- (void)flyZoneDataProvider:(nonnull DUXBetaFlyZoneDataProvider *)flyZoneDataProvider didUpdateFlyZones:(nonnull NSDictionary <NSString *, DJIFlyZoneInformation *> *)flyZones {
+    self.subFlyZonesParentFlyZones = [NSMutableDictionary dictionary];
+    for (DJIFlyZoneInformation *flyZone in flyZones.allValues) {
+        if (flyZone.type == DJIFlyZoneTypePoly) {
             for (DJISubFlyZoneInformation *subFlyZone in flyZone.subFlyZones) {
-                if (subFlyZone.shape == DJISubFlyZoneShapeCylinder) {
-                    [self.overlayProvider addOverlayForCylinderSubFlyZone:subFlyZone
-                                                            withinFlyZone:flyZone];
-                    [self.annotationProvider addAnnotationForSubFlyZone:subFlyZone
-                                                          withinFlyZone:flyZone];
-                } else if (subFlyZone.shape == DJISubFlyZoneShapePolygon) {
-                    [self.overlayProvider addOverlayForPolygonSubFlyZone:subFlyZone
-                                                           withinFlyZone:flyZone];
-                }
+                self.subFlyZonesParentFlyZones[[NSString duxbeta_subFlyZoneProviderAccessKeyWithFlyZone:flyZone subFlyZone:subFlyZone]] = flyZone;
             }
         }
     }
-    [self.annotationProvider endUnlockedFlyZoneUpdates];
-    [self.overlayProvider endUnlockedFlyZoneUpdates];
+    self.lockedFlyZoneIndex = [DUXBetaFlyZoneSpatialIndex indexWithFlyZones:flyZones.allValues];
+    [self reloadLockedFlyZones];
+    
+    self.flyZones = [flyZones mutableCopy];
+    
+    [self updateMapView];
+}
+
+- (void)flyZoneDataProvider:(nonnull DUXBetaFlyZoneDataProvider *)flyZoneDataProvider didUpdateUnlockedFlyZones:(nonnull NSDictionary <NSString *, DJIFlyZoneInformation *> *)flyZones {
+    self.unlockedFlyZoneIndex = [DUXBetaFlyZoneSpatialIndex indexWithFlyZones:flyZones.allValues];
+    [self reloadUnlockedFlyZones];
     
     self.unlockedFlyZones = [flyZones mutableCopy];
     
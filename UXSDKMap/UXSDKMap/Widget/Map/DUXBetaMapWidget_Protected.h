@@ -50,6 +50,9 @@
 @property (nonatomic, strong) NSMutableDictionary <NSString *, DJIFlyZoneInformation *> *subFlyZonesParentFlyZones;
 
 - (void)presentAlertController:(UIAlertController *)alertController;
+
+// Reloads the fly zones near the visible map rect once it has moved or zoomed far enough
+- (void)updateFlyZoneCulling;
 - (void)presentConfirmationAlertForSelfUnlockingWithFlyZoneIDs:(NSArray <NSNumber *> *)flyZoneIDs;
 - (void)presentConfirmationAlertForSelfUnlockRequestOnUnlockedFlyZone:(NSString *)flyZoneSubtitle;
 - (void)presentConfirmationAlertForSendingCustomUnlockZoneToAircraft;
@@ -29,6 +29,7 @@
 @class DUXBetaMapWidget;
 @class DUXBetaMapViewRenderer;
 @class DUXBetaMapPolylineOverlay;
+@class DUXBetaMapFlightPath;
 @class DUXBetaMapHomeAnnotation;
 @class DUXBetaMapAircraftAnnotation;
 
@@ -62,8 +63,8 @@
 @property (nonatomic, assign) CGFloat yaw; // In radians
 
 // Flight Path Data
-@property NSMutableArray<DUXBetaMapPolylineOverlay *> *flightPathOverlays;
-@property NSMutableArray<CLLocation *> *flightPathCoordinates;
+@property (nonatomic, strong, readonly) DUXBetaMapFlightPath *flightPath;
+@property (nonatomic, readonly) NSArray<DUXBetaMapPolylineOverlay *> *flightPathOverlays;
 // Polyline Overlays
 @property (nonatomic, strong) DUXBetaMapPolylineOverlay *directionToHomePolyline;
 // Annotations on map
@@ -29,10 +29,14 @@
 #import "DUXBetaMapWidget.h"
 #import "DUXBetaMapViewRenderer.h"
 #import "DUXBetaMapPolylineOverlay.h"
+#import "DUXBetaMapFlightPath.h"
 #import "DUXBetaMapHomeAnnotation.h"
 #import "DUXBetaMapAircraftAnnotation.h"
 #import "DUXBetaMapAircraftAnnotationView.h"
 
+static const double DUXBetaMapFlightPathMinimumTolerance = 1.0;
+static const double DUXBetaMapFlightPathMaximumTolerance = 10.0;
+
 @implementation DUXBetaMapState
 
 @end
@@ -40,6 +44,7 @@
 @interface DUXBetaMapView ()<UIGestureRecognizerDelegate>
 
 @property CLLocationCoordinate2D prevCoord;
+@property (nonatomic, strong, readwrite) DUXBetaMapFlightPath *flightPath;
 
 @end
 
@@ -49,8 +54,7 @@
     self = [super initWithFrame:frame];
     if (self) {
         // Setup Properties
-        _flightPathOverlays = [[NSMutableArray alloc] init];
-        _flightPathCoordinates = [[NSMutableArray alloc] init];
+        _flightPath = [[DUXBetaMapFlightPath alloc] init];
         _prevCoord = kCLLocationCoordinate2DInvalid;
         // Setup Map
         [self setupMapProperties];
@@ -170,18 +174,9 @@
     double distanceBetweenCurrentAndPrevAircraftCoord = [self distanceBetweenCoordinates:self.prevCoord coordTwo:mapState.aircraftLocationCoordinate];
     BOOL isCurrentAircraftCoordValid = (mapState.aircraftLocationCoordinate.latitude != 0.0 || mapState.aircraftLocationCoordinate.longitude != 0.0);
     if (isCurrentAircraftCoordValid && distanceBetweenCurrentAndPrevAircraftCoord > 1.5) {
-        // Remove Line
-        [self removeOverlays:self.flightPathOverlays];
-        [self.flightPathOverlays removeAllObjects];
         self.prevCoord = mapState.aircraftLocationCoordinate;
-        // Add new coordinate to list of coordinates used to create new line
-        CLLocation *currentAircraftLocation = [[CLLocation alloc] initWithLatitude:mapState.aircraftLocationCoordinate.latitude longitude:mapState.aircraftLocationCoordinate.longitude];
-        [self.flightPathCoordinates addObject: currentAircraftLocation];
-        // Extract locations from flightPathCoordinates
-        CLLocationCoordinate2D flightPathCoords[self.flightPathCoordinates.count];
-        [self extractCoordinates:self.flightPathCoordinates to:flightPathCoords];
-        // Update flight path
-        [self updateFlightPath:flightPathCoords showOnMap:mapState.showFlightPath];
+        // Only the tail chunk of the flight path is rebuilt
+        [self updateFlightPathWithCoordinate:mapState.aircraftLocationCoordinate showOnMap:mapState.showFlightPath];
     }
     
     // Update Aircraft Yaw
@@ -195,15 +190,30 @@
     }
 }
 
-- (void)updateFlightPath:(CLLocationCoordinate2D[])coordinates showOnMap:(BOOL)show {
-    DUXBetaMapPolylineOverlay *flightPathPolyline = [DUXBetaMapPolylineOverlay polylineWithCoordinates:coordinates count:self.flightPathCoordinates.count];
-    flightPathPolyline.polylineType = DUXBetaMapPolylineFlightPath;
-    [self.flightPathOverlays addObject:flightPathPolyline];
+- (void)updateFlightPathWithCoordinate:(CLLocationCoordinate2D)coordinate showOnMap:(BOOL)show {
+    self.flightPath.tolerance = [self flightPathToleranceForCurrentZoom];
+    DUXBetaMapFlightPathChange *change = [self.flightPath appendCoordinate:coordinate];
     if (show) {
-        [self addOverlay:flightPathPolyline];
+        [self removeOverlays:change.removedOverlays];
+        [self addOverlays:change.addedOverlays];
     }
 }
 
+// Half a screen point at the current zoom, kept between 1 m and 10 m so zooming back in still shows a faithful path.
+- (double)flightPathToleranceForCurrentZoom {
+    if (self.bounds.size.width <= 0) {
+        return DUXBetaMapFlightPathMinimumTolerance;
+    }
+    MKMapRect visibleRect = self.visibleMapRect;
+    double metersPerMapPoint = MKMetersPerMapPointAtLatitude(self.centerCoordinate.latitude);
+    double metersPerScreenPoint = visibleRect.size.width * metersPerMapPoint / self.bounds.size.width;
+    return MIN(MAX(metersPerScreenPoint / 2, DUXBetaMapFlightPathMinimumTolerance), DUXBetaMapFlightPathMaximumTolerance);
+}
+
+- (NSArray<DUXBetaMapPolylineOverlay *> *)flightPathOverlays {
+    return self.flightPath.overlays;
+}
+
 - (void)updateDirectionToHomePathWithHomeCoordinate:(CLLocationCoordinate2D)homeCoordinate
                          aircraftLocationCoordinate:(CLLocationCoordinate2D)aircraftCoordinate
                                     shouldShowOnMap:(BOOL)show {
@@ -240,15 +250,6 @@
 
 #pragma mark - Helper Methods
 
-- (void)extractCoordinates:(NSMutableArray<CLLocation *> *)locations to:(CLLocationCoordinate2D *)coordinate {
-    for (int i = 0; i < locations.count; i++) {
-        CLLocation *location = [locations objectAtIndex:i];
-        if (location.coordinate.latitude != 0.0 || location.coordinate.longitude != 0.0) {
-            coordinate[i] = location.coordinate;
-        }
-    }
-}
-
 - (double)distanceBetweenCoordinates:(CLLocationCoordinate2D)coordOne coordTwo:(CLLocationCoordinate2D)coordTwo {
     CLLocation *locationOne = [[CLLocation alloc] initWithLatitude:coordOne.latitude longitude:coordOne.longitude];
     CLLocation *locationTwo = [[CLLocation alloc] initWithLatitude:coordTwo.latitude longitude:coordTwo.longitude];
@@ -436,6 +436,10 @@ static NSString * const DUXBetaMapViewRendererGeoZoneAnnotationReuseIdentifier =
     }
 }
 
+- (void)mapView:(MKMapView *)mapView regionDidChangeAnimated:(BOOL)animated {
+    [self.mapView.mapWidget updateFlyZoneCulling];
+}
+
 #pragma mark - Rendering Helper Methods
 
 - (void)configUserLocationView:(BOOL)selected {
@@ -0,0 +1,114 @@
+//
+//  DUXBetaMapFlightPath.h
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+#import <MapKit/MapKit.h>
+
+@class DUXBetaMapPolylineOverlay;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The overlays to swap on the map after an append.
+ */
+@interface DUXBetaMapFlightPathChange : NSObject
+
+@property (nonatomic, strong, readonly) NSArray<DUXBetaMapPolylineOverlay *> *removedOverlays;
+@property (nonatomic, strong, readonly) NSArray<DUXBetaMapPolylineOverlay *> *addedOverlays;
+
+@end
+
+/**
+ * Append-only flight path. Coordinates are kept in one contiguous buffer and drawn as a run of polyline chunks of at
+ * most chunkSize points. Full chunks are sealed and never rebuilt, an append only rebuilds the tail chunk. Consecutive
+ * chunks share their boundary point so the line has no gaps.
+ *
+ * A chunk is simplified with Douglas-Peucker when it is sealed, so no retained segment is further than the tolerance
+ * from the points it replaces. When the path grows past its memory limit, the sealed chunks with the finest tolerance,
+ * oldest first, are simplified again at twice their tolerance, up to maximumTolerance, until it fits. Once every chunk
+ * reached the maximum tolerance the path stays over the limit rather than lose its shape.
+ */
+@interface DUXBetaMapFlightPath : NSObject
+
+- (instancetype)initWithChunkSize:(NSUInteger)chunkSize NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, assign, readonly) NSUInteger chunkSize;
+
+/**
+ * Retained coordinates, fewer than appended once chunks are simplified.
+ */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ * Coordinates appended since the path was created or cleared.
+ */
+@property (nonatomic, assign, readonly) NSUInteger appendedCount;
+
+/**
+ * Error bound in meters used to simplify the next sealed chunk, 1 m by default. 0 keeps every point.
+ */
+@property (nonatomic, assign) double tolerance;
+
+/**
+ * Memory the coordinates may take before older chunks are simplified further, 0 for no limit. 2 MB by default.
+ */
+@property (nonatomic, assign) NSUInteger memoryLimit;
+
+/**
+ * The largest tolerance in meters chunks are simplified again with to meet the memory limit, 64 m by default. A
+ * chunk's error stays under twice this plus the tolerance it was sealed with.
+ */
+@property (nonatomic, assign) double maximumTolerance;
+
+/**
+ * The largest distance in meters any sealed chunk may be from the appended coordinates it replaces.
+ */
+@property (nonatomic, assign, readonly) double maximumError;
+
+/**
+ * The sealed chunks in order followed by the tail chunk when it has a line to draw.
+ */
+@property (nonatomic, strong, readonly) NSArray<DUXBetaMapPolylineOverlay *> *overlays;
+
+/**
+ * Bytes held by the coordinate buffer and the chunk polylines.
+ */
+@property (nonatomic, assign, readonly) NSUInteger memoryFootprint;
+
+- (CLLocationCoordinate2D)coordinateAtIndex:(NSUInteger)index;
+- (nullable CLLocation *)lastLocation;
+
+- (DUXBetaMapFlightPathChange *)appendCoordinate:(CLLocationCoordinate2D)coordinate;
+
+/**
+ * Removes every coordinate and returns the overlays to take off the map.
+ */
+- (NSArray<DUXBetaMapPolylineOverlay *> *)removeAllCoordinates;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,339 @@
+//
+//  DUXBetaMapFlightPath.m
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaMapFlightPath.h"
+#import "DUXBetaMapPolylineOverlay.h"
+
+static const NSUInteger kDUXBetaMapFlightPathDefaultChunkSize = 256;
+static const NSUInteger kDUXBetaMapFlightPathInitialCapacity = 1024;
+static const NSUInteger kDUXBetaMapFlightPathDefaultMemoryLimit = 2 * 1024 * 1024;
+static const double kDUXBetaMapFlightPathDefaultTolerance = 1.0;
+static const double kDUXBetaMapFlightPathDefaultMaximumTolerance = 64.0;
+static const double kDUXBetaMapFlightPathEarthRadius = 6371008.8;
+
+// Each retained point is held once in the buffer and once in its chunk polyline.
+static const NSUInteger kDUXBetaMapFlightPathBytesPerPoint = sizeof(CLLocationCoordinate2D) + sizeof(MKMapPoint);
+
+typedef struct {
+    double x;
+    double y;
+} DUXBetaMapFlightPathPoint;
+
+static double DUXBetaMapFlightPathSegmentDistance(DUXBetaMapFlightPathPoint p, DUXBetaMapFlightPathPoint a, DUXBetaMapFlightPathPoint b) {
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double lengthSquared = dx * dx + dy * dy;
+    double t = 0;
+    if (lengthSquared > 0) {
+        t = ((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared;
+        t = MAX(0.0, MIN(1.0, t));
+    }
+    double ex = p.x - (a.x + t * dx);
+    double ey = p.y - (a.y + t * dy);
+    return sqrt(ex * ex + ey * ey);
+}
+
+/**
+ * Douglas-Peucker over count coordinates in place, measured in meters on a local equirectangular projection.
+ * Distances are to the segment, not the line through it, so the bound also holds when the path doubles back.
+ * Returns the number of coordinates kept, which are moved to the front in order.
+ */
+static NSUInteger DUXBetaMapFlightPathSimplify(CLLocationCoordinate2D *coordinates, NSUInteger count, double tolerance) {
+    if (count < 3 || tolerance <= 0) {
+        return count;
+    }
+    
+    double cosLatitude = cos(coordinates[0].latitude * M_PI / 180);
+    DUXBetaMapFlightPathPoint *points = malloc(count * sizeof(DUXBetaMapFlightPathPoint));
+    bool *keep = calloc(count, sizeof(bool));
+    NSUInteger *stack = malloc(2 * count * sizeof(NSUInteger));
+    for (NSUInteger i = 0; i < count; i++) {
+        points[i].x = (coordinates[i].longitude - coordinates[0].longitude) * M_PI / 180 * cosLatitude * kDUXBetaMapFlightPathEarthRadius;
+        points[i].y = (coordinates[i].latitude - coordinates[0].latitude) * M_PI / 180 * kDUXBetaMapFlightPathEarthRadius;
+    }
+    
+    keep[0] = true;
+    keep[count - 1] = true;
+    NSUInteger depth = 0;
+    stack[depth++] = 0;
+    stack[depth++] = count - 1;
+    while (depth > 0) {
+        NSUInteger last = stack[--depth];
+        NSUInteger first = stack[--depth];
+        double farthest = 0;
+        NSUInteger farthestIndex = first;
+        for (NSUInteger i = first + 1; i < last; i++) {
+            double distance = DUXBetaMapFlightPathSegmentDistance(points[i], points[first], points[last]);
+            if (distance > farthest) {
+                farthest = distance;
+                farthestIndex = i;
+            }
+        }
+        if (farthest > tolerance) {
+            keep[farthestIndex] = true;
+            stack[depth++] = first;
+            stack[depth++] = farthestIndex;
+            stack[depth++] = farthestIndex;
+            stack[depth++] = last;
+        }
+    }
+    
+    NSUInteger kept = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        if (keep[i]) {
+            coordinates[kept++] = coordinates[i];
+        }
+    }
+    free(points);
+    free(keep);
+    free(stack);
+    return kept;
+}
+
+@interface DUXBetaMapFlightPathChange ()
+
+@property (nonatomic, strong, readwrite) NSArray<DUXBetaMapPolylineOverlay *> *removedOverlays;
+@property (nonatomic, strong, readwrite) NSArray<DUXBetaMapPolylineOverlay *> *addedOverlays;
+
+@end
+
+@implementation DUXBetaMapFlightPathChange
+
+@end
+
+/**
+ * A sealed chunk, the coordinates from start to start + count - 1 in the buffer.
+ */
+@interface DUXBetaMapFlightPathChunk : NSObject
+
+@property (nonatomic, assign) NSUInteger start;
+@property (nonatomic, assign) NSUInteger count;
+@property (nonatomic, assign) double tolerance;
+// Sum of every tolerance the chunk was simplified with, the bound on its distance from the appended coordinates.
+@property (nonatomic, assign) double errorBound;
+// Set once the chunk is down to its end points or was simplified at the maximum tolerance, it is not simplified again.
+@property (nonatomic, assign) BOOL exhausted;
+@property (nonatomic, strong) DUXBetaMapPolylineOverlay *overlay;
+
+@end
+
+@implementation DUXBetaMapFlightPathChunk
+
+@end
+
+@interface DUXBetaMapFlightPath ()
+{
+    CLLocationCoordinate2D *_coordinates;
+    NSUInteger _capacity;
+}
+
+@property (nonatomic, assign, readwrite) NSUInteger count;
+@property (nonatomic, assign, readwrite) NSUInteger appendedCount;
+@property (nonatomic, strong) NSMutableArray<DUXBetaMapFlightPathChunk *> *chunks;
+@property (nonatomic, strong) DUXBetaMapPolylineOverlay *tailOverlay;
+// Index of the first coordinate of the tail chunk, which is the last coordinate of the previous chunk.
+@property (nonatomic, assign) NSUInteger tailStart;
+
+@end
+
+@implementation DUXBetaMapFlightPath
+
+- (instancetype)init {
+    return [self initWithChunkSize:kDUXBetaMapFlightPathDefaultChunkSize];
+}
+
+- (instancetype)initWithChunkSize:(NSUInteger)chunkSize {
+    self = [super init];
+    if (self) {
+        _chunkSize = MAX(chunkSize, (NSUInteger)2);
+        _chunks = [[NSMutableArray alloc] init];
+        _tolerance = kDUXBetaMapFlightPathDefaultTolerance;
+        _maximumTolerance = kDUXBetaMapFlightPathDefaultMaximumTolerance;
+        _memoryLimit = kDUXBetaMapFlightPathDefaultMemoryLimit;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_coordinates);
+}
+
+- (NSArray<DUXBetaMapPolylineOverlay *> *)overlays {
+    NSMutableArray<DUXBetaMapPolylineOverlay *> *overlays = [[NSMutableArray alloc] initWithCapacity:self.chunks.count + 1];
+    for (DUXBetaMapFlightPathChunk *chunk in self.chunks) {
+        [overlays addObject:chunk.overlay];
+    }
+    if (self.tailOverlay != nil) {
+        [overlays addObject:self.tailOverlay];
+    }
+    return overlays;
+}
+
+- (NSUInteger)memoryFootprint {
+    // Chunk boundary points are held by both polylines they join.
+    return _capacity * sizeof(CLLocationCoordinate2D) + (self.count + self.chunks.count) * sizeof(MKMapPoint);
+}
+
+- (double)maximumError {
+    double maximumError = 0;
+    for (DUXBetaMapFlightPathChunk *chunk in self.chunks) {
+        maximumError = MAX(maximumError, chunk.errorBound);
+    }
+    return maximumError;
+}
+
+- (CLLocationCoordinate2D)coordinateAtIndex:(NSUInteger)index {
+    NSAssert(index < self.count, @"Flight path index out of bounds.");
+    return _coordinates[index];
+}
+
+- (nullable CLLocation *)lastLocation {
+    if (self.count == 0) {
+        return nil;
+    }
+    CLLocationCoordinate2D coordinate = _coordinates[self.count - 1];
+    return [[CLLocation alloc] initWithLatitude:coordinate.latitude longitude:coordinate.longitude];
+}
+
+- (DUXBetaMapFlightPathChange *)appendCoordinate:(CLLocationCoordinate2D)coordinate {
+    if (self.count == _capacity) {
+        _capacity = MAX(_capacity * 2, kDUXBetaMapFlightPathInitialCapacity);
+        _coordinates = reallocf(_coordinates, _capacity * sizeof(CLLocationCoordinate2D));
+        NSAssert(_coordinates != NULL, @"Could not grow the flight path buffer.");
+    }
+    _coordinates[self.count] = coordinate;
+    self.count++;
+    self.appendedCount++;
+    
+    NSMutableArray<DUXBetaMapPolylineOverlay *> *removed = [[NSMutableArray alloc] init];
+    NSMutableArray<DUXBetaMapPolylineOverlay *> *added = [[NSMutableArray alloc] init];
+    if (self.tailOverlay != nil) {
+        [removed addObject:self.tailOverlay];
+        self.tailOverlay = nil;
+    }
+    
+    NSUInteger tailCount = self.count - self.tailStart;
+    if (tailCount >= self.chunkSize) {
+        [added addObject:[self sealTail]];
+        [self enforceMemoryLimitRemoving:removed adding:added];
+    } else if (tailCount >= 2) {
+        self.tailOverlay = [self polylineFrom:self.tailStart count:tailCount];
+        [added addObject:self.tailOverlay];
+    }
+    
+    DUXBetaMapFlightPathChange *change = [[DUXBetaMapFlightPathChange alloc] init];
+    change.removedOverlays = removed;
+    change.addedOverlays = added;
+    return change;
+}
+
+- (NSArray<DUXBetaMapPolylineOverlay *> *)removeAllCoordinates {
+    NSArray<DUXBetaMapPolylineOverlay *> *overlays = self.overlays;
+    [self.chunks removeAllObjects];
+    self.tailOverlay = nil;
+    self.tailStart = 0;
+    self.count = 0;
+    self.appendedCount = 0;
+    return overlays;
+}
+
+#pragma mark - Chunks
+
+- (DUXBetaMapPolylineOverlay *)polylineFrom:(NSUInteger)start count:(NSUInteger)count {
+    DUXBetaMapPolylineOverlay *polyline = [DUXBetaMapPolylineOverlay polylineWithCoordinates:_coordinates + start count:count];
+    polyline.polylineType = DUXBetaMapPolylineFlightPath;
+    return polyline;
+}
+
+- (DUXBetaMapPolylineOverlay *)sealTail {
+    DUXBetaMapFlightPathChunk *chunk = [[DUXBetaMapFlightPathChunk alloc] init];
+    chunk.start = self.tailStart;
+    chunk.count = self.count - self.tailStart;
+    [self.chunks addObject:chunk];
+    [self simplifyChunk:chunk tolerance:self.tolerance];
+    self.tailStart = self.count - 1;
+    return chunk.overlay;
+}
+
+/**
+ * Simplifies the chunk, compacts the buffer behind it and rebuilds its polyline. Later chunks keep their polylines,
+ * only their positions in the buffer move.
+ */
+- (void)simplifyChunk:(DUXBetaMapFlightPathChunk *)chunk tolerance:(double)tolerance {
+    NSUInteger kept = DUXBetaMapFlightPathSimplify(_coordinates + chunk.start, chunk.count, tolerance);
+    NSUInteger dropped = chunk.count - kept;
+    if (dropped > 0) {
+        NSUInteger oldEnd = chunk.start + chunk.count;
+        memmove(_coordinates + chunk.start + kept, _coordinates + oldEnd, (self.count - oldEnd) * sizeof(CLLocationCoordinate2D));
+        self.count -= dropped;
+        NSUInteger index = [self.chunks indexOfObjectIdenticalTo:chunk];
+        for (NSUInteger i = index + 1; i < self.chunks.count; i++) {
+            self.chunks[i].start -= dropped;
+        }
+        if (self.tailStart >= oldEnd - 1) {
+            self.tailStart -= dropped;
+        }
+        chunk.count = kept;
+    }
+    if (dropped > 0) {
+        chunk.errorBound += tolerance;
+    }
+    chunk.exhausted = chunk.count <= 2 || tolerance >= self.maximumTolerance;
+    chunk.tolerance = tolerance;
+    chunk.overlay = [self polylineFrom:chunk.start count:chunk.count];
+}
+
+- (void)enforceMemoryLimitRemoving:(NSMutableArray<DUXBetaMapPolylineOverlay *> *)removed
+                            adding:(NSMutableArray<DUXBetaMapPolylineOverlay *> *)added {
+    if (self.memoryLimit == 0) {
+        return;
+    }
+    NSUInteger pointLimit = self.memoryLimit / kDUXBetaMapFlightPathBytesPerPoint;
+    while (self.count > pointLimit) {
+        DUXBetaMapFlightPathChunk *finest = nil;
+        for (DUXBetaMapFlightPathChunk *chunk in self.chunks) {
+            if (!chunk.exhausted && (finest == nil || chunk.tolerance < finest.tolerance)) {
+                finest = chunk;
+            }
+        }
+        if (finest == nil) {
+            return;
+        }
+        
+        DUXBetaMapPolylineOverlay *previous = finest.overlay;
+        double tolerance = MIN(MAX(finest.tolerance * 2, kDUXBetaMapFlightPathDefaultTolerance), self.maximumTolerance);
+        [self simplifyChunk:finest tolerance:MAX(tolerance, finest.tolerance)];
+        if ([added containsObject:previous]) {
+            [added removeObject:previous];
+        } else {
+            [removed addObject:previous];
+        }
+        [added addObject:finest.overlay];
+    }
+}
+
+@end
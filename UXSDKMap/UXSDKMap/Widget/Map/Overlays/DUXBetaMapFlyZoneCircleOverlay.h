@@ -27,8 +27,9 @@
 
 #import <MapKit/MapKit.h>
 #import <DJISDK/DJISDK.h>
+#import "DUXBetaMapFlyZoneDiffer.h"
 
-@interface DUXBetaMapFlyZoneCircleOverlay : MKCircle
+@interface DUXBetaMapFlyZoneCircleOverlay : MKCircle <DUXBetaMapFlyZoneDiffable>
 
 @property (nonatomic, assign) DJIFlyZoneType flyZoneType;
 @property (nonatomic, assign) DJISubFlyZoneShape subFlyZoneShape;
@@ -29,4 +29,23 @@
 
 @implementation DUXBetaMapFlyZoneCircleOverlay
 
+- (BOOL)isEquivalentToFlyZoneObject:(id)object {
+    if (![object isMemberOfClass:[self class]]) {
+        return NO;
+    }
+    DUXBetaMapFlyZoneCircleOverlay *overlay = (DUXBetaMapFlyZoneCircleOverlay *)object;
+    return self.coordinate.latitude == overlay.coordinate.latitude &&
+        self.coordinate.longitude == overlay.coordinate.longitude &&
+        self.radius == overlay.radius &&
+        self.flyZoneType == overlay.flyZoneType &&
+        self.subFlyZoneShape == overlay.subFlyZoneShape &&
+        self.category == overlay.category &&
+        self.height == overlay.height &&
+        (self.noFlyZoneID == overlay.noFlyZoneID || [self.noFlyZoneID isEqualToNumber:overlay.noFlyZoneID]) &&
+        self.isUnlocked == overlay.isUnlocked &&
+        self.isCustomUnlockZone == overlay.isCustomUnlockZone &&
+        self.isCustomUnlockZoneSentToAircraft == overlay.isCustomUnlockZoneSentToAircraft &&
+        self.isCustomUnlockZoneEnabled == overlay.isCustomUnlockZoneEnabled;
+}
+
 @end
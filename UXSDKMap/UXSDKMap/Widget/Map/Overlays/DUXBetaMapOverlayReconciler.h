@@ -0,0 +1,89 @@
+//
+//  DUXBetaMapOverlayReconciler.h
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+#import <MapKit/MapKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Keeps a set of keyed overlays on a map view in step with a desired set by applying only the
+ * differences. Overlays that were not added through the reconciler, such as the flight path, are
+ * never touched.
+ *
+ * Desired sets may be handed over from any thread. They are coalesced and applied on the main thread
+ * at most once per display frame; only the last set handed over before a frame is applied. An overlay
+ * whose key is already on the map is only replaced when it is not equivalent, as decided by
+ * DUXBetaMapFlyZoneDiffer.
+ */
+@interface DUXBetaMapOverlayReconciler : NSObject
+
+- (instancetype)initWithMapView:(MKMapView *)mapView NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, weak, readonly, nullable) MKMapView *mapView;
+
+/**
+ * The level inserted overlays are added at. Defaults to MKOverlayLevelAboveRoads.
+ */
+@property (nonatomic, assign) MKOverlayLevel level;
+
+/**
+ * The overlays currently on the map by key. Main thread only.
+ */
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, id<MKOverlay>> *appliedOverlays;
+
+/**
+ * Number of overlays added to or removed from the map since creation.
+ */
+@property (nonatomic, assign, readonly) NSUInteger overlaysTouched;
+
+/**
+ * Number of passes that changed the map, and the main thread time they took.
+ */
+@property (nonatomic, assign, readonly) NSUInteger passes;
+@property (nonatomic, assign, readonly) uint64_t mainThreadNanoseconds;
+
+/**
+ * Replaces the desired overlay set and schedules a pass for the next frame.
+ */
+- (void)setDesiredOverlays:(NSDictionary<NSString *, id<MKOverlay>> *)overlays;
+
+/**
+ * Applies any pending desired set immediately. Main thread only.
+ */
+- (void)applyPendingChanges;
+
+/**
+ * Whether the map shows exactly the last desired set: nothing is pending, the applied keys are the
+ * desired keys and every applied overlay is on the map. Main thread only.
+ */
+- (BOOL)mapViewMatchesDesiredOverlays;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,197 @@
+//
+//  DUXBetaMapOverlayReconciler.m
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaMapOverlayReconciler.h"
+#import "DUXBetaMapFlyZoneDiffer.h"
+#import <QuartzCore/QuartzCore.h>
+
+/**
+ * CADisplayLink retains its target, this breaks the cycle with the reconciler.
+ */
+@interface DUXBetaMapOverlayReconcilerFrameTarget : NSObject
+
+@property (nonatomic, weak) DUXBetaMapOverlayReconciler *reconciler;
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink;
+
+@end
+
+@interface DUXBetaMapOverlayReconciler ()
+
+@property (nonatomic, weak, readwrite) MKMapView *mapView;
+@property (nonatomic, strong) DUXBetaMapFlyZoneDiffer<id<MKOverlay>> *differ;
+@property (nonatomic, copy) NSDictionary<NSString *, id<MKOverlay>> *pendingOverlays;
+@property (nonatomic, copy) NSDictionary<NSString *, id<MKOverlay>> *lastDesiredOverlays;
+@property (nonatomic, assign) BOOL hasPendingOverlays;
+@property (nonatomic, strong) CADisplayLink *displayLink;
+@property (nonatomic, assign, readwrite) NSUInteger overlaysTouched;
+@property (nonatomic, assign, readwrite) NSUInteger passes;
+@property (nonatomic, assign, readwrite) uint64_t mainThreadNanoseconds;
+
+@end
+
+@implementation DUXBetaMapOverlayReconcilerFrameTarget
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink {
+    DUXBetaMapOverlayReconciler *reconciler = self.reconciler;
+    if (reconciler == nil) {
+        [displayLink invalidate];
+        return;
+    }
+    [reconciler applyPendingChanges];
+}
+
+@end
+
+@implementation DUXBetaMapOverlayReconciler
+
+- (instancetype)initWithMapView:(MKMapView *)mapView {
+    self = [super init];
+    if (self) {
+        _mapView = mapView;
+        _level = MKOverlayLevelAboveRoads;
+        _differ = [[DUXBetaMapFlyZoneDiffer alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CADisplayLink *displayLink = _displayLink;
+    if (displayLink != nil) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [displayLink invalidate];
+        });
+    }
+}
+
+- (NSDictionary<NSString *, id<MKOverlay>> *)appliedOverlays {
+    return self.differ.currentObjects;
+}
+
+- (void)setDesiredOverlays:(NSDictionary<NSString *, id<MKOverlay>> *)overlays {
+    BOOL needsFrame;
+    @synchronized (self) {
+        needsFrame = !self.hasPendingOverlays;
+        self.pendingOverlays = overlays;
+        self.hasPendingOverlays = YES;
+    }
+    
+    // Only the first set since the last pass needs to wake the display link, later ones replace it.
+    if (needsFrame) {
+        if ([NSThread isMainThread]) {
+            [self scheduleFrame];
+        } else {
+            __weak typeof(self) weakSelf = self;
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [weakSelf scheduleFrame];
+            });
+        }
+    }
+}
+
+- (void)scheduleFrame {
+    if (self.displayLink == nil) {
+        DUXBetaMapOverlayReconcilerFrameTarget *target = [[DUXBetaMapOverlayReconcilerFrameTarget alloc] init];
+        target.reconciler = self;
+        self.displayLink = [CADisplayLink displayLinkWithTarget:target selector:@selector(displayLinkDidFire:)];
+        [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+    self.displayLink.paused = NO;
+}
+
+- (void)applyPendingChanges {
+    NSDictionary<NSString *, id<MKOverlay>> *desired;
+    @synchronized (self) {
+        if (!self.hasPendingOverlays) {
+            self.displayLink.paused = YES;
+            return;
+        }
+        desired = self.pendingOverlays;
+        self.pendingOverlays = nil;
+        self.hasPendingOverlays = NO;
+    }
+    self.displayLink.paused = YES;
+    self.lastDesiredOverlays = desired;
+    
+    MKMapView *mapView = self.mapView;
+    if (mapView == nil) {
+        return;
+    }
+    
+    uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    
+    // Overlays already on the map are kept when equivalent so their renderers survive
+    DUXBetaMapFlyZoneDiff<id<MKOverlay>> *diff = [self.differ applyObjects:desired];
+    if (diff.isEmpty) {
+        return;
+    }
+    
+    NSArray<id<MKOverlay>> *removedOverlays = diff.deletedObjects;
+    NSArray<id<MKOverlay>> *addedOverlays = diff.insertedObjects;
+    if (removedOverlays.count > 0) {
+        [mapView removeOverlays:removedOverlays];
+    }
+    if (addedOverlays.count > 0) {
+        [mapView addOverlays:addedOverlays level:self.level];
+    }
+    
+    self.overlaysTouched += removedOverlays.count + addedOverlays.count;
+    self.passes += 1;
+    self.mainThreadNanoseconds += clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+}
+
+- (BOOL)mapViewMatchesDesiredOverlays {
+    @synchronized (self) {
+        if (self.hasPendingOverlays) {
+            return NO;
+        }
+    }
+    
+    MKMapView *mapView = self.mapView;
+    if (mapView == nil) {
+        return NO;
+    }
+    
+    if (self.differ.currentObjects.count != self.lastDesiredOverlays.count) {
+        return NO;
+    }
+    for (NSString *key in self.lastDesiredOverlays) {
+        if (self.differ.currentObjects[key] == nil) {
+            return NO;
+        }
+    }
+    
+    NSSet *mapOverlays = [NSSet setWithArray:mapView.overlays];
+    for (id<MKOverlay> overlay in self.differ.currentObjects.objectEnumerator) {
+        if (![mapOverlays containsObject:overlay]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+@end
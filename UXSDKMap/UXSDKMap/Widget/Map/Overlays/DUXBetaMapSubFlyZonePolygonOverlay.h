@@ -27,8 +27,9 @@
 
 #import <MapKit/MapKit.h>
 #import <DJISDK/DJISDK.h>
+#import "DUXBetaMapFlyZoneDiffer.h"
 
-@interface DUXBetaMapSubFlyZonePolygonOverlay : MKPolygon
+@interface DUXBetaMapSubFlyZonePolygonOverlay : MKPolygon <DUXBetaMapFlyZoneDiffable>
 
 @property long maxFlightHeight;
 @property (nonatomic, assign) DJIFlyZoneCategory category;
@@ -29,4 +29,17 @@
 
 @implementation DUXBetaMapSubFlyZonePolygonOverlay
 
+- (BOOL)isEquivalentToFlyZoneObject:(id)object {
+    if (![object isMemberOfClass:[self class]]) {
+        return NO;
+    }
+    DUXBetaMapSubFlyZonePolygonOverlay *overlay = (DUXBetaMapSubFlyZonePolygonOverlay *)object;
+    if (self.maxFlightHeight != overlay.maxFlightHeight ||
+        self.category != overlay.category ||
+        self.pointCount != overlay.pointCount) {
+        return NO;
+    }
+    return memcmp(self.points, overlay.points, self.pointCount * sizeof(MKMapPoint)) == 0;
+}
+
 @end
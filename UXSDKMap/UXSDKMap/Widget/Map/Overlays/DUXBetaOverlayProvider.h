@@ -28,6 +28,7 @@
 #import <Foundation/Foundation.h>
 #import <MapKit/MapKit.h>
 #import <DJISDK/DJISDK.h>
+#import "DUXBetaMapFlyZoneDiffer.h"
 
 @class DUXBetaMapWidget;
 @class DUXBetaMapFlyZoneCircleOverlay;
@@ -35,10 +36,16 @@
 
 @interface DUXBetaOverlayProvider : NSObject
 
+// Inserted and deleted by the last commit
 @property (nonatomic, strong, readonly) NSArray <id <MKOverlay>> *addedOverlays;
 @property (nonatomic, strong, readonly) NSArray <id <MKOverlay>> *removedOverlays;
 
+// Overlays as of the last commit
 @property (nonatomic, strong, readonly) NSArray <id <MKOverlay>> *allOverlays;
+@property (nonatomic, strong, readonly) NSDictionary <NSString *, id <MKOverlay>> *committedOverlays;
+
+// The overlays that should be on the map given the updates so far, keyed by fly zone identifier
+@property (nonatomic, strong, readonly) NSDictionary <NSString *, id <MKOverlay>> *desiredOverlays;
 
 @property (nonatomic, weak) DUXBetaMapWidget *mapWidget;
 
@@ -51,6 +58,9 @@
 - (void)beginCustomUnlockedFlyZoneUpdates;
 - (void)endCustomUnlockedFlyZoneUpdates;
 
+// Diffs the desired overlays against the last commit and makes them current
+- (DUXBetaMapFlyZoneDiff<id<MKOverlay>> *)commitChanges;
+
 - (void)addLockedOverlayForFlyZone:(DJIFlyZoneInformation *)flyZone;
 - (void)addUnlockedOverlayForFlyZone:(DJIFlyZoneInformation *)flyZone;
 
@@ -35,19 +35,13 @@
 
 @interface DUXBetaOverlayProvider ()
 
-@property (nonatomic, strong) NSMutableDictionary *mutableAddedLockedOverlays;
-@property (nonatomic, strong) NSMutableDictionary *mutableRemovedLockedOverlays;
+// Overlays added since the matching begin call, by fly zone identifier
+@property (nonatomic, strong) NSMutableDictionary *mutableLockedOverlays;
+@property (nonatomic, strong) NSMutableDictionary *mutableUnlockedOverlays;
+@property (nonatomic, strong) NSMutableDictionary *mutableCustomUnlockedOverlays;
 
-@property (nonatomic, strong) NSMutableDictionary *mutableAllLockedOverlays;
-
-@property (nonatomic, strong) NSMutableDictionary *mutableAddedUnlockedOverlays;
-@property (nonatomic, strong) NSMutableDictionary *mutableRemovedUnlockedOverlays;
-
-@property (nonatomic, strong) NSMutableDictionary *mutableAllUnlockedOverlays;
-
-@property (nonatomic, strong) NSMutableDictionary *mutableAddedCustomUnlockedOverlays;
-@property (nonatomic, strong) NSMutableDictionary *mutableRemovedCustomUnlockedOverlays;
-@property (nonatomic, strong) NSMutableDictionary *mutableAllCustomUnlockedOverlays;
+@property (nonatomic, strong) DUXBetaMapFlyZoneDiffer<id<MKOverlay>> *differ;
+@property (nonatomic, strong) DUXBetaMapFlyZoneDiff<id<MKOverlay>> *lastDiff;
 
 @end
 
@@ -58,17 +52,10 @@
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _mutableAddedLockedOverlays = [NSMutableDictionary dictionary];
-        _mutableRemovedLockedOverlays = [NSMutableDictionary dictionary];
-        _mutableAllLockedOverlays = [NSMutableDictionary dictionary];
-        
-        _mutableAddedUnlockedOverlays = [NSMutableDictionary dictionary];
-        _mutableRemovedUnlockedOverlays = [NSMutableDictionary dictionary];
-        _mutableAllUnlockedOverlays = [NSMutableDictionary dictionary];
-        
-        _mutableAddedCustomUnlockedOverlays = [NSMutableDictionary dictionary];
-        _mutableRemovedCustomUnlockedOverlays = [NSMutableDictionary dictionary];
-        _mutableAllCustomUnlockedOverlays = [NSMutableDictionary dictionary];
+        _mutableLockedOverlays = [NSMutableDictionary dictionary];
+        _mutableUnlockedOverlays = [NSMutableDictionary dictionary];
+        _mutableCustomUnlockedOverlays = [NSMutableDictionary dictionary];
+        _differ = [[DUXBetaMapFlyZoneDiffer alloc] init];
     }
     return self;
 }
@@ -76,145 +63,55 @@
 #pragma mark - Update Methods
 
 - (void)beginLockedFlyZoneUpdates {
-    self.mutableAddedLockedOverlays = [NSMutableDictionary dictionary];
+    self.mutableLockedOverlays = [NSMutableDictionary dictionary];
 }
 
 - (void)endLockedFlyZoneUpdates {
-    NSArray *allAddedLockedOverlaysKeys = self.mutableAddedLockedOverlays.allKeys;
-    for (NSString *flyZoneIdentifier in allAddedLockedOverlaysKeys) {
-        if (self.mutableAddedUnlockedOverlays[flyZoneIdentifier] != nil) {
-            [self.mutableAddedLockedOverlays removeObjectForKey:flyZoneIdentifier];
-        }
-    }
-
-    for (NSString *flyZoneIdentifier in self.mutableAllLockedOverlays.allKeys) {
-        if (self.mutableAddedLockedOverlays[flyZoneIdentifier] == nil) {
-            self.mutableRemovedLockedOverlays[flyZoneIdentifier] = self.mutableAllLockedOverlays[flyZoneIdentifier];
-        }
-    }
-    
-    for (NSString *flyZoneIdentifier in self.mutableRemovedLockedOverlays.allKeys) {
-        [self.mutableAllLockedOverlays removeObjectForKey:flyZoneIdentifier];
-    }
-    
-    [self recomputeAllLockedFlyZones];
+    // Filtering and unlocked zones replacing locked ones are resolved by desiredOverlays
 }
 
 - (void)beginUnlockedFlyZoneUpdates {
-    self.mutableAddedUnlockedOverlays = [NSMutableDictionary dictionary];
+    self.mutableUnlockedOverlays = [NSMutableDictionary dictionary];
 }
 
 - (void)endUnlockedFlyZoneUpdates {
-    for (NSString *flyZoneIdentifier in self.mutableAllUnlockedOverlays.allKeys) {
-        if (self.mutableAddedUnlockedOverlays[flyZoneIdentifier] == nil) {
-            self.mutableRemovedUnlockedOverlays[flyZoneIdentifier] = self.mutableAllUnlockedOverlays[flyZoneIdentifier];
-        } else {
-            if (self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier]) {
-                DJIFlyZoneInformation *flyZone = self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier];
-                if ([self filterWithCategory:flyZone.category]) {
-                    self.mutableRemovedUnlockedOverlays[flyZoneIdentifier] = self.mutableAllUnlockedOverlays[flyZoneIdentifier];
-                }
-            } else if (self.mapWidget.unlockedFlyZones[flyZoneIdentifier]) {
-                DJIFlyZoneInformation *flyZone = self.mapWidget.unlockedFlyZones[flyZoneIdentifier];
-                if ([self filterWithCategory:flyZone.category]) {
-                    self.mutableRemovedUnlockedOverlays[flyZoneIdentifier] = self.mutableAllUnlockedOverlays[flyZoneIdentifier];
-                }
-            }
-        }
-    }
-    
-    for (NSString *flyZoneIdentifier in self.mutableRemovedUnlockedOverlays) {
-        [self.mutableAllUnlockedOverlays removeObjectForKey:flyZoneIdentifier];
-    }
-    
-    [self recomputeAllUnlockedFlyZones];
 }
 
 - (void)beginCustomUnlockedFlyZoneUpdates {
-    self.mutableAddedCustomUnlockedOverlays = [NSMutableDictionary dictionary];
+    self.mutableCustomUnlockedOverlays = [NSMutableDictionary dictionary];
 }
 
 - (void)endCustomUnlockedFlyZoneUpdates {
-    NSArray *allCustomUnlockedOverlaysKeys = [self.mutableAllCustomUnlockedOverlays.allKeys copy];
-    
-    for (NSString *flyZoneIdentifier in allCustomUnlockedOverlaysKeys) {
-        if (![self.mutableAddedCustomUnlockedOverlays.allKeys containsObject:flyZoneIdentifier]) {
-            self.mutableRemovedCustomUnlockedOverlays[flyZoneIdentifier] = self.mutableAllCustomUnlockedOverlays[flyZoneIdentifier];
-        }
-    }
-    
-    [self recomputeAllCustomUnlockedFlyZones];
 }
 
-- (void)recomputeAllLockedFlyZones {
-    NSArray *allMutableAddedLockedOverlaysKeys = self.mutableAddedLockedOverlays.allKeys;
-    for (NSString *flyZoneIdentifier in allMutableAddedLockedOverlaysKeys) {
-        if (![self.mutableAllLockedOverlays.allKeys containsObject:flyZoneIdentifier]) {
-            self.mutableAllLockedOverlays[flyZoneIdentifier] = self.mutableAddedLockedOverlays[flyZoneIdentifier];
-        }
-    }
-    
-    NSArray *allMutableAllLockedOverlaysKeys = self.mutableAllLockedOverlays.allKeys;
-    for (NSString *flyZoneIdentifier in allMutableAllLockedOverlaysKeys) {
-        if (![self.mutableAddedLockedOverlays.allKeys containsObject:flyZoneIdentifier]) {
-            self.mutableRemovedLockedOverlays[flyZoneIdentifier] = self.mutableAllLockedOverlays[flyZoneIdentifier];
-        }
-    }
-}
-
-- (void)recomputeAllUnlockedFlyZones {
-    NSArray *allMutableAddedUnlockedOverlaysKeys = self.mutableAddedUnlockedOverlays.allKeys;
-    for (NSString *flyZoneIdentifier in allMutableAddedUnlockedOverlaysKeys) {
-        if (![self.mutableAllUnlockedOverlays.allKeys containsObject:flyZoneIdentifier]) {
-            self.mutableAllUnlockedOverlays[flyZoneIdentifier] = self.mutableAddedUnlockedOverlays[flyZoneIdentifier];
-        }
-    }
-    
-    NSArray *allMutableAllUnlockedOverlaysKeys = self.mutableAllUnlockedOverlays.allKeys;
-    for (NSString *flyZoneIdentifier in allMutableAllUnlockedOverlaysKeys) {
-        if (![self.mutableAddedUnlockedOverlays.allKeys containsObject:flyZoneIdentifier]) {
-            self.mutableRemovedUnlockedOverlays[flyZoneIdentifier] = self.mutableAllUnlockedOverlays[flyZoneIdentifier];
-        }
-    }
-}
-
-- (void)recomputeAllCustomUnlockedFlyZones {
-    self.mutableAllCustomUnlockedOverlays = [self.mutableAddedCustomUnlockedOverlays mutableCopy];
-    
-    if (self.mapWidget.showCustomUnlockZones) {
-        for (NSString *flyZoneIdentifier in self.mutableAddedCustomUnlockedOverlays) {
-            if (![self.mutableAllCustomUnlockedOverlays.allKeys containsObject:flyZoneIdentifier]) {
-                self.mutableAllCustomUnlockedOverlays[flyZoneIdentifier] = self.mutableAddedCustomUnlockedOverlays[flyZoneIdentifier];
-            }
-        }
-    } else {
-        [self.mutableRemovedCustomUnlockedOverlays addEntriesFromDictionary:self.mutableAllCustomUnlockedOverlays];
-    }
+- (DUXBetaMapFlyZoneDiff<id<MKOverlay>> *)commitChanges {
+    self.lastDiff = [self.differ applyObjects:self.desiredOverlays];
+    return self.lastDiff;
 }
 
 #pragma mark - Overlay Handling
 
 - (void)addLockedOverlayForFlyZone:(DJIFlyZoneInformation *)flyZone {
     DUXBetaMapFlyZoneCircleOverlay *noFlyZoneCircle = [self noFlyZoneCircleOverlayWithFlyZone:flyZone];
-    self.mutableAddedLockedOverlays[[NSString duxbeta_flyZoneProviderAccessKeyWithFlyZone:flyZone]] = noFlyZoneCircle;
+    self.mutableLockedOverlays[[NSString duxbeta_flyZoneProviderAccessKeyWithFlyZone:flyZone]] = noFlyZoneCircle;
 }
 
 - (void)addUnlockedOverlayForFlyZone:(DJIFlyZoneInformation *)flyZone {
     DUXBetaMapFlyZoneCircleOverlay *noFlyZoneCircle = [self noFlyZoneCircleOverlayWithFlyZone:flyZone];
-    self.mutableAddedUnlockedOverlays[[NSString duxbeta_flyZoneProviderAccessKeyWithFlyZone:flyZone]] = noFlyZoneCircle;
+    self.mutableUnlockedOverlays[[NSString duxbeta_flyZoneProviderAccessKeyWithFlyZone:flyZone]] = noFlyZoneCircle;
 }
 
 - (void)addOverlayForCylinderSubFlyZone:(DJISubFlyZoneInformation *)subFlyZone
                           withinFlyZone:(DJIFlyZoneInformation *)flyZone {
     DUXBetaMapFlyZoneCircleOverlay *subFlyZoneCircle = [self subFlyZoneCircleOverlayWithSubFlyZone:subFlyZone];
-    self.mutableAddedLockedOverlays[[NSString duxbeta_subFlyZoneProviderAccessKeyWithFlyZone:flyZone subFlyZone:subFlyZone]] = subFlyZoneCircle;
+    self.mutableLockedOverlays[[NSString duxbeta_subFlyZoneProviderAccessKeyWithFlyZone:flyZone subFlyZone:subFlyZone]] = subFlyZoneCircle;
 }
 
 - (void)addOverlayForPolygonSubFlyZone:(DJISubFlyZoneInformation *)subFlyZone
                          withinFlyZone:(DJIFlyZoneInformation *)flyZone {
     DUXBetaMapSubFlyZonePolygonOverlay *subFlyZonePolygonOverlay = [self subFlyZonePolygonOverlayWithSubFlyZonePolygon:subFlyZone
                                                                                                      withinFlyZone:flyZone];
-    self.mutableAddedLockedOverlays[[NSString duxbeta_subFlyZoneProviderAccessKeyWithFlyZone:flyZone subFlyZone:subFlyZone]] = subFlyZonePolygonOverlay;
+    self.mutableLockedOverlays[[NSString duxbeta_subFlyZoneProviderAccessKeyWithFlyZone:flyZone subFlyZone:subFlyZone]] = subFlyZonePolygonOverlay;
 }
 
 - (void)addOverlayForCustomUnlockZone:(DJICustomUnlockZone *)flyZone
@@ -223,7 +120,7 @@
     DUXBetaMapFlyZoneCircleOverlay *noFlyZoneOverlay = [self customUnlockFlyZoneCircleOverlayWithFlyZone:flyZone
                                                                                       sentToAircraft:sentToAircraft
                                                                                    enabledOnAircraft:enabledOnAircraft];
-    self.mutableAddedCustomUnlockedOverlays[[NSString duxbeta_customUnlockZoneProviderAccessKeyWithFlyZone:flyZone]] = noFlyZoneOverlay;
+    self.mutableCustomUnlockedOverlays[[NSString duxbeta_customUnlockZoneProviderAccessKeyWithFlyZone:flyZone]] = noFlyZoneOverlay;
 }
 
 #pragma mark - Generating Overlays
@@ -293,84 +190,51 @@
 
 #pragma mark - Public Properties
 
-- (NSArray <id <MKOverlay>> *)allOverlays {
-    // Combine locked and unlocked overlays together, unlocked overlays will replace locked ones
-    NSMutableArray *allOverlays = [NSMutableArray array];
+- (NSDictionary<NSString *, id<MKOverlay>> *)desiredOverlays {
+    NSMutableDictionary *desiredOverlays = [NSMutableDictionary dictionaryWithCapacity:self.mutableLockedOverlays.count + self.mutableUnlockedOverlays.count];
     
-    for (NSString *flyZoneIdentifier in self.mutableAllLockedOverlays.allKeys) {
-        if (self.mapWidget.flyZones[flyZoneIdentifier] != nil) {
-            DJIFlyZoneInformation *flyZone = (DJIFlyZoneInformation *)self.mapWidget.flyZones[flyZoneIdentifier];
-            if ([self filterWithCategory:flyZone.category]) {
-                if (self.mutableAllUnlockedOverlays[flyZoneIdentifier] == nil) {
-                    [allOverlays addObject:self.mutableAllLockedOverlays[flyZoneIdentifier]];
-                } else {
-                    [allOverlays addObject:self.mutableAllUnlockedOverlays[flyZoneIdentifier]];
-                }
-            } else {
-                // Do nothing, zone's filtered out
-            }
-        } else {
-            // Sub fly zones cannot be unlocked for now, just check for parent zone category
-            DJIFlyZoneInformation *parentFlyZone = self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier];
-            if ([self filterWithCategory:parentFlyZone.category]) {
-                [allOverlays addObject:self.mutableAllLockedOverlays[flyZoneIdentifier]];
-            }
+    [self.mutableLockedOverlays enumerateKeysAndObjectsUsingBlock:^(NSString *flyZoneIdentifier, id<MKOverlay> overlay, BOOL *stop) {
+        // Unlocked overlays replace locked ones
+        if (self.mutableUnlockedOverlays[flyZoneIdentifier] != nil) {
+            return;
         }
-    }
-    
-    return [NSArray arrayWithArray:allOverlays];
-}
-
-- (NSArray<id<MKOverlay>> *)addedOverlays {
-    NSMutableArray *addedOverlays = [NSMutableArray array];
-    
-    for (NSString *flyZoneIdentifier in self.mutableAddedLockedOverlays.allKeys) {
-        //If added fly zone not already in all overlays and not filtered out, then add it to added
-        if (self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier]) {
-            DJIFlyZoneInformation *flyZone = self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier];
-            if (![self filterWithCategory:flyZone.category]) {
-                [addedOverlays addObject:self.mutableAddedLockedOverlays[flyZoneIdentifier]];
-            }
-        } else if (self.mapWidget.flyZones[flyZoneIdentifier]) {
-            DJIFlyZoneInformation *flyZone = self.mapWidget.flyZones[flyZoneIdentifier];
-            if (![self filterWithCategory:flyZone.category]) {
-                [addedOverlays addObject:self.mutableAddedLockedOverlays[flyZoneIdentifier]];
-            }
+        DJIFlyZoneInformation *flyZone = self.mapWidget.subFlyZonesParentFlyZones[flyZoneIdentifier] ?: self.mapWidget.flyZones[flyZoneIdentifier];
+        if (flyZone != nil && ![self filterWithCategory:flyZone.category]) {
+            desiredOverlays[flyZoneIdentifier] = overlay;
         }
-    }
+    }];
     
-    for (NSString *flyZoneIdentifier in self.mutableAddedUnlockedOverlays.allKeys) {
+    [self.mutableUnlockedOverlays enumerateKeysAndObjectsUsingBlock:^(NSString *flyZoneIdentifier, id<MKOverlay> overlay, BOOL *stop) {
         DJIFlyZoneInformation *flyZone = self.mapWidget.unlockedFlyZones[flyZoneIdentifier];
         if (![self filterWithCategory:flyZone.category]) {
-            [addedOverlays addObject:self.mutableAddedUnlockedOverlays[flyZoneIdentifier]];
+            desiredOverlays[flyZoneIdentifier] = overlay;
         }
-    }
+    }];
 
     if (self.mapWidget.showCustomUnlockZones) {
-        for (NSString *flyZoneIdentifier in self.mutableAddedCustomUnlockedOverlays.allKeys) {
-            [addedOverlays addObject:self.mutableAddedCustomUnlockedOverlays[flyZoneIdentifier]];
-        }
+        // Custom unlock zone IDs are not fly zone IDs, keep them apart
+        [self.mutableCustomUnlockedOverlays enumerateKeysAndObjectsUsingBlock:^(NSString *flyZoneIdentifier, id<MKOverlay> overlay, BOOL *stop) {
+            desiredOverlays[[@"custom-" stringByAppendingString:flyZoneIdentifier]] = overlay;
+        }];
     }
 
-    return addedOverlays;
+    return desiredOverlays;
+}
+
+- (NSDictionary<NSString *, id<MKOverlay>> *)committedOverlays {
+    return self.differ.currentObjects;
+}
+
+- (NSArray<id<MKOverlay>> *)allOverlays {
+    return self.differ.currentObjects.allValues;
+}
+
+- (NSArray<id<MKOverlay>> *)addedOverlays {
+    return self.lastDiff.insertedObjects ?: @[];
 }
 
 - (NSArray<id<MKOverlay>> *)removedOverlays {
-    NSMutableArray *removedOverlays = [NSMutableArray array];
-    
-    for (NSString *flyZoneIdentifier in self.mutableRemovedLockedOverlays.allKeys) {
-        [removedOverlays addObject:self.mutableRemovedLockedOverlays[flyZoneIdentifier]];
-    }
-    
-    for (NSString *flyZoneIdentifier in self.mutableRemovedUnlockedOverlays.allKeys) {
-        [removedOverlays addObject:self.mutableRemovedUnlockedOverlays[flyZoneIdentifier]];
-    }
-    
-    for (NSString *flyZoneIdentifier in self.mutableRemovedCustomUnlockedOverlays.allKeys) {
-        [removedOverlays addObject:self.mutableRemovedCustomUnlockedOverlays[flyZoneIdentifier]];
-    }
-    
-    return removedOverlays;
+    return self.lastDiff.deletedObjects ?: @[];
 }
 
 @end
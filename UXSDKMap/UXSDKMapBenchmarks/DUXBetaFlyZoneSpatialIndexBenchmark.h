@@ -0,0 +1,56 @@
+//
+//  DUXBetaFlyZoneSpatialIndexBenchmark.h
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Builds DUXBetaFlyZoneSpatialIndex over randomized fly zone bounds spread over about two degrees, and
+ * queries it with randomized viewports of 1 to 50 km.
+ */
+@interface DUXBetaFlyZoneSpatialIndexBenchmark : NSObject
+
+/**
+ * Returns: zones, queries, buildNanoseconds, nanosecondsPerQuery, maximumNanosecondsPerQuery,
+ * bruteForceNanosecondsPerQuery, the time a scan of every zone takes for the same query, and resultsPerQuery.
+ */
++ (NSDictionary<NSString *, NSNumber *> *)runWithZones:(NSUInteger)zones queries:(NSUInteger)queries seed:(long)seed;
+
+/**
+ * 50,000 zones, 1,000 queries.
+ */
++ (NSDictionary<NSString *, NSNumber *> *)runFiftyThousandZones;
+
+/**
+ * Datasets of 0 to 10,000 zones with different seeds, 200 queries each.
+ */
++ (NSArray<NSDictionary<NSString *, NSNumber *> *> *)runRandomizedDatasets;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,115 @@
+//
+//  DUXBetaFlyZoneSpatialIndexBenchmark.m
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaFlyZoneSpatialIndexBenchmark.h"
+#import <UXSDKMap/DUXBetaFlyZoneSpatialIndex.h>
+
+@implementation DUXBetaFlyZoneSpatialIndexBenchmark
+
++ (NSDictionary<NSString *, NSNumber *> *)runFiftyThousandZones {
+    return [self runWithZones:50000 queries:1000 seed:2020];
+}
+
++ (NSArray<NSDictionary<NSString *, NSNumber *> *> *)runRandomizedDatasets {
+    NSMutableArray *results = [[NSMutableArray alloc] init];
+    long seed = 1;
+    for (NSNumber *zones in @[@0, @1, @15, @16, @17, @100, @1000, @10000]) {
+        [results addObject:[self runWithZones:zones.unsignedIntegerValue queries:200 seed:seed++]];
+    }
+    return results;
+}
+
++ (NSDictionary<NSString *, NSNumber *> *)runWithZones:(NSUInteger)zones queries:(NSUInteger)queries seed:(long)seed {
+    srand48(seed);
+    
+    NSMutableData *rectData = [NSMutableData dataWithLength:zones * sizeof(MKMapRect)];
+    MKMapRect *rects = rectData.mutableBytes;
+    NSMutableArray<NSNumber *> *objects = [NSMutableArray arrayWithCapacity:zones];
+    for (NSUInteger i = 0; i < zones; i++) {
+        CLLocationCoordinate2D center = CLLocationCoordinate2DMake(21.5 + 2 * drand48(), 113.0 + 2 * drand48());
+        MKMapPoint point = MKMapPointForCoordinate(center);
+        // Every seventh zone is a single point, like a polygon vertex on its own
+        double radius = i % 7 == 0 ? 0 : (50.0 + drand48() * 5000.0) * MKMapPointsPerMeterAtLatitude(center.latitude);
+        rects[i] = MKMapRectMake(point.x - radius, point.y - radius, 2 * radius, 2 * radius);
+        [objects addObject:@(i)];
+    }
+    
+    uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    DUXBetaFlyZoneSpatialIndex<NSNumber *> *index = [[DUXBetaFlyZoneSpatialIndex alloc] initWithObjects:objects
+                                                                                               mapRect:^MKMapRect(NSNumber *object) {
+        return rects[object.unsignedIntegerValue];
+    }];
+    uint64_t buildNanoseconds = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+    
+    uint64_t total = 0;
+    uint64_t maximum = 0;
+    uint64_t bruteForceTotal = 0;
+    NSUInteger results = 0;
+    
+    for (NSUInteger query = 0; query < queries; query++) {
+        @autoreleasepool {
+            CLLocationCoordinate2D center = CLLocationCoordinate2DMake(21.5 + 2 * drand48(), 113.0 + 2 * drand48());
+            MKMapPoint point = MKMapPointForCoordinate(center);
+            double pointsPerMeter = MKMapPointsPerMeterAtLatitude(center.latitude);
+            double width = (1000.0 + drand48() * 49000.0) * pointsPerMeter;
+            double height = (1000.0 + drand48() * 49000.0) * pointsPerMeter;
+            MKMapRect mapRect = MKMapRectMake(point.x - width / 2, point.y - height / 2, width, height);
+            
+            NSMutableIndexSet *found = [NSMutableIndexSet indexSet];
+            start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+            [index enumerateObjectsIntersectingMapRect:mapRect usingBlock:^(NSNumber *object) {
+                [found addIndex:object.unsignedIntegerValue];
+            }];
+            uint64_t elapsed = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+            total += elapsed;
+            maximum = MAX(maximum, elapsed);
+            
+            NSMutableIndexSet *expected = [NSMutableIndexSet indexSet];
+            start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+            for (NSUInteger i = 0; i < zones; i++) {
+                if (DUXBetaFlyZoneSpatialIndexRectsIntersect(rects[i], mapRect)) {
+                    [expected addIndex:i];
+                }
+            }
+            bruteForceTotal += clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+            
+            results += found.count;
+        }
+    }
+    
+    return @{
+        @"zones" : @(zones),
+        @"queries" : @(queries),
+        @"buildNanoseconds" : @(buildNanoseconds),
+        @"nanosecondsPerQuery" : @(queries > 0 ? total / queries : 0),
+        @"maximumNanosecondsPerQuery" : @(maximum),
+        @"bruteForceNanosecondsPerQuery" : @(queries > 0 ? bruteForceTotal / queries : 0),
+        @"resultsPerQuery" : @(queries > 0 ? (double)results / queries : 0)
+    };
+}
+
+@end
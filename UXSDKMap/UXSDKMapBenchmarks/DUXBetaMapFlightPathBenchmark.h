@@ -0,0 +1,58 @@
+//
+//  DUXBetaMapFlightPathBenchmark.h
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Feeds a synthetic flight into a DUXBetaMapFlightPath the way DUXBetaMapView does, one coordinate per spacing
+ * meters traveled, and measures the append cost and the memory held by the path.
+ */
+@interface DUXBetaMapFlightPathBenchmark : NSObject
+
+/**
+ * Returns: updates, retainedPoints, maximumErrorMeters, overlays, totalNanoseconds, nanosecondsPerUpdate,
+ * maximumNanosecondsPerUpdate and peakMemoryBytes.
+ */
++ (NSDictionary<NSString *, NSNumber *> *)runWithDuration:(NSTimeInterval)duration
+                                                    speed:(double)metersPerSecond
+                                                  spacing:(double)meters;
+
+/**
+ * A two hour flight at 15 m/s with the map view's 1.5 m spacing.
+ */
++ (NSDictionary<NSString *, NSNumber *> *)runTwoHourFlight;
+
+/**
+ * Points retained against flight length, for flights of 15, 30, 60 and 120 minutes at 15 m/s.
+ */
++ (NSArray<NSDictionary<NSString *, NSNumber *> *> *)runRetentionByFlightLength;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,88 @@
+//
+//  DUXBetaMapFlightPathBenchmark.m
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaMapFlightPathBenchmark.h"
+#import <UXSDKMap/DUXBetaMapFlightPath.h>
+
+static const double kDUXBetaMetersPerDegreeLatitude = 111320.0;
+
+@implementation DUXBetaMapFlightPathBenchmark
+
++ (NSDictionary<NSString *, NSNumber *> *)runTwoHourFlight {
+    return [self runWithDuration:2 * 60 * 60 speed:15.0 spacing:1.5];
+}
+
++ (NSArray<NSDictionary<NSString *, NSNumber *> *> *)runRetentionByFlightLength {
+    NSMutableArray *results = [[NSMutableArray alloc] init];
+    for (NSNumber *minutes in @[@15, @30, @60, @120]) {
+        NSMutableDictionary *result = [[self runWithDuration:minutes.doubleValue * 60 speed:15.0 spacing:1.5] mutableCopy];
+        result[@"minutes"] = minutes;
+        [results addObject:result];
+    }
+    return results;
+}
+
++ (NSDictionary<NSString *, NSNumber *> *)runWithDuration:(NSTimeInterval)duration
+                                                    speed:(double)metersPerSecond
+                                                  spacing:(double)meters {
+    NSUInteger updates = (NSUInteger)(duration * metersPerSecond / meters);
+    DUXBetaMapFlightPath *flightPath = [[DUXBetaMapFlightPath alloc] init];
+    CLLocationCoordinate2D coordinate = CLLocationCoordinate2DMake(22.5431, 113.9589);
+    double heading = 0;
+    uint64_t total = 0;
+    uint64_t maximum = 0;
+    NSUInteger peakMemory = 0;
+    
+    for (NSUInteger i = 0; i < updates; i++) {
+        // A slow turn, one full circle every 2000 updates.
+        heading += 2 * M_PI / 2000;
+        coordinate.latitude += meters * cos(heading) / kDUXBetaMetersPerDegreeLatitude;
+        coordinate.longitude += meters * sin(heading) / (kDUXBetaMetersPerDegreeLatitude * cos(coordinate.latitude * M_PI / 180));
+        
+        uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+        @autoreleasepool {
+            [flightPath appendCoordinate:coordinate];
+        }
+        uint64_t elapsed = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+        total += elapsed;
+        maximum = MAX(maximum, elapsed);
+        peakMemory = MAX(peakMemory, flightPath.memoryFootprint);
+    }
+    
+    return @{
+        @"updates" : @(updates),
+        @"retainedPoints" : @(flightPath.count),
+        @"maximumErrorMeters" : @(flightPath.maximumError),
+        @"overlays" : @(flightPath.overlays.count),
+        @"totalNanoseconds" : @(total),
+        @"nanosecondsPerUpdate" : @(updates > 0 ? total / updates : 0),
+        @"maximumNanosecondsPerUpdate" : @(maximum),
+        @"peakMemoryBytes" : @(peakMemory)
+    };
+}
+
+@end
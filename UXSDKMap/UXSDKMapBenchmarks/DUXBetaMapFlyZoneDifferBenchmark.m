@@ -0,0 +1,113 @@
+//
+//  DUXBetaMapFlyZoneDifferBenchmark.m
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaMapFlyZoneDifferBenchmark.h"
+#import <UXSDKMap/DUXBetaMapFlyZoneDiffer.h>
+#import <UXSDKMap/DUXBetaMapFlyZoneCircleOverlay.h>
+
+@implementation DUXBetaMapFlyZoneDifferBenchmark
+
++ (NSArray<NSDictionary<NSString *, NSNumber *> *> *)runScaling {
+    NSMutableArray *results = [[NSMutableArray alloc] init];
+    for (NSNumber *zones in @[@10, @100, @1000, @10000]) {
+        [results addObject:[self runWithZones:zones.unsignedIntegerValue refreshes:20]];
+    }
+    return results;
+}
+
++ (NSDictionary<NSString *, NSNumber *> *)runWithZones:(NSUInteger)zones refreshes:(NSUInteger)refreshes {
+    srand48(2020);
+    
+    // The state of every zone, rebuilt into overlays on each refresh
+    NSMutableDictionary<NSString *, NSNumber *> *radii = [NSMutableDictionary dictionaryWithCapacity:zones];
+    NSUInteger nextZone = 0;
+    while (nextZone < zones) {
+        radii[[self keyForZone:nextZone++]] = @([self randomRadius]);
+    }
+    
+    DUXBetaMapFlyZoneDiffer<DUXBetaMapFlyZoneCircleOverlay *> *differ = [[DUXBetaMapFlyZoneDiffer alloc] init];
+    [differ applyObjects:[self overlaysWithRadii:radii]];
+    
+    NSUInteger churn = MAX((NSUInteger)1, zones / 10);
+    uint64_t total = 0;
+    
+    for (NSUInteger refresh = 0; refresh < refreshes; refresh++) {
+        @autoreleasepool {
+            NSMutableArray<NSString *> *keys = [radii.allKeys mutableCopy];
+            
+            for (NSUInteger i = 0; i < churn && keys.count > 0; i++) {
+                NSUInteger index = (NSUInteger)(drand48() * keys.count) % keys.count;
+                [radii removeObjectForKey:keys[index]];
+                [keys removeObjectAtIndex:index];
+            }
+            for (NSUInteger i = 0; i < churn && keys.count > 0; i++) {
+                NSUInteger index = (NSUInteger)(drand48() * keys.count) % keys.count;
+                radii[keys[index]] = @(radii[keys[index]].doubleValue + 100.0);
+                [keys removeObjectAtIndex:index];
+            }
+            for (NSUInteger i = 0; i < churn; i++) {
+                radii[[self keyForZone:nextZone++]] = @([self randomRadius]);
+            }
+            
+            NSDictionary<NSString *, DUXBetaMapFlyZoneCircleOverlay *> *overlays = [self overlaysWithRadii:radii];
+            
+            uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+            [differ applyObjects:overlays];
+            total += clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+        }
+    }
+    
+    return @{
+        @"zones" : @(zones),
+        @"refreshes" : @(refreshes),
+        @"nanosecondsPerDiff" : @(refreshes > 0 ? total / refreshes : 0),
+        @"nanosecondsPerZone" : @(refreshes > 0 && zones > 0 ? total / (refreshes * zones) : 0),
+        @"retainedObjects" : @(differ.currentObjects.count)
+    };
+}
+
++ (NSDictionary<NSString *, DUXBetaMapFlyZoneCircleOverlay *> *)overlaysWithRadii:(NSDictionary<NSString *, NSNumber *> *)radii {
+    NSMutableDictionary *overlays = [NSMutableDictionary dictionaryWithCapacity:radii.count];
+    [radii enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSNumber *radius, BOOL *stop) {
+        DUXBetaMapFlyZoneCircleOverlay *overlay = [DUXBetaMapFlyZoneCircleOverlay circleWithCenterCoordinate:CLLocationCoordinate2DMake(22.5, 113.9)
+                                                                                                       radius:radius.doubleValue];
+        overlay.flyZoneType = DJIFlyZoneTypeCircle;
+        overlay.noFlyZoneID = @(key.integerValue);
+        overlays[key] = overlay;
+    }];
+    return overlays;
+}
+
++ (NSString *)keyForZone:(NSUInteger)zone {
+    return [NSString stringWithFormat:@"%lu", (unsigned long)zone];
+}
+
++ (double)randomRadius {
+    return 200.0 + floor(drand48() * 2000.0);
+}
+
+@end
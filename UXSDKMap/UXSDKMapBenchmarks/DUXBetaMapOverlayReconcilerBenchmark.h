@@ -0,0 +1,54 @@
+//
+//  DUXBetaMapOverlayReconcilerBenchmark.h
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Refreshes a set of synthetic fly zone overlays on an offscreen map view, replacing a fraction of them
+ * each refresh, once through DUXBetaMapOverlayReconciler and once the way the map widget used to, by
+ * removing every overlay and adding the whole set back. Main thread only.
+ */
+@interface DUXBetaMapOverlayReconcilerBenchmark : NSObject
+
+/**
+ * Returns: zones, refreshes, overlaysTouched, mainThreadNanoseconds, fullReloadOverlaysTouched and
+ * fullReloadMainThreadNanoseconds.
+ */
++ (NSDictionary<NSString *, NSNumber *> *)runWithZones:(NSUInteger)zones
+                                                 churn:(double)churn
+                                             refreshes:(NSUInteger)refreshes;
+
+/**
+ * 1,000 fly zones, 1% of them replaced on each of 100 refreshes.
+ */
++ (NSDictionary<NSString *, NSNumber *> *)runThousandZones;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,108 @@
+//
+//  DUXBetaMapOverlayReconcilerBenchmark.m
+//  UXSDKMap
+//
+//  MIT License
+//  
+//  Copyright © 2018-2020 DJI
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//  
+
+#import "DUXBetaMapOverlayReconcilerBenchmark.h"
+#import <UXSDKMap/DUXBetaMapOverlayReconciler.h>
+
+@implementation DUXBetaMapOverlayReconcilerBenchmark
+
++ (NSDictionary<NSString *, NSNumber *> *)runThousandZones {
+    return [self runWithZones:1000 churn:0.01 refreshes:100];
+}
+
++ (NSDictionary<NSString *, NSNumber *> *)runWithZones:(NSUInteger)zones
+                                                 churn:(double)churn
+                                             refreshes:(NSUInteger)refreshes {
+    NSAssert([NSThread isMainThread], @"The benchmark drives a map view and must run on the main thread");
+    
+    srand48(2020);
+    NSUInteger nextZone = 0;
+    NSMutableDictionary<NSString *, id<MKOverlay>> *desired = [NSMutableDictionary dictionaryWithCapacity:zones];
+    while (nextZone < zones) {
+        desired[[self keyForZone:nextZone]] = [self overlayForZone:nextZone];
+        nextZone++;
+    }
+    
+    MKMapView *mapView = [[MKMapView alloc] initWithFrame:CGRectMake(0, 0, 400, 400)];
+    DUXBetaMapOverlayReconciler *reconciler = [[DUXBetaMapOverlayReconciler alloc] initWithMapView:mapView];
+    [reconciler setDesiredOverlays:desired];
+    [reconciler applyPendingChanges];
+    
+    MKMapView *fullReloadMapView = [[MKMapView alloc] initWithFrame:CGRectMake(0, 0, 400, 400)];
+    [fullReloadMapView addOverlays:desired.allValues level:MKOverlayLevelAboveRoads];
+    
+    NSUInteger initialTouched = reconciler.overlaysTouched;
+    uint64_t initialNanoseconds = reconciler.mainThreadNanoseconds;
+    NSUInteger fullReloadTouched = 0;
+    uint64_t fullReloadNanoseconds = 0;
+    NSUInteger churnedZones = MAX((NSUInteger)1, (NSUInteger)llround(zones * churn));
+    
+    for (NSUInteger refresh = 0; refresh < refreshes; refresh++) {
+        @autoreleasepool {
+            // Replace a few zones with new ones.
+            NSMutableArray<NSString *> *keys = [desired.allKeys mutableCopy];
+            for (NSUInteger i = 0; i < churnedZones && keys.count > 0; i++) {
+                NSUInteger index = (NSUInteger)(drand48() * keys.count) % keys.count;
+                [desired removeObjectForKey:keys[index]];
+                [keys removeObjectAtIndex:index];
+                desired[[self keyForZone:nextZone]] = [self overlayForZone:nextZone];
+                nextZone++;
+            }
+            
+            [reconciler setDesiredOverlays:desired];
+            [reconciler applyPendingChanges];
+            
+            uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+            NSArray<id<MKOverlay>> *overlays = fullReloadMapView.overlays;
+            [fullReloadMapView removeOverlays:overlays];
+            [fullReloadMapView addOverlays:desired.allValues level:MKOverlayLevelAboveRoads];
+            fullReloadNanoseconds += clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+            fullReloadTouched += overlays.count + desired.count;
+        }
+    }
+    
+    return @{
+        @"zones" : @(zones),
+        @"refreshes" : @(refreshes),
+        @"overlaysTouched" : @(reconciler.overlaysTouched - initialTouched),
+        @"mainThreadNanoseconds" : @(reconciler.mainThreadNanoseconds - initialNanoseconds),
+        @"fullReloadOverlaysTouched" : @(fullReloadTouched),
+        @"fullReloadMainThreadNanoseconds" : @(fullReloadNanoseconds)
+    };
+}
+
++ (NSString *)keyForZone:(NSUInteger)zone {
+    return [NSString stringWithFormat:@"%lu", (unsigned long)zone];
+}
+
++ (id<MKOverlay>)overlayForZone:(NSUInteger)zone {
+    // Spread the zones over roughly a degree around Shenzhen.
+    CLLocationCoordinate2D center = CLLocationCoordinate2DMake(22.0 + drand48(), 113.5 + drand48());
+    return [MKCircle circleWithCenterCoordinate:center radius:200.0 + drand48() * 2000.0];
+}
+
+@end